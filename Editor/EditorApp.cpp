@@ -2,11 +2,13 @@
 #include "EditorUtil.h"
 #include "GUICheckbox.h"
 #include "GUITextBox.h"
+#include "RTEError.h"
 #include "winalleg.h"
 
 namespace RTEGUI {
 
 	int64_t EditorApp::s_FrameTime = 0;
+	int64_t EditorApp::s_RepaintedPixels = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -33,6 +35,13 @@ namespace RTEGUI {
 		// Initialize the UI
 		m_EditorManager = std::make_unique<EditorManager>(m_Screen.get(), m_Input.get(), "Assets", "EditorSkin.ini");
 
+		// Track the areas that change so only those get repainted each frame
+		m_EditorManager->GetControlManager()->GetManager()->SetUseValidation(true);
+		m_EditorManager->GetWorkspaceManager()->GetManager()->SetUseValidation(true);
+
+		// The workspace can get crowded with controls, so spread drawing it over all the hardware threads
+		m_EditorManager->GetWorkspaceManager()->GetManager()->SetDrawThreads(0);
+
 		// Only allow workspace zoom if the screen resolution is FHD or above, smaller resolutions can't fully display it
 		if (m_BackBuffer->w < 1920 && m_BackBuffer->h < 1080) {
 			m_EditorManager->DisableZoomCheckbox();
@@ -189,6 +198,8 @@ namespace RTEGUI {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool EditorApp::UpdateEditor() {
+		CheckPendingSave(false);
+
 		m_EditorManager->GetControlManager()->Update();
 		GUIEvent editorEvent;
 		while (m_EditorManager->GetControlManager()->GetEvent(&editorEvent)) {
@@ -229,6 +240,7 @@ namespace RTEGUI {
 					} else if (controlName == "ZoomCheckBox") {
 						m_ZoomWorkspace = (dynamic_cast<GUICheckbox *>(editorEvent.GetControl()))->GetCheck() == GUICheckbox::Checked;
 						show_mouse(m_ZoomWorkspace ? nullptr : screen);
+						m_RedrawAll = true;
 						m_EditorManager->RemoveFocus();
 					}
 					break;
@@ -239,35 +251,125 @@ namespace RTEGUI {
 		ProcessMouseInput();
 		ProcessKeyboardInput();
 
-		m_EditorManager->SetFrameTimeLabelText(s_FrameTime);
+		m_EditorManager->SetFrameTimeLabelText(s_FrameTime, s_RepaintedPixels);
+
+		// Don't let the editor close before the last save made it to disk
+		if (m_Quit) { CheckPendingSave(true); }
 
 		return !m_Quit;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void EditorApp::DrawEditor() {
+	bool EditorApp::DrawEditor() {
 		if (m_WindowResized) {
 			acknowledge_resize();
 			show_mouse(m_ZoomWorkspace ? nullptr : screen);
 			m_WindowResized = false;
+			m_RedrawAll = true;
 		}
-		clear_to_color(m_BackBuffer, 0);
+		GatherDirtyRects();
 
-		m_EditorManager->GetEditorBase()->Draw(m_Screen.get());
-		m_EditorManager->GetWorkspaceManager()->Draw();
-		m_EditorManager->GetCurrentSelection().DrawSelectionBox(m_Screen.get(), m_Input.get());
-		m_EditorManager->GetLeftColumn()->Draw(m_Screen.get());
-		m_EditorManager->GetRightColumn()->Draw(m_Screen.get());
-		m_EditorManager->GetToolBar()->Draw(m_Screen.get());
+		// The zoomed workspace is stretched over the rest of the editor from the whole backbuffer, so everything has to be redrawn
+		if (m_RedrawAll || m_ZoomWorkspace) {
+			m_DirtyRects.clear();
+			m_DirtyRects.push_back({ 0, 0, m_BackBuffer->w - 1, m_BackBuffer->h - 1 });
+		}
+		// Keep the last drawn frame's stats when there's nothing to draw, otherwise showing them would make the next frame dirty again
+		if (m_DirtyRects.empty()) {
+			return false;
+		}
+		vsync();
+		std::chrono::steady_clock::time_point frameTimeStart = std::chrono::steady_clock::now();
+		s_RepaintedPixels = 0;
+
+		for (GUIRect &dirtyRect : m_DirtyRects) {
+			dirtyRect.left = std::max(dirtyRect.left, 0L);
+			dirtyRect.top = std::max(dirtyRect.top, 0L);
+			dirtyRect.right = std::min(dirtyRect.right, static_cast<long>(m_BackBuffer->w - 1));
+			dirtyRect.bottom = std::min(dirtyRect.bottom, static_cast<long>(m_BackBuffer->h - 1));
+			if (dirtyRect.right < dirtyRect.left || dirtyRect.bottom < dirtyRect.top) {
+				continue;
+			}
+			DrawEditorArea(dirtyRect);
+
+			int width = dirtyRect.right - dirtyRect.left + 1;
+			int height = dirtyRect.bottom - dirtyRect.top + 1;
+			if (!m_ZoomWorkspace) { blit(m_BackBuffer, screen, dirtyRect.left, dirtyRect.top, dirtyRect.left, dirtyRect.top, width, height); }
+			s_RepaintedPixels += static_cast<int64_t>(width) * static_cast<int64_t>(height);
+		}
+		m_Screen->GetBitmap()->SetClipRect(nullptr);
 
 		if (m_ZoomWorkspace) {
 			m_EditorManager->GetControlManager()->DrawMouse();
 
 			stretch_blit(m_BackBuffer, m_ZoomBuffer, m_EditorManager->GetWorkspacePosX(), m_EditorManager->GetWorkspacePosY(), m_EditorManager->GetWorkspaceWidth(), m_EditorManager->GetWorkspaceHeight(), 0, 0, m_EditorManager->GetWorkspaceWidth() * 2, m_EditorManager->GetWorkspaceHeight() * 2);
 			blit(m_ZoomBuffer, m_BackBuffer, 0, 0, m_EditorManager->GetWorkspacePosX(), m_EditorManager->GetWorkspacePosY(), m_EditorManager->GetWorkspaceWidth() * 2, m_EditorManager->GetWorkspaceHeight() * 2);
+			blit(m_BackBuffer, screen, 0, 0, 0, 0, screen->w, screen->h);
+		}
+		m_RedrawAll = false;
+
+		// Waiting for vsync is left out, otherwise the frame time shown would change every frame and keep the label repainting
+		s_FrameTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - frameTimeStart).count();
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	int EditorApp::GetIdleTime() const {
+		double idleTime = c_MaxIdleTime;
+		for (const GUIManager *guiManager : { m_EditorManager->GetControlManager()->GetManager(), m_EditorManager->GetWorkspaceManager()->GetManager() }) {
+			double repaintDelay = guiManager->GetScheduledRepaintDelay();
+			if (repaintDelay >= 0) { idleTime = std::min(idleTime, repaintDelay); }
+		}
+		return static_cast<int>(idleTime);
+	}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void EditorApp::GatherDirtyRects() {
+		GUIManager *editorGUIManager = m_EditorManager->GetControlManager()->GetManager();
+		GUIManager *workspaceGUIManager = m_EditorManager->GetWorkspaceManager()->GetManager();
+
+		m_DirtyRects = editorGUIManager->GetDirtyRects();
+		m_DirtyRects.insert(m_DirtyRects.end(), workspaceGUIManager->GetDirtyRects().begin(), workspaceGUIManager->GetDirtyRects().end());
+
+		// Clear before drawing so any panels invalidated while drawing get repainted in the next frame
+		editorGUIManager->ClearDirtyRects();
+		workspaceGUIManager->ClearDirtyRects();
+
+		// The selection box isn't a panel so repaint both where it was and where it is now if it changed
+		GUIRect selectionBoxRect;
+		bool drawSelectionBox = m_EditorManager->GetCurrentSelection().GetSelectionBoxRect(m_Input.get(), selectionBoxRect);
+		bool selectionBoxChanged = drawSelectionBox != m_SelectionBoxDrawn;
+		if (!selectionBoxChanged && drawSelectionBox) {
+			selectionBoxChanged = selectionBoxRect.left != m_SelectionBoxRect.left || selectionBoxRect.top != m_SelectionBoxRect.top || selectionBoxRect.right != m_SelectionBoxRect.right || selectionBoxRect.bottom != m_SelectionBoxRect.bottom;
+		}
+		if (selectionBoxChanged) {
+			if (m_SelectionBoxDrawn) { m_DirtyRects.push_back(m_SelectionBoxRect); }
+			if (drawSelectionBox) { m_DirtyRects.push_back(selectionBoxRect); }
+		}
+		m_SelectionBoxRect = selectionBoxRect;
+		m_SelectionBoxDrawn = drawSelectionBox;
+
+		GUIUtil::MergeOverlappingRects(m_DirtyRects);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void EditorApp::DrawEditorArea(const GUIRect &drawArea) {
+		GUIRect clipRect = drawArea;
+		m_Screen->GetBitmap()->SetClipRect(&clipRect);
+		rectfill(m_BackBuffer, drawArea.left, drawArea.top, drawArea.right, drawArea.bottom, 0);
+
+		if (RectsOverlap(*m_EditorManager->GetEditorBase()->GetRect(), drawArea)) { m_EditorManager->GetEditorBase()->Draw(m_Screen.get()); }
+		m_EditorManager->GetWorkspaceManager()->Draw();
+		m_EditorManager->GetCurrentSelection().DrawSelectionBox(m_Screen.get(), m_Input.get());
+
+		for (GUICollectionBox *editorColumn : { m_EditorManager->GetLeftColumn(), m_EditorManager->GetRightColumn(), m_EditorManager->GetToolBar() }) {
+			if (RectsOverlap(*editorColumn->GetRect(), drawArea)) { editorColumn->Draw(m_Screen.get()); }
 		}
-		blit(m_BackBuffer, screen, 0, 0, 0, 0, screen->w, screen->h);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -300,10 +402,32 @@ namespace RTEGUI {
 				OnSaveButton();
 			}
 		}
-		std::string newFilename;
-		if (EditorUtil::DisplayLoadFileDialogBox(newFilename, win_get_window())) {
-			m_EditorManager->GetWorkspaceManager()->Load(newFilename, addControls);
-			m_ActiveFileName = newFilename;
+		std::vector<std::string> newFilenames;
+		bool filesSelected = false;
+		if (addControls) {
+			filesSelected = EditorUtil::DisplayLoadFilesDialogBox(newFilenames, win_get_window());
+		} else {
+			newFilenames.emplace_back();
+			filesSelected = EditorUtil::DisplayLoadFileDialogBox(newFilenames.front(), win_get_window());
+		}
+		if (filesSelected) {
+			std::vector<std::string> loadProblems;
+			m_EditorManager->GetWorkspaceManager()->LoadFiles(newFilenames, addControls, &loadProblems);
+			m_ActiveFileName = newFilenames.front();
+
+			if (!loadProblems.empty()) {
+				std::string problemMessage = "Some lines or controls could not be loaded:\n";
+				// Keep the message box a reasonable size when a lot of names collide
+				size_t problemsToShow = std::min<size_t>(loadProblems.size(), 20);
+				for (size_t problemIndex = 0; problemIndex < problemsToShow; ++problemIndex) {
+					problemMessage += "\n" + loadProblems.at(problemIndex);
+				}
+				if (loadProblems.size() > problemsToShow) { problemMessage += "\n...and " + std::to_string(loadProblems.size() - problemsToShow) + " more."; }
+				ShowMessageBox(problemMessage);
+			}
+			if (m_EditorManager->GetWorkspaceManager()->GetControlList()->empty()) {
+				return;
+			}
 
 			GUIControl *newRootControl = m_EditorManager->GetWorkspaceManager()->GetControlList()->front();
 			newRootControl->Move(m_EditorManager->GetWorkspacePosX(), m_EditorManager->GetWorkspacePosY());
@@ -328,17 +452,45 @@ namespace RTEGUI {
 			std::string newFilename;
 			if (EditorUtil::DisplaySaveFileDialogBox(newFilename, win_get_window())) { m_ActiveFileName = newFilename; }
 		}
+		if (m_ActiveFileName.empty()) {
+			return;
+		}
+		// Only one save is written at a time, so saves of the same file land in order
+		CheckPendingSave(true);
+
 		// Move the root object to top left corner before saving so it is displayed correctly in-game.
 		m_EditorManager->GetRootControl()->Move(0, 0);
 
-		m_EditorManager->GetWorkspaceManager()->Save(m_ActiveFileName);
+		std::vector<GUIProperties> layoutSnapshot;
+		m_EditorManager->GetWorkspaceManager()->GetSnapshot(&layoutSnapshot);
 
 		// Move the root object back to the workspace position in the editor
 		m_EditorManager->GetRootControl()->Move(m_EditorManager->GetWorkspacePosX(), m_EditorManager->GetWorkspacePosY());
 
+		// The snapshot is all the writer needs, so the file is written on another thread while the editor keeps running
+		m_PendingSaveFileName = m_ActiveFileName;
+		m_PendingSave = std::async(std::launch::async, [snapshot = std::move(layoutSnapshot), fileName = m_ActiveFileName]() {
+			return GUIControlManager::SaveSnapshot(snapshot, fileName);
+		});
+
 		m_UnsavedChanges = false;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void EditorApp::CheckPendingSave(bool waitForCompletion) {
+		if (!m_PendingSave.valid()) {
+			return;
+		}
+		if (!waitForCompletion && m_PendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return;
+		}
+		if (!m_PendingSave.get()) {
+			m_UnsavedChanges = true;
+			ShowMessageBox("Failed to save " + m_PendingSaveFileName + "!\nThe file on disk was left as it was before saving.");
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void EditorApp::OnQuitButton() {
@@ -22,7 +22,8 @@ namespace RTEGUI {
 
 	public:
 
-		static int64_t s_FrameTime; //!< Duration between frames in milliseconds.
+		static int64_t s_FrameTime; //!< Time it took to draw the last drawn frame in milliseconds.
+		static int64_t s_RepaintedPixels; //!< Number of pixels repainted in the last drawn frame.
 
 #pragma region Creation
 		/// <summary>
@@ -63,9 +64,17 @@ namespace RTEGUI {
 		bool UpdateEditor();
 
 		/// <summary>
-		/// Draws the editor to the screen.
+		/// Draws the editor to the screen. Only the areas that changed since the last frame are repainted unless everything needs redrawing.
 		/// </summary>
-		void DrawEditor();
+		/// <returns>Whether anything was repainted. Nothing is, and vsync isn't waited for, when nothing changed.</returns>
+		bool DrawEditor();
+
+		/// <summary>
+		/// Gets how long the editor can sleep after a frame where nothing was repainted, before it has to check for input or a scheduled repaint again.
+		/// </summary>
+		/// <returns>The idle time in milliseconds.</returns>
+		int GetIdleTime() const;
+
 #pragma endregion
 
 #pragma region File Panel Button Handling
@@ -101,6 +110,25 @@ namespace RTEGUI {
 
 	private:
 
+		static constexpr double c_MaxIdleTime = 10; //!< The longest the editor sleeps between input checks when nothing is changing, in milliseconds.
+
+		/// <summary>
+		/// Gathers the screen areas that need repainting this frame from the GUI managers and the selection box into m_DirtyRects.
+		/// </summary>
+		void GatherDirtyRects();
+
+		/// <summary>
+		/// Draws all the editor elements that overlap a screen area. Drawing is clipped to the area.
+		/// </summary>
+		/// <param name="drawArea">The screen area to draw.</param>
+		void DrawEditorArea(const GUIRect &drawArea);
+
+		/// <summary>
+		/// Checks whether the save running in the background has finished, and tells the user if it failed.
+		/// </summary>
+		/// <param name="waitForCompletion">Whether to block until the save is done instead of only checking on it.</param>
+		void CheckPendingSave(bool waitForCompletion);
+
 		std::unique_ptr<AllegroScreen> m_Screen = nullptr; //!< GUI backbuffer.
 		std::unique_ptr<AllegroInput> m_Input = nullptr; //!< Input wrapper for Allegro.
 		std::unique_ptr<EditorManager> m_EditorManager = nullptr; //!< The editor manager that handles all the editor GUI and workspace.
@@ -118,8 +146,15 @@ namespace RTEGUI {
 
 		std::string m_ActiveFileName = ""; //!< The file name the editor is currently editing. If working from a blank workspace, will be assigned once the file is saved.
 		bool m_UnsavedChanges = false; //!< Indicates there are unsaved changes made to the current file.
+		std::future<bool> m_PendingSave; //!< The result of the save being written in the background, if there is one.
+		std::string m_PendingSaveFileName = ""; //!< The file the background save is writing to.
 		bool m_ZoomWorkspace = false; //!< Indicates the workspace should be drawn zoomed in at the drawing stage.
 
+		bool m_RedrawAll = true; //!< Indicates the whole screen should be repainted in the next frame instead of just the dirty areas.
+		std::vector<GUIRect> m_DirtyRects; //!< The screen areas that need repainting in the current frame.
+		GUIRect m_SelectionBoxRect; //!< The screen area the selection box was drawn to in the last frame.
+		bool m_SelectionBoxDrawn = false; //!< Indicates the selection box was drawn in the last frame.
+
 		// Disallow the use of some implicit methods.
 		EditorApp(const EditorApp &reference) = delete;
 		EditorApp &operator=(const EditorApp &rhs) = delete;
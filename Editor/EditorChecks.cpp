@@ -0,0 +1,997 @@
+#include "EditorChecks.h"
+#include "GUI.h"
+#include "GUICheckbox.h"
+#include "GUICollectionBox.h"
+#include "GUILabel.h"
+#include "GUIListBox.h"
+#include "GUITextBox.h"
+#include "SoftwareScreen.h"
+#include "AllegroBitmap.h"
+#include "AllegroScreen.h"
+#include "Timer.h"
+
+using namespace RTE;
+
+namespace RTEGUI {
+
+	namespace {
+		/// <summary>
+		/// Hashes every pixel of a bitmap, so two frames can be compared without keeping both around.
+		/// </summary>
+		/// <param name="bitmap">The bitmap to hash.</param>
+		/// <returns>The FNV-1a hash of the bitmap's pixels, row by row.</returns>
+		uint64_t HashBitmap(const GUIBitmap *bitmap) {
+			uint64_t bitmapHash = 14695981039346656037ULL;
+			for (int posY = 0; posY < bitmap->GetHeight(); ++posY) {
+				for (int posX = 0; posX < bitmap->GetWidth(); ++posX) {
+					bitmapHash = (bitmapHash ^ bitmap->GetPixel(posX, posY)) * 1099511628211ULL;
+				}
+			}
+			return bitmapHash;
+		}
+
+		/// <summary>
+		/// Fills a layout with panels of common controls in a grid, each one crossing several drawing tiles.
+		/// </summary>
+		/// <param name="controlManager">The control manager to add the controls to.</param>
+		/// <param name="columns">How many panels across.</param>
+		/// <param name="rows">How many panels down.</param>
+		void AddSampleControls(GUIControlManager &controlManager, int columns, int rows) {
+			for (int panelIndex = 0; panelIndex < columns * rows; ++panelIndex) {
+				std::string panelName = "Panel" + std::to_string(panelIndex);
+				GUICollectionBox *panel = dynamic_cast<GUICollectionBox *>(controlManager.AddControl(panelName, "COLLECTIONBOX", nullptr, (panelIndex % columns) * 470 + 10, (panelIndex / columns) * 350 + 10, 460, 340));
+				panel->SetDrawType(GUICollectionBox::Panel);
+				for (int checkboxIndex = 0; checkboxIndex < 16; ++checkboxIndex) {
+					GUICheckbox *checkbox = dynamic_cast<GUICheckbox *>(controlManager.AddControl(panelName + "Checkbox" + std::to_string(checkboxIndex), "CHECKBOX", panel, 5 + (checkboxIndex % 2) * 220, 10 + (checkboxIndex / 2) * 22, 210, 20));
+					checkbox->SetText("Checkbox number " + std::to_string(checkboxIndex));
+					checkbox->SetCheck(checkboxIndex % 3 == 0);
+				}
+				dynamic_cast<GUILabel *>(controlManager.AddControl(panelName + "Label", "LABEL", panel, 10, 190, 440, 20))->SetText("A label that crosses the edge between two tiles, number " + std::to_string(panelIndex));
+				GUIListBox *listBox = dynamic_cast<GUIListBox *>(controlManager.AddControl(panelName + "ListBox", "LISTBOX", panel, 10, 215, 300, 115));
+				for (int itemIndex = 0; itemIndex < 30; ++itemIndex) {
+					listBox->AddItem("Item " + std::to_string(itemIndex));
+				}
+				listBox->SetSelectedIndex(panelIndex % 30);
+				dynamic_cast<GUITextBox *>(controlManager.AddControl(panelName + "TextBox", "TEXTBOX", panel, 320, 215, 130, 20))->SetText("Text " + std::to_string(panelIndex));
+			}
+		}
+
+		/// <summary>
+		/// Compares two bitmaps of the same size pixel by pixel and writes how many pixels differ, and where the first one is.
+		/// </summary>
+		/// <param name="caseName">What was drawn, to start the log line with.</param>
+		/// <param name="softwareBitmap">The bitmap drawn by SoftwareBitmap.</param>
+		/// <param name="allegroBitmap">The bitmap drawn by Allegro.</param>
+		/// <param name="log">The stream to write the result to.</param>
+		/// <returns>Whether every pixel is the same.</returns>
+		bool ComparePixels(const std::string &caseName, const GUIBitmap &softwareBitmap, const GUIBitmap &allegroBitmap, std::ostream &log) {
+			if (softwareBitmap.GetWidth() != allegroBitmap.GetWidth() || softwareBitmap.GetHeight() != allegroBitmap.GetHeight()) {
+				log << caseName << ": SoftwareBitmap is " << softwareBitmap.GetWidth() << "x" << softwareBitmap.GetHeight() << ", Allegro is " << allegroBitmap.GetWidth() << "x" << allegroBitmap.GetHeight() << "\n";
+				return false;
+			}
+			int differentPixels = 0;
+			for (int posY = 0; posY < softwareBitmap.GetHeight(); ++posY) {
+				for (int posX = 0; posX < softwareBitmap.GetWidth(); ++posX) {
+					unsigned long softwarePixel = softwareBitmap.GetPixel(posX, posY);
+					unsigned long allegroPixel = allegroBitmap.GetPixel(posX, posY);
+					if (softwarePixel != allegroPixel && differentPixels++ == 0) {
+						log << caseName << ": first difference at " << posX << ", " << posY << ", SoftwareBitmap " << std::hex << softwarePixel << ", Allegro " << allegroPixel << std::dec << "\n";
+					}
+				}
+			}
+			log << caseName << ": " << differentPixels << " of " << softwareBitmap.GetWidth() * softwareBitmap.GetHeight() << " pixels differ\n";
+			return differentPixels == 0;
+		}
+
+		/// <summary>
+		/// Runs something three times and times the fastest run, so one slow run doesn't decide a benchmark's result.
+		/// </summary>
+		/// <param name="run">What to time. Has to leave things the way it found them, so every run does the same work.</param>
+		/// <returns>The time of the fastest run in milliseconds.</returns>
+		double TimeFastestRun(const std::function<void()> &run) {
+			double fastestTime = std::numeric_limits<double>::max();
+			for (int runIndex = 0; runIndex < 3; ++runIndex) {
+				Timer runTimer;
+				run();
+				fastestTime = std::min(fastestTime, runTimer.GetElapsedRealTimeMS());
+			}
+			return fastestTime;
+		}
+
+		/// <summary>
+		/// Reads the next line the way GUIReader::ReadLine did before it buffered its files, peeking and getting one character at a time from the stream.
+		/// Skips empty space and comments first like GUIReader::DiscardEmptySpace did, but leaves out the include files and indentation tracking the layouts don't use.
+		/// </summary>
+		/// <param name="stream">The stream to read from.</param>
+		/// <returns>The line with the spaces at both ends trimmed, or an empty string at the end of the stream.</returns>
+		std::string ReadLineUnbuffered(std::istream &stream) {
+			while (!stream.eof()) {
+				char peek = static_cast<char>(stream.peek());
+				if (stream.eof()) {
+					return std::string();
+				}
+				if (peek == ' ' || peek == '\t' || peek == '\n' || peek == '\r') {
+					stream.ignore(1);
+				} else if (peek == '/') {
+					char temp = static_cast<char>(stream.get());
+					if (stream.peek() == '/') {
+						while (stream.peek() != '\n' && stream.peek() != '\r' && !stream.eof()) { stream.ignore(1); }
+					} else if (stream.peek() == '*') {
+						while (!(static_cast<char>(stream.get()) == '*' && stream.peek() == '/') && !stream.eof()) {}
+						if (!stream.eof()) { stream.ignore(1); }
+					} else {
+						stream.putback(temp);
+						break;
+					}
+				} else {
+					break;
+				}
+			}
+
+			std::string line;
+			char peek = static_cast<char>(stream.peek());
+			while (peek != '\n' && peek != '\r' && peek != '\t') {
+				char temp = static_cast<char>(stream.get());
+				if (peek == '/' && stream.peek() == '/') {
+					stream.unget();
+					break;
+				}
+				if (stream.eof()) { break; }
+				line.append(1, temp);
+				peek = static_cast<char>(stream.peek());
+			}
+			size_t lineStart = line.find_first_not_of(' ');
+			return (lineStart == std::string::npos) ? std::string() : line.substr(lineStart, line.find_last_not_of(' ') - lineStart + 1);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::Run(const std::vector<std::string> &arguments, const std::string &logFilePath) {
+		static const std::vector<std::pair<std::string, bool (*)(const std::vector<std::string> &, std::ostream &)>> checkList = {
+			{ "drawtiles", &EditorChecks::CheckTiledDrawing },
+			{ "softwarebitmap", &EditorChecks::CheckSoftwareBitmap },
+			{ "imagecache", &EditorChecks::CheckImageCache },
+			{ "skincycle", &EditorChecks::CheckSkinCycle },
+			{ "properties", &EditorChecks::CheckProperties },
+			{ "controlindex", &EditorChecks::CheckControlIndex },
+			{ "events", &EditorChecks::CheckEventQueue },
+			{ "parse", &EditorChecks::CheckLayoutParsing },
+			{ "save", &EditorChecks::CheckLayoutSaving },
+			{ "includes", &EditorChecks::CheckIncludeTree },
+			{ "blit", &EditorChecks::CheckTransparentBlit },
+			{ "cull", &EditorChecks::CheckCulledDrawing }
+		};
+
+		std::ofstream log(logFilePath, std::ios::trunc);
+		const std::string checkName = arguments.empty() ? "" : arguments.front();
+		const std::vector<std::string> checkArguments(arguments.begin() + (arguments.empty() ? 0 : 1), arguments.end());
+
+		bool anyCheckRan = false;
+		bool allChecksPassed = true;
+		for (const auto &[name, checkFunction] : checkList) {
+			if (checkName != "all" && checkName != name) {
+				continue;
+			}
+			log << "== " << name << " ==\n";
+			bool checkPassed = checkFunction(checkName == "all" ? std::vector<std::string>() : checkArguments, log);
+			log << (checkPassed ? "PASSED" : "FAILED") << "\n\n";
+			log.flush();
+			anyCheckRan = true;
+			allChecksPassed = allChecksPassed && checkPassed;
+		}
+		if (!anyCheckRan) {
+			log << "There is no check named \"" << checkName << "\". The checks are:";
+			for (const auto &[name, checkFunction] : checkList) {
+				log << " " << name;
+			}
+			log << " and all.\n";
+		}
+		return anyCheckRan && allChecksPassed;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckTiledDrawing(const std::vector<std::string> &arguments, std::ostream &log) {
+		SoftwareScreen drawScreen(1920, 1080);
+		GUIInput drawInput(-1);
+		GUIControlManager drawControlManager;
+		if (!drawControlManager.Create(&drawScreen, &drawInput, "Assets", "EditorSkin.ini")) {
+			log << "Couldn't load the editor skin.\n";
+			return false;
+		}
+		if (arguments.empty()) {
+			AddSampleControls(drawControlManager, 4, 3);
+		} else if (!drawControlManager.Load(arguments.at(0))) {
+			log << "Couldn't load " << arguments.at(0) << ".\n";
+			return false;
+		}
+		GUIBitmap *drawBitmap = drawScreen.GetBitmap();
+		GUIRect screenRect;
+		SetRect(&screenRect, 0, 0, drawBitmap->GetWidth() - 1, drawBitmap->GetHeight() - 1);
+
+		// Draws the layout over a cleared screen a number of times, then hashes what the last frame left on it
+		auto drawFrames = [&drawControlManager, drawBitmap, &screenRect](int threads, double &frameTime) {
+			const int frameCount = 50;
+			drawControlManager.GetManager()->SetDrawThreads(threads);
+			Timer drawTimer;
+			for (int frame = 0; frame < frameCount; ++frame) {
+				drawBitmap->SetClipRect(&screenRect);
+				drawBitmap->DrawRectangle(0, 0, drawBitmap->GetWidth(), drawBitmap->GetHeight(), 0, true);
+				drawControlManager.Draw();
+			}
+			frameTime = drawTimer.GetElapsedRealTimeMS() / static_cast<double>(frameCount);
+			return HashBitmap(drawBitmap);
+		};
+
+		// Tiles are only drawn with 2 threads or more, so check with at least that many even on a single core
+		int maxThreads = std::max(arguments.size() > 1 ? std::atoi(arguments.at(1).c_str()) : static_cast<int>(std::thread::hardware_concurrency()), 2);
+		double serialFrameTime = 0;
+		uint64_t serialHash = drawFrames(1, serialFrameTime);
+		log << "1 thread: frame hash " << std::hex << serialHash << std::dec << ", " << serialFrameTime << " ms per frame\n";
+
+		bool framesMatch = true;
+		for (int threads = 2; threads <= maxThreads; threads = (threads == maxThreads) ? threads + 1 : std::min(threads * 2, maxThreads)) {
+			double tiledFrameTime = 0;
+			uint64_t tiledHash = drawFrames(threads, tiledFrameTime);
+			log << threads << " threads: frame hash " << std::hex << tiledHash << std::dec << ", " << tiledFrameTime << " ms per frame, " << serialFrameTime / tiledFrameTime << "x the speed of 1 thread" << (tiledHash == serialHash ? "\n" : ", DOESN'T MATCH\n");
+			framesMatch = framesMatch && tiledHash == serialHash;
+		}
+		return framesMatch;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckSoftwareBitmap(const std::vector<std::string> &arguments, std::ostream &log) {
+		const std::string imageFile = arguments.empty() ? "Assets/SkinBlue.png" : arguments.at(0);
+		if (!std::filesystem::exists(imageFile)) {
+			log << "Couldn't find " << imageFile << ".\n";
+			return false;
+		}
+		SoftwareBitmap softwareImage;
+		if (!softwareImage.Create(imageFile)) {
+			log << "SoftwareBitmap couldn't load " << imageFile << ".\n";
+			return false;
+		}
+		AllegroBitmap allegroImage;
+		allegroImage.Create(imageFile);
+		bool allPixelsMatch = ComparePixels("loading " + imageFile, softwareImage, allegroImage, log);
+
+		const int destWidth = 320;
+		const int destHeight = 240;
+		const int imageWidth = softwareImage.GetWidth();
+		const int imageHeight = softwareImage.GetHeight();
+		// Source rects and destination positions that land inside, across every edge and fully outside the destination
+		const std::vector<GUIRect> srcRects = { { 0, 0, imageWidth, imageHeight }, { imageWidth / 8, imageHeight / 4, imageWidth * 3 / 4, imageHeight * 5 / 8 }, { imageWidth / 2, 0, imageWidth / 2 + 1, imageHeight } };
+		const std::vector<std::pair<int, int>> destPositions = { { 10, 10 }, { -25, -17 }, { destWidth - 40, destHeight - 30 }, { -5, destHeight / 2 }, { destWidth + 5, 0 } };
+		const std::vector<std::pair<int, int>> scaledSizes = { { imageWidth, imageHeight }, { imageWidth * 2 + 3, imageHeight * 3 / 2 }, { imageWidth / 3, imageHeight / 2 + 1 }, { 1, 7 } };
+
+		const std::vector<std::pair<std::string, std::function<void(GUIBitmap &, GUIBitmap &)>>> drawCases = {
+			{ "opaque blit", [&srcRects, &destPositions](GUIBitmap &image, GUIBitmap &dest) {
+				for (GUIRect srcRect : srcRects) {
+					for (const auto &[destX, destY] : destPositions) { image.Draw(&dest, destX, destY, &srcRect); }
+				}
+			} },
+			{ "color-keyed blit", [&srcRects, &destPositions](GUIBitmap &image, GUIBitmap &dest) {
+				for (GUIRect srcRect : srcRects) {
+					for (const auto &[destX, destY] : destPositions) { image.DrawTrans(&dest, destX, destY, &srcRect); }
+				}
+			} },
+			{ "filled rectangle", [&destPositions](GUIBitmap &, GUIBitmap &dest) {
+				unsigned long color = 0x204060;
+				for (const auto &[posX, posY] : destPositions) {
+					dest.DrawRectangle(posX, posY, 70, 45, color, true);
+					dest.DrawRectangle(posX + 3, posY + 3, 1, 30, color ^ 0xFFFFFF, true);
+					color += 0x1F2F3F;
+				}
+			} },
+			{ "scaled blit", [&scaledSizes, &destPositions](GUIBitmap &image, GUIBitmap &dest) {
+				for (const auto &[width, height] : scaledSizes) {
+					for (const auto &[destX, destY] : destPositions) { image.DrawTransScaled(&dest, destX, destY, width, height); }
+				}
+			} }
+		};
+
+		SoftwareBitmap softwareDest;
+		softwareDest.Create(destWidth, destHeight);
+		AllegroBitmap allegroDest;
+		allegroDest.Create(destWidth, destHeight, 32);
+		// Every case is drawn once over the whole destination and once with a clipping rect that cuts into the drawn areas
+		GUIRect clipRect = { 30, 20, destWidth - 50, destHeight - 35 };
+		for (const auto &[caseName, drawCase] : drawCases) {
+			for (bool clipped : { false, true }) {
+				for (GUIBitmap *dest : std::initializer_list<GUIBitmap *>{ &softwareDest, &allegroDest }) {
+					dest->SetClipRect(nullptr);
+					for (int posY = 0; posY < destHeight; ++posY) {
+						for (int posX = 0; posX < destWidth; ++posX) { dest->SetPixel(posX, posY, static_cast<unsigned long>((posX * 0x010203 + posY * 0x030201) & 0xFFFFFF)); }
+					}
+					dest->SetClipRect(clipped ? &clipRect : nullptr);
+				}
+				drawCase(softwareImage, softwareDest);
+				drawCase(allegroImage, allegroDest);
+				allPixelsMatch = ComparePixels(caseName + (clipped ? ", clipped" : ""), softwareDest, allegroDest, log) && allPixelsMatch;
+			}
+		}
+		return allPixelsMatch;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckImageCache(const std::vector<std::string> &arguments, std::ostream &log) {
+		std::vector<std::string> imageFiles = arguments;
+		if (imageFiles.empty()) {
+			for (const std::filesystem::directory_entry &assetEntry : std::filesystem::recursive_directory_iterator("Assets")) {
+				if (assetEntry.path().extension() == ".png") { imageFiles.emplace_back(assetEntry.path().generic_string()); }
+			}
+		}
+		const std::string editorCacheDirectory = ContentFile::GetImageCacheDirectory();
+		const std::string checkCacheDirectory = (std::filesystem::temp_directory_path() / "GUIEditorCheckImageCache").generic_string();
+		std::error_code fileError;
+		std::filesystem::remove_all(checkCacheDirectory, fileError);
+
+		// Loads every image the way the editor does on startup, with nothing loaded yet, then hashes them so the cached pixels can be compared with the decoded ones
+		auto loadImages = [&imageFiles](const std::string &cacheDirectory, std::vector<uint64_t> &imageHashes) {
+			ContentFile::FreeAllLoaded();
+			ContentFile::SetImageCacheDirectory(cacheDirectory);
+			std::vector<std::shared_ptr<BITMAP>> loadedImages;
+			Timer loadTimer;
+			for (const std::string &imageFile : imageFiles) {
+				loadedImages.emplace_back(ContentFile(imageFile.c_str()).GetAsBitmap());
+			}
+			double loadTime = loadTimer.GetElapsedRealTimeMS();
+			imageHashes.clear();
+			for (const std::shared_ptr<BITMAP> &loadedImage : loadedImages) {
+				AllegroBitmap loadedBitmap(loadedImage.get());
+				imageHashes.emplace_back(HashBitmap(&loadedBitmap));
+			}
+			return loadTime;
+		};
+
+		std::vector<uint64_t> decodedHashes;
+		std::vector<uint64_t> coldHashes;
+		std::vector<uint64_t> warmHashes;
+		double decodeTime = loadImages("", decodedHashes);
+		double coldTime = loadImages(checkCacheDirectory, coldHashes);
+		double warmTime = loadImages(checkCacheDirectory, warmHashes);
+		ContentFile::FreeAllLoaded();
+		ContentFile::SetImageCacheDirectory(editorCacheDirectory);
+
+		size_t cacheEntryCount = 0;
+		for (const std::filesystem::directory_entry &cacheEntry : std::filesystem::directory_iterator(checkCacheDirectory, fileError)) {
+			if (cacheEntry.path().extension() == ".imc") { ++cacheEntryCount; }
+		}
+		std::filesystem::remove_all(checkCacheDirectory, fileError);
+
+		log << imageFiles.size() << " images, " << cacheEntryCount << " cache entries written\n";
+		log << "Without the cache: " << decodeTime << " ms\n";
+		log << "Empty cache, decoding and writing entries: " << coldTime << " ms\n";
+		log << "Filled cache: " << warmTime << " ms, " << decodeTime / warmTime << "x the speed of decoding\n";
+		bool imagesMatch = coldHashes == decodedHashes && warmHashes == decodedHashes;
+		if (!imagesMatch) { log << "Images loaded from the cache DON'T MATCH the decoded ones\n"; }
+		return imagesMatch && cacheEntryCount == imageFiles.size();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckSkinCycle(const std::vector<std::string> &arguments, std::ostream &log) {
+		const int cycleCount = arguments.empty() ? 1000 : std::max(1, std::stoi(arguments.front()));
+		const std::array<std::string, 4> skinFiles = { "SkinBlue.ini", "SkinBrown.ini", "SkinGray.ini", "SkinGreen.ini" };
+
+		ContentFile::FreeAllLoaded();
+		const size_t editorBudget = ContentFile::GetLoadedBitmapBudget();
+		const ContentFile::LoadedBitmapStats &loadedStats = ContentFile::GetLoadedBitmapStats();
+
+		AllegroScreen cycleScreen(640, 480, 32);
+		GUIInput cycleInput(-1);
+		GUIControlManager cycleControlManager;
+		if (!cycleControlManager.Create(&cycleScreen, &cycleInput, "Assets/Workspace", skinFiles.front())) {
+			log << "Couldn't load the blue workspace skin.\n";
+			return false;
+		}
+		AddSampleControls(cycleControlManager, 1, 1);
+
+		// Room for about two skins, so switching through all four has to free the ones no control holds on to anymore
+		const size_t skinBytes = loadedStats.ResidentBytes;
+		ContentFile::SetLoadedBitmapBudget(skinBytes * 2);
+		const size_t evictionsBefore = loadedStats.Evictions;
+
+		size_t firstCyclePeak = 0;
+		size_t laterCyclePeak = 0;
+		size_t lastCycleResident = 0;
+		Timer cycleTimer;
+		for (int cycle = 0; cycle < cycleCount; ++cycle) {
+			for (const std::string &skinFile : skinFiles) {
+				cycleControlManager.ChangeSkin("Assets/Workspace", skinFile);
+				size_t &cyclePeak = (cycle == 0) ? firstCyclePeak : laterCyclePeak;
+				cyclePeak = std::max(cyclePeak, loadedStats.ResidentBytes);
+			}
+			lastCycleResident = loadedStats.ResidentBytes;
+			if (cycle == 0) { log << "After the first cycle: " << loadedStats.ResidentBitmaps << " bitmaps, " << loadedStats.ResidentBytes << " bytes, peak " << firstCyclePeak << " bytes\n"; }
+		}
+		double cycleTime = cycleTimer.GetElapsedRealTimeMS();
+		const size_t cycleEvictions = loadedStats.Evictions - evictionsBefore;
+
+		log << "One skin: " << skinBytes << " bytes, budget " << skinBytes * 2 << " bytes\n";
+		log << "After " << cycleCount << " cycles of " << skinFiles.size() << " skins: " << loadedStats.ResidentBitmaps << " bitmaps, " << lastCycleResident << " bytes, peak after the first cycle " << laterCyclePeak << " bytes\n";
+		log << cycleEvictions << " bitmaps freed, " << cycleTime << " ms\n";
+
+		cycleControlManager.Destroy();
+		ContentFile::SetLoadedBitmapBudget(editorBudget);
+		ContentFile::FreeAllLoaded();
+
+		bool memoryBounded = laterCyclePeak <= firstCyclePeak;
+		if (!memoryBounded) { log << "Loaded bitmaps kept GROWING after the first cycle\n"; }
+		if (cycleEvictions == 0) { log << "No bitmap was ever freed, the skins are still holding on to the ones they replaced\n"; }
+		return memoryBounded && cycleEvictions > 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckProperties(const std::vector<std::string> &arguments, std::ostream &log) {
+		const int operationCount = arguments.empty() ? 10000000 : std::max(1, std::stoi(arguments.front()));
+		const int propertyCount = 40;
+
+		// About as many properties as the biggest controls have, with names that only differ near the end like theirs do
+		GUIProperties controlProperties("Control");
+		std::vector<std::string> propertyNames;
+		std::vector<int> expectedValues;
+		for (int propertyIndex = 0; propertyIndex < propertyCount; ++propertyIndex) {
+			propertyNames.emplace_back("ControlProperty" + std::to_string(propertyIndex));
+			expectedValues.emplace_back(propertyIndex);
+			controlProperties.AddVariable(propertyNames.back(), propertyIndex);
+		}
+
+		// One set for every three gets, in an order fixed by the seed so runs are comparable
+		uint32_t randomState = 12345;
+		int wrongValues = 0;
+		int setCount = 0;
+		Timer operationTimer;
+		for (int operation = 0; operation < operationCount; ++operation) {
+			randomState = randomState * 1664525U + 1013904223U;
+			int propertyIndex = static_cast<int>((randomState >> 8) % propertyCount);
+			if ((randomState >> 30) == 0) {
+				expectedValues[propertyIndex] = operation;
+				controlProperties.SetValue(propertyNames[propertyIndex], operation);
+				++setCount;
+			} else {
+				int propertyValue = -1;
+				if (!controlProperties.GetValue(propertyNames[propertyIndex], &propertyValue) || propertyValue != expectedValues[propertyIndex]) { ++wrongValues; }
+			}
+		}
+		double operationTime = operationTimer.GetElapsedRealTimeMS();
+
+		log << operationCount << " operations on " << propertyCount << " properties, " << setCount << " sets: " << operationTime << " ms, " << operationTime * 1000000.0 / static_cast<double>(operationCount) << " ns per operation\n";
+		if (wrongValues > 0) { log << wrongValues << " gets returned the WRONG value\n"; }
+		return wrongValues == 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckControlIndex(const std::vector<std::string> &arguments, std::ostream &log) {
+		// The sample panels have 20 controls each
+		const int panelCount = std::max(1, (arguments.empty() ? 5000 : std::atoi(arguments.at(0).c_str())) / 20);
+
+		SoftwareScreen indexScreen(1920, 1080);
+		GUIInput indexInput(-1);
+		GUIControlManager indexControlManager;
+		if (!indexControlManager.Create(&indexScreen, &indexInput, "Assets", "EditorSkin.ini")) {
+			log << "Couldn't load the editor skin.\n";
+			return false;
+		}
+		Timer indexTimer;
+		AddSampleControls(indexControlManager, 25, (panelCount + 24) / 25);
+		double addTime = indexTimer.GetElapsedRealTimeMS();
+
+		std::vector<std::string> controlNames;
+		for (GUIControl *control : *indexControlManager.GetControlList()) {
+			controlNames.emplace_back(control->GetName());
+		}
+		const std::string layoutFile = (std::filesystem::temp_directory_path() / "GUIEditorCheckControlIndex.ini").generic_string();
+		if (!indexControlManager.Save(layoutFile)) {
+			log << "Couldn't save the generated layout to " << layoutFile << ".\n";
+			return false;
+		}
+
+		indexTimer.Reset();
+		bool layoutLoaded = indexControlManager.Load(layoutFile);
+		double loadTime = indexTimer.GetElapsedRealTimeMS();
+		std::error_code fileError;
+		std::filesystem::remove(layoutFile, fileError);
+		if (!layoutLoaded) {
+			log << "Couldn't load the generated layout back.\n";
+			return false;
+		}
+
+		// Look every control up by name, and once more by a name that isn't there, which is what AddControl does before adding one
+		int missingControls = 0;
+		int wrongControls = 0;
+		indexTimer.Reset();
+		for (const std::string &controlName : controlNames) {
+			GUIControl *foundControl = indexControlManager.GetControl(controlName);
+			if (!foundControl || foundControl->GetName() != controlName) { ++missingControls; }
+			if (indexControlManager.GetControl(controlName + "Copy")) { ++wrongControls; }
+		}
+		double lookupTime = indexTimer.GetElapsedRealTimeMS();
+
+		const size_t loadedCount = indexControlManager.GetControlList()->size();
+		log << controlNames.size() << " controls: added in " << addTime << " ms, loaded in " << loadTime << " ms, " << loadedCount << " loaded\n";
+		log << controlNames.size() * 2 << " lookups by name: " << lookupTime << " ms\n";
+		if (missingControls > 0) { log << missingControls << " controls COULDN'T BE FOUND by name\n"; }
+		if (wrongControls > 0) { log << wrongControls << " names that were never added FOUND a control\n"; }
+		return missingControls == 0 && wrongControls == 0 && loadedCount == controlNames.size();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckEventQueue(const std::vector<std::string> &arguments, std::ostream &log) {
+		const int eventCount = std::max(1, arguments.empty() ? 1000000 : std::atoi(arguments.at(0).c_str()));
+
+		SoftwareScreen eventScreen(640, 480);
+		GUIInput eventInput(-1);
+		GUIControlManager eventControlManager;
+		if (!eventControlManager.Create(&eventScreen, &eventInput, "Assets", "EditorSkin.ini")) {
+			log << "Couldn't load the editor skin.\n";
+			return false;
+		}
+		GUIControl *eventControl = eventControlManager.AddControl("EventLabel", "LABEL", nullptr, 0, 0, 100, 20);
+
+		// Overfill the queue once to find how many events it holds, everything past that is dropped
+		const int probeCount = 100000;
+		for (int eventIndex = 0; eventIndex < probeCount; ++eventIndex) {
+			eventControl->AddEvent(GUIEvent::Notification, eventIndex, 0);
+		}
+		int queueCapacity = 0;
+		GUIEvent queuedEvent;
+		while (eventControlManager.GetEvent(&queuedEvent)) {
+			++queueCapacity;
+		}
+		if (queueCapacity == 0 || queueCapacity == probeCount) {
+			log << "The queue took " << queueCapacity << " of " << probeCount << " events at once, it should take some and drop the rest\n";
+			return false;
+		}
+
+		// Bursts of up to twice the capacity, each one drained before the next, so some overflow and the queue wraps around at every position
+		uint32_t randomState = 12345;
+		int orderErrors = 0;
+		int pushedEvents = 0;
+		unsigned long expectedDrops = eventControlManager.GetDroppedEventCount();
+		Timer eventTimer;
+		while (pushedEvents < eventCount) {
+			randomState = randomState * 1664525U + 1013904223U;
+			int burstSize = std::min(1 + static_cast<int>((randomState >> 8) % static_cast<uint32_t>(queueCapacity * 2)), eventCount - pushedEvents);
+			for (int eventIndex = 0; eventIndex < burstSize; ++eventIndex) {
+				eventControl->AddEvent(GUIEvent::Notification, pushedEvents + eventIndex, burstSize);
+			}
+			expectedDrops += static_cast<unsigned long>(std::max(0, burstSize - queueCapacity));
+
+			// Only the oldest events of a burst fit, and they have to come out in the order they went in
+			int expectedMsg = pushedEvents;
+			while (eventControlManager.GetEvent(&queuedEvent)) {
+				if (queuedEvent.GetMsg() != expectedMsg || queuedEvent.GetData() != burstSize || queuedEvent.GetControl() != eventControl) { ++orderErrors; }
+				++expectedMsg;
+			}
+			if (expectedMsg != pushedEvents + std::min(burstSize, queueCapacity)) { ++orderErrors; }
+			pushedEvents += burstSize;
+		}
+		double eventTime = eventTimer.GetElapsedRealTimeMS();
+		const unsigned long droppedEvents = eventControlManager.GetDroppedEventCount();
+
+		log << "Queue capacity: " << queueCapacity << " events\n";
+		log << pushedEvents << " events in bursts: " << eventTime << " ms, " << eventTime * 1000000.0 / static_cast<double>(pushedEvents) << " ns per event, " << droppedEvents << " dropped\n";
+		if (orderErrors > 0) { log << orderErrors << " events or bursts came out OUT OF ORDER or missing\n"; }
+		if (droppedEvents != expectedDrops) { log << "Expected " << expectedDrops << " dropped events, the queue COUNTED " << droppedEvents << "\n"; }
+		return orderErrors == 0 && droppedEvents == expectedDrops;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckLayoutParsing(const std::vector<std::string> &arguments, std::ostream &log) {
+		const size_t layoutSize = static_cast<size_t>(std::max(1, arguments.empty() ? 10 : std::atoi(arguments.at(0).c_str()))) * 1024 * 1024;
+		const std::string layoutFile = (std::filesystem::temp_directory_path() / "GUIEditorCheckParse.ini").generic_string();
+
+		// Sections like the editor saves them, with some indented lines and both kinds of comments mixed in
+		std::string layoutText;
+		int sectionCount = 0;
+		while (layoutText.size() < layoutSize) {
+			const std::string sectionNumber = std::to_string(sectionCount);
+			layoutText += "[Control" + sectionNumber + "]\n";
+			layoutText += "ControlType = " + std::string(sectionCount % 2 ? "LABEL" : "CHECKBOX") + "\n";
+			layoutText += "Parent = " + (sectionCount == 0 ? std::string("None") : "Control" + std::to_string(sectionCount / 20 * 20)) + "\n";
+			layoutText += "\tX = " + std::to_string(sectionCount % 640) + "\n\tY = " + std::to_string(sectionCount % 480) + "\n";
+			layoutText += "\tWidth = 120\n\tHeight = 20\n";
+			layoutText += "Anchor = Left, Top\nToolTip = None\n";
+			if (sectionCount % 10 == 0) { layoutText += "// Every tenth control has a comment line\n/* and a block comment\nover two lines */\n"; }
+			layoutText += "Text = Control number " + sectionNumber + " // with a comment after it\n";
+			layoutText += "HAlignment = left\nVAlignment = middle\nFont = FontSmall\n\n";
+			++sectionCount;
+		}
+		{
+			std::ofstream layoutStream(layoutFile, std::ios::binary | std::ios::trunc);
+			layoutStream.write(layoutText.data(), static_cast<std::streamsize>(layoutText.size()));
+		}
+		if (!std::filesystem::exists(layoutFile)) {
+			log << "Couldn't write the generated layout " << layoutFile << ".\n";
+			return false;
+		}
+
+		// Counts what each way of reading finds, so they can be compared without keeping every line around
+		struct LayoutCounts {
+			int Sections = 0;
+			int Properties = 0;
+			size_t PropertyChars = 0;
+			bool operator==(const LayoutCounts &other) const { return Sections == other.Sections && Properties == other.Properties && PropertyChars == other.PropertyChars; }
+		};
+
+		// Adds up the sections and properties of lines read through GUIReader, copying out each trimmed name and value like Load did
+		auto countReaderLine = [](const GUIReader &layoutReader, const std::string &layoutLine, LayoutCounts &counts) {
+			if (layoutLine.empty()) {
+				return;
+			}
+			if (layoutLine.front() == '[' && layoutLine.back() == ']') {
+				++counts.Sections;
+				return;
+			}
+			size_t equalsPos = layoutLine.find_first_of('=');
+			if (equalsPos != std::string::npos) {
+				std::string propertyName = layoutReader.TrimString(layoutLine.substr(0, equalsPos));
+				std::string propertyValue = layoutReader.TrimString(layoutLine.substr(equalsPos + 1, std::string::npos));
+				++counts.Properties;
+				counts.PropertyChars += propertyName.size() + propertyValue.size();
+			}
+		};
+
+		// What Load did before it had its own parser, read the file line by line through GUIReader::ReadLine from before it buffered its files
+		LayoutCounts unbufferedCounts;
+		double unbufferedTime = TimeFastestRun([&layoutFile, &countReaderLine, &unbufferedCounts]() {
+			unbufferedCounts = LayoutCounts();
+			GUIReader trimReader;
+			std::ifstream unbufferedStream(layoutFile, std::ios::binary);
+			while (unbufferedStream.is_open() && !unbufferedStream.eof()) {
+				countReaderLine(trimReader, ReadLineUnbuffered(unbufferedStream), unbufferedCounts);
+			}
+		});
+
+		// The same through today's buffered GUIReader
+		LayoutCounts readerCounts;
+		double readerTime = TimeFastestRun([&layoutFile, &countReaderLine, &readerCounts]() {
+			readerCounts = LayoutCounts();
+			GUIReader layoutReader;
+			if (layoutReader.Create(layoutFile) != 0) {
+				return;
+			}
+			while (!layoutReader.GetStream()->eof()) {
+				countReaderLine(layoutReader, layoutReader.ReadLine(), readerCounts);
+			}
+		});
+
+		// The same through ReadLayoutLine, including reading the whole file in since GUIReader's time includes its reading too
+		LayoutCounts lineCounts;
+		double lineTime = TimeFastestRun([&layoutFile, &lineCounts]() {
+			lineCounts = LayoutCounts();
+			std::error_code sizeError;
+			std::string layoutData(static_cast<size_t>(std::filesystem::file_size(layoutFile, sizeError)), '\0');
+			std::ifstream(layoutFile, std::ios::binary).read(layoutData.data(), static_cast<std::streamsize>(layoutData.size()));
+			size_t linePos = 0;
+			int lineNumber = 1;
+			GUIControlManager::LayoutLine layoutLine;
+			while (GUIControlManager::ReadLayoutLine(layoutData, linePos, lineNumber, layoutLine)) {
+				if (layoutLine.Type == GUIControlManager::LayoutLine::Section) {
+					++lineCounts.Sections;
+				} else if (layoutLine.Type == GUIControlManager::LayoutLine::Property) {
+					++lineCounts.Properties;
+					lineCounts.PropertyChars += layoutLine.Name.size() + layoutLine.Value.size();
+				}
+			}
+		});
+
+		// And all the way to the property sets Load creates the controls from
+		std::deque<GUIProperties> parsedSections;
+		bool layoutParsed = false;
+		double parseTime = TimeFastestRun([&layoutFile, &parsedSections, &layoutParsed]() {
+			parsedSections.clear();
+			layoutParsed = GUIControlManager::ParseLayout(layoutFile, parsedSections);
+		});
+		std::error_code fileError;
+		std::filesystem::remove(layoutFile, fileError);
+
+		LayoutCounts parsedCounts;
+		parsedCounts.Sections = static_cast<int>(parsedSections.size());
+		for (GUIProperties &parsedSection : parsedSections) {
+			for (int propertyIndex = 0; propertyIndex < parsedSection.GetCount(); ++propertyIndex) {
+				std::string propertyName;
+				std::string propertyValue;
+				parsedSection.GetVariable(propertyIndex, &propertyName, &propertyValue);
+				++parsedCounts.Properties;
+				parsedCounts.PropertyChars += propertyName.size() + propertyValue.size();
+			}
+		}
+		const double lineSpeedup = unbufferedTime / lineTime;
+
+		log << layoutText.size() / 1024 << " KB, " << readerCounts.Sections << " sections, " << readerCounts.Properties << " properties\n";
+		log << "GUIReader::ReadLine, unbuffered like it used to be: " << unbufferedTime << " ms\n";
+		log << "GUIReader::ReadLine, buffered: " << readerTime << " ms\n";
+		log << "ReadLayoutLine: " << lineTime << " ms, " << lineSpeedup << "x the speed of the unbuffered GUIReader, " << readerTime / lineTime << "x the buffered one\n";
+		log << "ParseLayout, with the property sets: " << parseTime << " ms\n";
+		bool countsMatch = layoutParsed && readerCounts.Sections == sectionCount && unbufferedCounts == readerCounts && lineCounts == readerCounts && parsedCounts == readerCounts;
+		if (!countsMatch) { log << "ReadLayoutLine or ParseLayout read the layout DIFFERENTLY than GUIReader\n"; }
+		if (lineSpeedup < 10) { log << "ReadLayoutLine should be at least 10x the speed of the unbuffered GUIReader\n"; }
+		return countsMatch && lineSpeedup >= 10;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckLayoutSaving(const std::vector<std::string> &arguments, std::ostream &log) {
+		// The sample panels have 20 controls each
+		const int panelCount = std::max(1, (arguments.empty() ? 20000 : std::atoi(arguments.at(0).c_str())) / 20);
+
+		SoftwareScreen saveScreen(1920, 1080);
+		GUIInput saveInput(-1);
+		GUIControlManager saveControlManager;
+		if (!saveControlManager.Create(&saveScreen, &saveInput, "Assets", "EditorSkin.ini")) {
+			log << "Couldn't load the editor skin.\n";
+			return false;
+		}
+		AddSampleControls(saveControlManager, 25, (panelCount + 24) / 25);
+
+		// Both ways of writing get the same snapshot, so only the writing is compared
+		std::vector<GUIProperties> controlSnapshot;
+		double snapshotTime = TimeFastestRun([&saveControlManager, &controlSnapshot]() { saveControlManager.GetSnapshot(&controlSnapshot); });
+
+		const std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+		const std::string unbufferedFile = (tempDirectory / "GUIEditorCheckSaveUnbuffered.ini").generic_string();
+		const std::string bufferedFile = (tempDirectory / "GUIEditorCheckSaveBuffered.ini").generic_string();
+		const std::string rawFile = (tempDirectory / "GUIEditorCheckSaveRaw.ini").generic_string();
+
+		// What Save did before GUIWriter buffered its output, build one string per control, stream it into the file and end it with a new line and a temporary string of tabs
+		double unbufferedTime = TimeFastestRun([&controlSnapshot, &unbufferedFile]() {
+			std::ofstream saveStream(unbufferedFile, std::ios::out | std::ios::trunc);
+			const int indentCount = 0;
+			for (const GUIProperties &controlProperties : controlSnapshot) {
+				std::string controlString = "";
+				controlString.append("[");
+				controlString.append(controlProperties.GetName());
+				controlString.append("]\n");
+				controlString.append(controlProperties.ToString());
+				saveStream << controlString;
+				saveStream << "\n";
+				saveStream << std::string(indentCount, '\t');
+			}
+		});
+
+		// The same snapshot through today's buffered GUIWriter
+		bool bufferedSaved = false;
+		double bufferedTime = TimeFastestRun([&controlSnapshot, &bufferedFile, &bufferedSaved]() {
+			GUIWriter saveWriter;
+			bufferedSaved = saveWriter.Create(bufferedFile) == 0 && GUIControlManager::SaveSnapshot(controlSnapshot, &saveWriter) && saveWriter.EndWrite();
+		});
+
+		auto readWholeFile = [](const std::string &fileName) {
+			std::error_code sizeError;
+			std::string fileData(static_cast<size_t>(std::filesystem::file_size(fileName, sizeError)), '\0');
+			std::ifstream(fileName, std::ios::binary).read(fileData.data(), static_cast<std::streamsize>(fileData.size()));
+			return fileData;
+		};
+		const std::string unbufferedData = readWholeFile(unbufferedFile);
+		const std::string bufferedData = readWholeFile(bufferedFile);
+
+		// The least writing the layout can take, the finished bytes in a single write, so Save can be compared against the file I/O alone
+		double rawTime = TimeFastestRun([&bufferedData, &rawFile]() {
+			std::ofstream rawStream(rawFile, std::ios::binary | std::ios::trunc);
+			rawStream.write(bufferedData.data(), static_cast<std::streamsize>(bufferedData.size()));
+		});
+
+		std::error_code fileError;
+		for (const std::string &fileName : { unbufferedFile, bufferedFile, rawFile }) {
+			std::filesystem::remove(fileName, fileError);
+		}
+
+		log << controlSnapshot.size() << " controls, " << bufferedData.size() / 1024 << " KB, snapshot taken in " << snapshotTime << " ms\n";
+		log << "One string per control into an ofstream: " << unbufferedTime << " ms\n";
+		log << "Buffered GUIWriter: " << bufferedTime << " ms, " << unbufferedTime / bufferedTime << "x the speed of one string per control\n";
+		log << "Writing the finished layout in one go: " << rawTime << " ms, the buffered GUIWriter takes " << bufferedTime / rawTime << "x as long\n";
+		bool filesMatch = bufferedSaved && !bufferedData.empty() && bufferedData == unbufferedData;
+		if (!filesMatch) { log << "The buffered GUIWriter wrote the layout DIFFERENTLY than one string per control\n"; }
+		if (bufferedTime >= unbufferedTime) { log << "The buffered GUIWriter should be faster than one string per control\n"; }
+		return filesMatch && bufferedTime < unbufferedTime;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckIncludeTree(const std::vector<std::string> &arguments, std::ostream &log) {
+		const int treeDepth = std::clamp(arguments.empty() ? 10 : std::atoi(arguments.at(0).c_str()), 1, 16);
+		const int fileCount = (1 << treeDepth) - 1;
+		const std::filesystem::path includeDirectory = std::filesystem::temp_directory_path() / "GUIEditorCheckIncludes";
+		std::error_code fileError;
+		std::filesystem::remove_all(includeDirectory, fileError);
+		std::filesystem::create_directories(includeDirectory, fileError);
+
+		// Every property read, with where the reader says it was, so the include tree can be compared against what was written
+		struct IncludeProperty {
+			std::string Name;
+			std::string Value;
+			std::string FilePath;
+			std::string FileLine;
+			bool operator==(const IncludeProperty &other) const { return Name == other.Name && Value == other.Value && FilePath == other.FilePath && FileLine == other.FileLine; }
+		};
+		auto includeFilePath = [&includeDirectory](int fileIndex) { return (includeDirectory / ("Include" + std::to_string(fileIndex) + ".ini")).generic_string(); };
+
+		// A binary tree of files, each with comments and properties before, between and after the two files it includes, so the reader has to pick every parent back up where it left off.
+		// The properties are also written to one flat file in the order they should be read, to compare against reading without any includes.
+		std::vector<IncludeProperty> expectedProperties;
+		std::string flatText;
+		std::function<void(int)> writeIncludeFile = [&](int fileIndex) {
+			std::string fileText = "// Include check file " + std::to_string(fileIndex) + "\n/* with a block comment\nover two lines */\n";
+			int fileLine = 4;
+			for (int part = 0; part < 3; ++part) {
+				for (int propertyIndex = part * 10; propertyIndex < part * 10 + 10; ++propertyIndex) {
+					const std::string propertyName = "Property" + std::to_string(propertyIndex);
+					const std::string propertyValue = "File " + std::to_string(fileIndex) + " property " + std::to_string(propertyIndex);
+					fileText += propertyName + " = " + propertyValue + "  \n";
+					flatText += propertyName + " = " + propertyValue + "  \n";
+					expectedProperties.push_back({ propertyName, propertyValue, includeFilePath(fileIndex), std::to_string(fileLine++) });
+				}
+				int childIndex = fileIndex * 2 + part;
+				if (part < 2 && childIndex <= fileCount) {
+					fileText += "IncludeFile = " + includeFilePath(childIndex) + "\n";
+					++fileLine;
+					writeIncludeFile(childIndex);
+				}
+			}
+			std::ofstream(includeFilePath(fileIndex), std::ios::trunc) << fileText;
+		};
+		writeIncludeFile(1);
+		const std::string flatFile = (includeDirectory / "Flat.ini").generic_string();
+		std::ofstream(flatFile, std::ios::trunc) << flatText;
+
+		auto readProperties = [](const std::string &fileName, std::vector<IncludeProperty> &readProperties) {
+			readProperties.clear();
+			GUIReader includeReader;
+			if (includeReader.Create(fileName) != 0) {
+				return;
+			}
+			while (includeReader.NextProperty()) {
+				IncludeProperty &readProperty = readProperties.emplace_back();
+				readProperty.Name = includeReader.ReadPropName();
+				readProperty.Value = includeReader.ReadPropValue();
+				readProperty.FilePath = includeReader.GetCurrentFilePath();
+				readProperty.FileLine = includeReader.GetCurrentFileLine();
+			}
+		};
+		std::vector<IncludeProperty> treeProperties;
+		double treeTime = TimeFastestRun([&readProperties, &includeFilePath, &treeProperties]() { readProperties(includeFilePath(1), treeProperties); });
+		std::vector<IncludeProperty> flatProperties;
+		double flatTime = TimeFastestRun([&readProperties, &flatFile, &flatProperties]() { readProperties(flatFile, flatProperties); });
+		std::filesystem::remove_all(includeDirectory, fileError);
+
+		int wrongProperties = 0;
+		for (size_t propertyIndex = 0; propertyIndex < std::min(treeProperties.size(), expectedProperties.size()); ++propertyIndex) {
+			const IncludeProperty &treeProperty = treeProperties.at(propertyIndex);
+			const IncludeProperty &expectedProperty = expectedProperties.at(propertyIndex);
+			if (!(treeProperty == expectedProperty) && wrongProperties++ == 0) {
+				log << "First difference at property " << propertyIndex << ": read " << treeProperty.Name << " = " << treeProperty.Value << " at " << treeProperty.FilePath << ":" << treeProperty.FileLine << ", wrote " << expectedProperty.Name << " = " << expectedProperty.Value << " at " << expectedProperty.FilePath << ":" << expectedProperty.FileLine << "\n";
+			}
+		}
+		int wrongFlatProperties = 0;
+		for (size_t propertyIndex = 0; propertyIndex < std::min(flatProperties.size(), expectedProperties.size()); ++propertyIndex) {
+			if (flatProperties.at(propertyIndex).Name != expectedProperties.at(propertyIndex).Name || flatProperties.at(propertyIndex).Value != expectedProperties.at(propertyIndex).Value) { ++wrongFlatProperties; }
+		}
+
+		log << treeDepth << " levels deep, " << fileCount << " files, " << expectedProperties.size() << " properties, " << flatText.size() / 1024 << " KB\n";
+		log << "Include tree: " << treeTime << " ms, " << treeProperties.size() << " properties read\n";
+		log << "Same properties in one file: " << flatTime << " ms, " << flatProperties.size() << " properties read\n";
+		log << "Each include file adds " << (treeTime - flatTime) * 1000 / fileCount << " us\n";
+		bool propertiesMatch = treeProperties.size() == expectedProperties.size() && flatProperties.size() == expectedProperties.size() && wrongProperties == 0 && wrongFlatProperties == 0;
+		if (!propertiesMatch) { log << wrongProperties << " properties of the include tree and " << wrongFlatProperties << " of the flat file were read DIFFERENTLY than written, or the counts differ\n"; }
+		return propertiesMatch;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckTransparentBlit(const std::vector<std::string> &arguments, std::ostream &log) {
+		const int pixelsPerSize = std::clamp(arguments.empty() ? 16 : std::atoi(arguments.at(0).c_str()), 1, 1000) * 1000000;
+		bool allTilesMatch = true;
+		for (int tileSize = 4; tileSize <= 512; tileSize *= 2) {
+			// Runs of masked pixels of random length, about a third of the tile, like the see-through parts of the skin images
+			AllegroBitmap tileBitmap;
+			tileBitmap.Create(tileSize, tileSize, 32);
+			uint32_t randomState = 12345;
+			bool masked = false;
+			int runLeft = 0;
+			for (int posY = 0; posY < tileSize; ++posY) {
+				for (int posX = 0; posX < tileSize; ++posX) {
+					if (runLeft-- <= 0) {
+						randomState = randomState * 1664525U + 1013904223U;
+						masked = (randomState >> 28) < 5;
+						runLeft = static_cast<int>((randomState >> 8) % 24);
+					}
+					tileBitmap.SetPixel(posX, posY, masked ? tileBitmap.GetColorKey() : static_cast<unsigned long>((posX * 0x010203 + posY * 0x030201) & 0xFFFFFF));
+				}
+			}
+			AllegroBitmap destBitmap;
+			destBitmap.Create(tileSize, tileSize, 32);
+			const int blitCount = std::max(pixelsPerSize / (tileSize * tileSize), 1);
+
+			// Blitting the same tile again leaves the same pixels, so every timed run does the same work from a destination cleared once
+			clear_to_color(destBitmap.GetBitmap(), 0x204060);
+			double allegroTime = TimeFastestRun([&tileBitmap, &destBitmap, tileSize, blitCount]() {
+				for (int blitIndex = 0; blitIndex < blitCount; ++blitIndex) { masked_blit(tileBitmap.GetBitmap(), destBitmap.GetBitmap(), 0, 0, 0, 0, tileSize, tileSize); }
+			});
+			uint64_t allegroHash = HashBitmap(&destBitmap);
+
+			clear_to_color(destBitmap.GetBitmap(), 0x204060);
+			double drawTransTime = TimeFastestRun([&tileBitmap, &destBitmap, blitCount]() {
+				for (int blitIndex = 0; blitIndex < blitCount; ++blitIndex) { tileBitmap.DrawTrans(&destBitmap, 0, 0, nullptr); }
+			});
+			uint64_t drawTransHash = HashBitmap(&destBitmap);
+
+			log << tileSize << "x" << tileSize << ", " << blitCount << " blits: masked_blit " << allegroTime * 1000000 / blitCount << " ns, DrawTrans " << drawTransTime * 1000000 / blitCount << " ns, " << allegroTime / drawTransTime << "x\n";
+			if (drawTransHash != allegroHash) {
+				log << tileSize << "x" << tileSize << ": DrawTrans left DIFFERENT pixels than masked_blit\n";
+				allTilesMatch = false;
+			}
+		}
+		return allTilesMatch;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorChecks::CheckCulledDrawing(const std::vector<std::string> &arguments, std::ostream &log) {
+		SoftwareScreen drawScreen(1920, 1080);
+		GUIInput drawInput(-1);
+		GUIControlManager drawControlManager;
+		if (!drawControlManager.Create(&drawScreen, &drawInput, "Assets", "EditorSkin.ini")) {
+			log << "Couldn't load the editor skin.\n";
+			return false;
+		}
+		// A box with a long list of rows in it, like a panel of settings before it's scrolled, so all but the first few rows are outside the box and the screen
+		const int rowCount = std::max(arguments.empty() ? 2000 : std::atoi(arguments.at(0).c_str()), 1);
+		GUICollectionBox *listBox = dynamic_cast<GUICollectionBox *>(drawControlManager.AddControl("List", "COLLECTIONBOX", nullptr, 100, 100, 600, 400));
+		listBox->SetDrawType(GUICollectionBox::Panel);
+		std::vector<GUIControl *> rowControls;
+		for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+			const std::string rowName = "Row" + std::to_string(rowIndex);
+			GUICheckbox *checkbox = dynamic_cast<GUICheckbox *>(drawControlManager.AddControl(rowName + "Checkbox", "CHECKBOX", listBox, 5, 5 + rowIndex * 25, 180, 20));
+			checkbox->SetText("Setting number " + std::to_string(rowIndex));
+			checkbox->SetCheck(rowIndex % 3 == 0);
+			GUILabel *label = dynamic_cast<GUILabel *>(drawControlManager.AddControl(rowName + "Label", "LABEL", listBox, 190, 5 + rowIndex * 25, 250, 20));
+			label->SetText("What setting " + std::to_string(rowIndex) + " does");
+			GUITextBox *textBox = dynamic_cast<GUITextBox *>(drawControlManager.AddControl(rowName + "TextBox", "TEXTBOX", listBox, 450, 5 + rowIndex * 25, 140, 20));
+			textBox->SetText("Value " + std::to_string(rowIndex));
+			rowControls.insert(rowControls.end(), { checkbox, label, textBox });
+		}
+		GUIRect listRect = *listBox->GetPanel()->GetRect();
+		std::vector<GUIPanel *> hiddenPanels;
+		for (GUIControl *rowControl : rowControls) {
+			if (!RectsOverlap(*rowControl->GetPanel()->GetRect(), listRect)) { hiddenPanels.push_back(rowControl->GetPanel()); }
+		}
+
+		GUIBitmap *drawBitmap = drawScreen.GetBitmap();
+		GUIRect screenRect;
+		SetRect(&screenRect, 0, 0, drawBitmap->GetWidth() - 1, drawBitmap->GetHeight() - 1);
+		const int frameCount = 20;
+		// Without culling, GUIPanel::Draw drew every child clipped to the box, so the frame is drawn as it is now and then the culled rows are drawn the same way on top.
+		// They're all outside the clipping rectangle, so the frame has to stay the same.
+		auto drawFrames = [&drawControlManager, &drawScreen, drawBitmap, &screenRect, &listRect, frameCount](const std::vector<GUIPanel *> &culledPanels) {
+			for (int frame = 0; frame < frameCount; ++frame) {
+				drawBitmap->SetClipRect(&screenRect);
+				drawBitmap->DrawRectangle(0, 0, drawBitmap->GetWidth(), drawBitmap->GetHeight(), 0, true);
+				drawControlManager.Draw();
+				for (GUIPanel *culledPanel : culledPanels) {
+					drawBitmap->SetClipRect(&listRect);
+					culledPanel->Draw(&drawScreen);
+				}
+			}
+		};
+		double culledTime = TimeFastestRun([&drawFrames]() { drawFrames({}); }) / frameCount;
+		uint64_t culledHash = HashBitmap(drawBitmap);
+		double unculledTime = TimeFastestRun([&drawFrames, &hiddenPanels]() { drawFrames(hiddenPanels); }) / frameCount;
+		uint64_t unculledHash = HashBitmap(drawBitmap);
+
+		log << rowControls.size() << " controls, " << rowControls.size() - hiddenPanels.size() << " inside the box\n";
+		log << "Culled: frame hash " << std::hex << culledHash << std::dec << ", " << culledTime << " ms per frame\n";
+		log << "Not culled: frame hash " << std::hex << unculledHash << std::dec << ", " << unculledTime << " ms per frame\n";
+		log << "Culling saves " << unculledTime - culledTime << " ms per frame, " << unculledTime / culledTime << "x the speed\n";
+		if (culledHash != unculledHash) { log << "The culled controls DREW SOMETHING, so culling left them out of the frame\n"; }
+		return culledHash == unculledHash && culledTime < unculledTime;
+	}
+}
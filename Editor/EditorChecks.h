@@ -0,0 +1,121 @@
+#ifndef _RTEGUIEDITORCHECKS_
+#define _RTEGUIEDITORCHECKS_
+
+namespace RTEGUI {
+
+	/// <summary>
+	/// Headless checks and benchmarks of the GUI library, run with "GUIEditor.exe -check name [arguments]" instead of starting the editor.
+	/// Each check writes what it measured to a log file and reports whether the results were correct, so they can be run by scripts.
+	/// </summary>
+	class EditorChecks {
+
+	public:
+
+		/// <summary>
+		/// Runs one check, or all of them, and writes their results to a log file.
+		/// </summary>
+		/// <param name="arguments">The name of the check to run, or "all", followed by the check's own arguments.</param>
+		/// <param name="logFilePath">The file to write the results to. Replaced if it exists.</param>
+		/// <returns>Whether every check that ran passed. False if there is no check with that name.</returns>
+		static bool Run(const std::vector<std::string> &arguments, const std::string &logFilePath);
+
+	private:
+
+		/// <summary>
+		/// Draws a layout headless with the editor skin, on one thread and then in tiles on 2 threads up to one per hardware thread, and compares the frames.
+		/// </summary>
+		/// <param name="arguments">Optionally the layout file to draw, otherwise a generated one is used, and the most threads to draw with.</param>
+		/// <param name="log">The stream to write the frame hashes and drawing times to.</param>
+		/// <returns>Whether every tiled frame is the same as the one drawn on one thread.</returns>
+		static bool CheckTiledDrawing(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Loads an image and draws it with SoftwareBitmap and with Allegro through opaque, color-keyed and scaled blits and filled rectangles, clipped and not, and compares the results pixel by pixel.
+		/// </summary>
+		/// <param name="arguments">Optionally the image file to load, otherwise the blue skin image.</param>
+		/// <param name="log">The stream to write the number of different pixels in each case to.</param>
+		/// <returns>Whether SoftwareBitmap drew every pixel the same as Allegro.</returns>
+		static bool CheckSoftwareBitmap(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Loads a set of images the way the editor does on startup, without the image cache, with an empty one and with a filled one, and compares the times and the loaded pixels.
+		/// </summary>
+		/// <param name="arguments">Optionally the image files to load, otherwise every PNG in the editor's assets.</param>
+		/// <param name="log">The stream to write the loading times to.</param>
+		/// <returns>Whether every image got a cache entry and loads the same from the cache as decoded.</returns>
+		static bool CheckImageCache(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Switches a layout between the four workspace skins over and over with a loaded bitmap budget of about two skins, and tracks how much bitmap memory stays loaded.
+		/// </summary>
+		/// <param name="arguments">Optionally how many times to cycle through the skins, otherwise 1000.</param>
+		/// <param name="log">The stream to write the loaded bitmap memory and the number of freed bitmaps to.</param>
+		/// <returns>Whether the loaded bitmap memory never grew past its peak from the first cycle, and the replaced skins' bitmaps were freed.</returns>
+		static bool CheckSkinCycle(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Gets and sets the properties of a control with about as many properties as the biggest ones have, in a fixed random order, and times it.
+		/// </summary>
+		/// <param name="arguments">Optionally how many gets and sets to do, otherwise 10 million.</param>
+		/// <param name="log">The stream to write the time per get or set to.</param>
+		/// <returns>Whether every get returned the value last set.</returns>
+		static bool CheckProperties(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Generates a layout of 5000 controls, saves it, times loading it back, and looks every control up by name.
+		/// </summary>
+		/// <param name="arguments">Optionally how many controls to generate, otherwise 5000.</param>
+		/// <param name="log">The stream to write the adding, loading and lookup times to.</param>
+		/// <returns>Whether every control was loaded back and can be found by its name, and names that were never added find nothing.</returns>
+		static bool CheckControlIndex(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Pushes a million events through the control manager's event queue in bursts of random size, some bigger than the queue, and reads each burst back.
+		/// </summary>
+		/// <param name="arguments">Optionally how many events to push, otherwise a million.</param>
+		/// <param name="log">The stream to write the queue capacity, the time per event and the number of dropped events to.</param>
+		/// <returns>Whether every burst came out oldest first with exactly the events that fit, and every event that didn't fit was counted as dropped.</returns>
+		static bool CheckEventQueue(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Generates a 10 MB layout and reads it line by line like Load used to, through GUIReader::ReadLine as it was before it buffered its files and as it is now, then with ReadLayoutLine and ParseLayout, and compares the times and what each found.
+		/// </summary>
+		/// <param name="arguments">Optionally the size of the layout in MB, otherwise 10.</param>
+		/// <param name="log">The stream to write the reading times to.</param>
+		/// <returns>Whether all four found the same sections and properties, and ReadLayoutLine is at least 10x the speed of the unbuffered GUIReader.</returns>
+		static bool CheckLayoutParsing(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Generates a layout of 20000 controls and saves its snapshot the way Save used to, one string per control streamed into a file, then through the buffered GUIWriter, and times both against writing the finished file in one go.
+		/// </summary>
+		/// <param name="arguments">Optionally how many controls to generate, otherwise 20000.</param>
+		/// <param name="log">The stream to write the saving times to.</param>
+		/// <returns>Whether both wrote the same file, and the buffered GUIWriter was faster.</returns>
+		static bool CheckLayoutSaving(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Generates a binary tree of include files 10 levels deep and reads it through GUIReader, then reads the same properties from one file, and compares the times and what was read.
+		/// </summary>
+		/// <param name="arguments">Optionally how many levels deep the tree is, otherwise 10, which is 1023 files.</param>
+		/// <param name="log">The stream to write the reading times and the time each include file adds to.</param>
+		/// <returns>Whether every property was read in the order it was written, with the file and line it was written at.</returns>
+		static bool CheckIncludeTree(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Blits a color-keyed tile onto a memory bitmap over and over through Allegro's masked_blit and through AllegroBitmap::DrawTrans, at every tile size from 4x4 to 512x512, and compares the times and the pixels left.
+		/// </summary>
+		/// <param name="arguments">Optionally how many million pixels to blit at each tile size, otherwise 16.</param>
+		/// <param name="log">The stream to write the time per blit at each tile size to.</param>
+		/// <returns>Whether DrawTrans left the same pixels as masked_blit at every tile size.</returns>
+		static bool CheckTransparentBlit(const std::vector<std::string> &arguments, std::ostream &log);
+
+		/// <summary>
+		/// Draws a box with 2000 rows of controls, all but the first few outside it, with the rows outside culled and with them drawn clipped to the box like GUIPanel::Draw did before it culled, and compares the frames and drawing times.
+		/// </summary>
+		/// <param name="arguments">Optionally how many rows of controls to put in the box, otherwise 2000.</param>
+		/// <param name="log">The stream to write the frame hashes and drawing times to.</param>
+		/// <returns>Whether both frames are the same, and culling made drawing faster.</returns>
+		static bool CheckCulledDrawing(const std::vector<std::string> &arguments, std::ostream &log);
+	};
+}
+#endif
@@ -30,6 +30,7 @@ namespace RTEGUI {
 		m_LeftColumn->SetDrawBackground(true);
 		m_LeftColumn->SetDrawColor(makecol(23, 23, 23));
 		m_LeftColumn->SetDrawType(GUICollectionBox::Color);
+		m_LeftColumn->SetCacheLayer(true);
 
 		GUICollectionBox *editorControls = dynamic_cast<GUICollectionBox *>(m_EditorControlManager->AddControl("EditorControlsPanel", "COLLECTIONBOX", m_LeftColumn.get(), 0, 30, 270, 155));
 		editorControls->SetDrawType(GUICollectionBox::Panel);
@@ -88,6 +89,7 @@ namespace RTEGUI {
 		m_RightColumn->SetDrawBackground(true);
 		m_RightColumn->SetDrawColor(makecol(23, 23, 23));
 		m_RightColumn->SetDrawType(GUICollectionBox::Color);
+		m_RightColumn->SetCacheLayer(true);
 
 		GUICollectionBox *listsPanel = dynamic_cast<GUICollectionBox *>(m_EditorControlManager->AddControl("ControlListsPanel", "COLLECTIONBOX", m_RightColumn.get(), 15, 30, m_RightColumn->GetWidth() - 15, 505));
 		listsPanel->SetDrawType(GUICollectionBox::Panel);
@@ -116,7 +118,7 @@ namespace RTEGUI {
 		toolBarStrip->SetDrawColor(makecol(16, 16, 16));
 		toolBarStrip->SetDrawType(GUICollectionBox::Color);
 
-		GUILabel *frameTimeLabel = dynamic_cast<GUILabel *>(m_EditorControlManager->AddControl("FrameTimer", "LABEL", toolBarStrip, 370, 0, 100, 20));
+		GUILabel *frameTimeLabel = dynamic_cast<GUILabel *>(m_EditorControlManager->AddControl("FrameTimer", "LABEL", toolBarStrip, 370, 0, 250, 20));
 		frameTimeLabel->SetText("Frame Time: 0");
 
 		GUIButton *toolBarButton = dynamic_cast<GUIButton *>(m_EditorControlManager->AddControl("NewButton", "BUTTON", m_ToolBar.get(), 0, 0, 60, 20));
@@ -154,8 +156,8 @@ namespace RTEGUI {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void EditorManager::SetFrameTimeLabelText(int64_t frameTime) const {
-		dynamic_cast<GUILabel *>(m_EditorControlManager->GetControl("FrameTimer"))->SetText("Frame Time: " + std::to_string(frameTime) + "ms");
+	void EditorManager::SetFrameTimeLabelText(int64_t frameTime, int64_t repaintedPixels) const {
+		dynamic_cast<GUILabel *>(m_EditorControlManager->GetControl("FrameTimer"))->SetText("Frame Time: " + std::to_string(frameTime) + "ms | Repainted: " + std::to_string(repaintedPixels) + "px");
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -191,14 +193,7 @@ namespace RTEGUI {
 		for (int i = 1; i < 1000; ++i) {
 			newControlName = s_SelectionCopyInfo.Name + " - copy " + std::to_string(i);
 			// Check if this name exists
-			bool found = false;
-			for (GUIControl *control : *m_WorkspaceManager->GetControlList()) {
-				if (control->GetName() == newControlName) {
-					found = true;
-					break;
-				}
-			}
-			if (!found) {
+			if (!m_WorkspaceManager->GetControl(newControlName)) {
 				break;
 			}
 		}
@@ -253,14 +248,7 @@ namespace RTEGUI {
 			controlName.append(std::to_string(i));
 
 			// Check if this name exists
-			bool found = false;
-			for (GUIControl *control : *m_WorkspaceManager->GetControlList()) {
-				if (control->GetName() == controlName) {
-					found = true;
-					break;
-				}
-			}
-			if (!found) {
+			if (!m_WorkspaceManager->GetControl(controlName)) {
 				return controlName;
 			}
 		}
@@ -347,6 +335,7 @@ namespace RTEGUI {
 		std::string lastSelection = (m_CollectionBoxList->GetSelectedIndex() != -1) ? m_CollectionBoxList->GetSelected()->m_Name : "";
 
 		m_CollectionBoxList->ClearList();
+		m_CollectionBoxList->BeginUpdate();
 		m_CollectionBoxList->AddItem(m_RootControl->GetName());
 
 		// Lambda expression to recursively add lower-level CollectionBoxes belonging to the higher-level CollectionBoxes
@@ -362,13 +351,16 @@ namespace RTEGUI {
 			if ((collectionBox = dynamic_cast<GUICollectionBox *>(control)) && collectionBox->GetParent() == m_RootControl) { recursiveAddItem(collectionBox, "\t"); }
 		}
 
+		m_CollectionBoxList->EndUpdate();
+
+		int selectionIndex = 0;
 		for (const GUIListBox::Item *listEntry : *m_CollectionBoxList->GetItemList()) {
 			if (listEntry->m_Name == lastSelection) {
-				m_CollectionBoxList->SetSelectedIndex(listEntry->m_ID);
+				selectionIndex = listEntry->m_ID;
 				break;
 			}
-			m_CollectionBoxList->SetSelectedIndex(0);
 		}
+		m_CollectionBoxList->SetSelectedIndex(selectionIndex);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -378,13 +370,16 @@ namespace RTEGUI {
 			return;
 		}
 		m_ControlsInCollectionBoxList->ClearList();
+		m_ControlsInCollectionBoxList->BeginUpdate();
 
 		// Go through all the top-level (directly under root) controls and add only the CollectionBoxes to the list here
 		for (GUIControl *control : *collectionBox->GetChildren()) {
 			if (control->GetID() != "COLLECTIONBOX") { m_ControlsInCollectionBoxList->AddItem(control->GetName()); }
-			// Check if this is selected in the editor, and if so, select it in the list too
-			if (collectionBox == s_SelectionInfo.GetControl()) { m_ControlsInCollectionBoxList->SetSelectedIndex(-1); }
 		}
+		m_ControlsInCollectionBoxList->EndUpdate();
+
+		// Check if this is selected in the editor, and if so, clear the selection in the list
+		if (!collectionBox->GetChildren()->empty() && collectionBox == s_SelectionInfo.GetControl()) { m_ControlsInCollectionBoxList->SetSelectedIndex(-1); }
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -405,9 +400,10 @@ namespace RTEGUI {
 			return nullptr;
 		}
 
-		// Check children. Check in reverse because top most visible control is last in the list.
-		for (std::vector<GUIControl *>::reverse_iterator childListEntry = control->GetChildren()->rbegin(); childListEntry != control->GetChildren()->rend(); childListEntry++) {
-			GUIControl *childControl = ControlUnderMouse(*childListEntry, mousePosX, mousePosY);
+		// Check children. Only the ones in the grid cell under the mouse can contain it. Check in reverse because top most visible control is last in the list.
+		const std::vector<int> &childCandidates = control->GetChildrenAtPoint(mousePosX, mousePosY);
+		for (std::vector<int>::const_reverse_iterator childIndex = childCandidates.rbegin(); childIndex != childCandidates.rend(); childIndex++) {
+			GUIControl *childControl = ControlUnderMouse(control->GetChildren()->at(*childIndex), mousePosX, mousePosY);
 			if (childControl) {
 				return childControl;
 			}
@@ -139,7 +139,8 @@ namespace RTEGUI {
 		/// Sets the frame time label text.
 		/// </summary>
 		/// <param name="frameTime">The new frame time value to set.</param>
-		void SetFrameTimeLabelText(int64_t frameTime) const;
+		/// <param name="repaintedPixels">The number of pixels repainted in the last frame.</param>
+		void SetFrameTimeLabelText(int64_t frameTime, int64_t repaintedPixels) const;
 
 		/// <summary>
 		/// Removes focus from whatever element currently focused in the editor controls.
@@ -183,9 +183,9 @@ namespace RTEGUI {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void EditorSelection::DrawSelectionBox(GUIScreen *screen, const GUIInput *input) {
+	bool EditorSelection::GetSelectionBoxRect(const GUIInput *input, GUIRect &boxRect) {
 		if (!m_Control) {
-			return;
+			return false;
 		}
 
 		int mousePosX;
@@ -198,7 +198,7 @@ namespace RTEGUI {
 		int controlHeight;
 		m_Control->GetControlRect(&controlPosX, &controlPosY, &controlWidth, &controlHeight);
 
-		// If we've grabbed and moved the control, draw the selection box where the mouse was moved to
+		// If we've grabbed and moved the control, the selection box is where the mouse was moved to
 		if (m_GrabbingControl && m_GrabTriggered) {
 			controlPosX = ProcessSnapCoord(mousePosX + m_GrabX);
 			controlPosY = ProcessSnapCoord(mousePosY + m_GrabY);
@@ -207,9 +207,26 @@ namespace RTEGUI {
 		// Grabbed handles
 		if (m_GrabbingHandle && m_GrabTriggered) { CalculateHandleResize(mousePosX, mousePosY, controlPosX, controlPosY, controlWidth, controlHeight); }
 
+		// Leave room for the handles around the edges
+		SetRect(&boxRect, controlPosX - 6, controlPosY - 6, controlPosX + controlWidth + 6, controlPosY + controlHeight + 6);
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void EditorSelection::DrawSelectionBox(GUIScreen *screen, const GUIInput *input) {
 		GUIRect clipRect;
-		SetRect(&clipRect, controlPosX - 6, controlPosY - 6, controlPosX + controlWidth + 6, controlPosY + controlHeight + 6);
-		screen->GetBitmap()->SetClipRect(&clipRect);
+		if (!GetSelectionBoxRect(input, clipRect)) {
+			return;
+		}
+		int controlPosX = clipRect.left + 6;
+		int controlPosY = clipRect.top + 6;
+		int controlWidth = clipRect.right - 6 - controlPosX;
+		int controlHeight = clipRect.bottom - 6 - controlPosY;
+
+		GUIRect prevClipRect;
+		screen->GetBitmap()->GetClipRect(&prevClipRect);
+		screen->GetBitmap()->AddClipRect(&clipRect);
 
 		screen->GetBitmap()->DrawRectangle(controlPosX, controlPosY, controlWidth, controlHeight, 0xFFCCCCCC, false);
 
@@ -219,7 +236,7 @@ namespace RTEGUI {
 			if (i != 1) { DrawSelectionBoxHandle(screen, controlPosX + controlWidth / 2, controlPosY + i * (controlHeight / 2)); }
 			DrawSelectionBoxHandle(screen, controlPosX + controlWidth, controlPosY + i * (controlHeight / 2));
 		}
-		screen->GetBitmap()->SetClipRect(nullptr);
+		screen->GetBitmap()->SetClipRect(&prevClipRect);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -144,6 +144,14 @@ namespace RTEGUI {
 #pragma endregion
 
 #pragma region Drawing
+		/// <summary>
+		/// Gets the screen area covered by the selection box, including the resize handles and wherever the grabbed element is being dragged to.
+		/// </summary>
+		/// <param name="input">Pointer to the GUIInput to get the mouse position from.</param>
+		/// <param name="boxRect">Will be set to the area covered by the selection box.</param>
+		/// <returns>Whether there is a selection box covering any area.</returns>
+		bool GetSelectionBoxRect(const GUIInput *input, GUIRect &boxRect);
+
 		/// <summary>
 		/// Draws the selection box around the selected GUI element.
 		/// </summary>
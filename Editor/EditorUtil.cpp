@@ -51,6 +51,50 @@ namespace RTEGUI {
 		return false;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool EditorUtil::DisplayLoadFilesDialogBox(std::vector<std::string> &filenames, const HWND &windowHandle) {
+		OPENFILENAMEA dialogBox;
+		// With multiple selection the dialog returns the directory followed by every file name, so give it more than MAX_PATH to work with.
+		std::string filenamesToLoad(MAX_PATH * 64, '\0');
+
+		std::string currentDir(MAX_PATH, '\0');
+		currentDir = std::filesystem::current_path().string();
+
+		ZeroMemory(&dialogBox, sizeof(OPENFILENAME)); // Initialize OPENFILENAME
+		dialogBox.lStructSize = sizeof(OPENFILENAME);
+		dialogBox.hInstance = nullptr;
+		dialogBox.hwndOwner = windowHandle;
+		dialogBox.lpstrFile = filenamesToLoad.data();
+		dialogBox.nMaxFile = filenamesToLoad.size();
+		dialogBox.lpstrFilter = "GUI Files (*.ini)\0*.ini\0All Files\0*.*";
+		dialogBox.nFilterIndex = 1;
+		dialogBox.lpstrFileTitle = nullptr;
+		dialogBox.nMaxFileTitle = 0;
+		dialogBox.lpstrTitle = "Add Files";
+		dialogBox.lpstrInitialDir = currentDir.data();
+		dialogBox.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST | OFN_ALLOWMULTISELECT | OFN_EXPLORER;
+		dialogBox.lpstrDefExt = "ini";
+
+		filenames.clear();
+		if (GetOpenFileName(&dialogBox)) {
+			// The buffer holds null-separated entries ending with an empty one. A single selection is just its full path, otherwise the first entry is the directory.
+			std::vector<std::string> entries;
+			for (const char *entry = filenamesToLoad.data(); *entry != '\0'; entry += entries.back().size() + 1) {
+				entries.emplace_back(entry);
+			}
+			if (entries.size() == 1) {
+				filenames = entries;
+			} else {
+				for (size_t entryIndex = 1; entryIndex < entries.size(); ++entryIndex) {
+					filenames.emplace_back((std::filesystem::path(entries.front()) / entries.at(entryIndex)).string());
+				}
+			}
+		}
+		std::filesystem::current_path(currentDir);
+		return !filenames.empty();
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool EditorUtil::DisplaySaveFileDialogBox(std::string &filename, const HWND &windowHandle) {
@@ -30,6 +30,14 @@ namespace RTEGUI {
 		/// <returns>True if a file was selected.</returns>
 		static bool DisplayLoadFileDialogBox(std::string &filename, const HWND &windowHandle);
 
+		/// <summary>
+		/// Display load GUI file OS dialog box that allows selecting several files at once.
+		/// </summary>
+		/// <param name="filenames">Vector to fill with the full paths of the selected files.</param>
+		/// <param name="windowHandle">The window handle of the editor process.</param>
+		/// <returns>True if at least one file was selected.</returns>
+		static bool DisplayLoadFilesDialogBox(std::vector<std::string> &filenames, const HWND &windowHandle);
+
 		/// <summary>
 		/// Display save GUI file OS dialog box.
 		/// </summary>
@@ -24,17 +24,27 @@ struct GUIRect { long left; long top; long right; long bottom; };
 /// <param name="right">Position of bottom right corner on X axis.</param>
 /// <param name="bottom">Position of bottom right corner on Y axis.</param>
 inline void SetRect(GUIRect *rect, int left, int top, int right, int bottom) { rect->left = left; rect->top = top; rect->right = right; rect->bottom = bottom; }
+
+/// <summary>
+/// Checks whether two GUIRects overlap. Edges are inclusive, same as clipping rectangles.
+/// </summary>
+/// <param name="first">The first GUIRect.</param>
+/// <param name="second">The second GUIRect.</param>
+/// <returns>Whether the two GUIRects share at least one point.</returns>
+inline bool RectsOverlap(const GUIRect &first, const GUIRect &second) { return first.left <= second.right && second.left <= first.right && first.top <= second.bottom && second.top <= first.bottom; }
 #pragma endregion
 
 #ifndef GUI_STANDALONE
 #include "RTETools.h"
 #endif
 
+#include "GUIClipStack.h"
 #include "GUIInterface.h"
 #include "GUIProperties.h"
 #include "GUIInput.h"
 #include "GUIFont.h"
 #include "GUISkin.h"
+#include "GUIHitGrid.h"
 #include "GUIPanel.h"
 #include "GUIManager.h"
 #include "GUIUtil.h"
@@ -10,6 +10,9 @@ using namespace RTE;
 GUIButton::GUIButton(GUIManager *Manager, GUIControlManager *ControlManager) : GUIControl(), GUIPanel(Manager) {
 	m_ControlID = "BUTTON";
 	m_DrawBitmap = nullptr;
+	m_UpSection = nullptr;
+	m_OverSection = nullptr;
+	m_DownSection = nullptr;
 	m_ControlManager = ControlManager;
 	m_Pushed = false;
 	m_Over = false;
@@ -117,13 +120,19 @@ void GUIButton::Destroy() {
 void GUIButton::ChangeSkin(GUISkin *Skin) {
 	GUIControl::ChangeSkin(Skin);
 
+	m_UpSection = m_Skin->GetSection("Button_Up");
+	m_OverSection = m_Skin->GetSection("Button_Over");
+	m_DownSection = m_Skin->GetSection("Button_Down");
+
 	// Build the button bitmap
 	BuildBitmap();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void GUIButton::BuildBitmap() {
+void GUIButton::BuildBitmap(bool Invalidating) {
+	if (Invalidating) { Invalidate(); }
+
 	// Free any old bitmap
 	if (m_DrawBitmap) {
 		m_DrawBitmap->Destroy();
@@ -151,10 +160,10 @@ void GUIButton::BuildBitmap() {
 
 	// Create the button image
 	GUIRect buttonBorders;
-	m_Skin->BuildStandardRect(m_DrawBitmap, "Button_Up", 0, 0, m_Width, m_Height, true, true, &buttonBorders);
+	m_Skin->BuildStandardRect(m_DrawBitmap, m_UpSection, 0, 0, m_Width, m_Height, true, true, &buttonBorders);
 	SetRect(m_BorderSizes.get(), buttonBorders.left, buttonBorders.top, buttonBorders.right, buttonBorders.bottom);
-	m_Skin->BuildStandardRect(m_DrawBitmap, "Button_Over", 0, m_Height, m_Width, m_Height);
-	m_Skin->BuildStandardRect(m_DrawBitmap, "Button_Down", 0, m_Height * 2, m_Width, m_Height);
+	m_Skin->BuildStandardRect(m_DrawBitmap, m_OverSection, 0, m_Height, m_Width, m_Height);
+	m_Skin->BuildStandardRect(m_DrawBitmap, m_DownSection, 0, m_Height * 2, m_Width, m_Height);
 
 	//TODO this should be 1 pixel ideally, to give space between content and the border. However, the green skin, which this is primarly used for, has padding built-in and doesn't work properly without it.
 	const int buttonContentPadding = 0;
@@ -231,7 +240,7 @@ void GUIButton::Draw(GUIScreen *Screen) {
 	}
 	SetRect(&Rect, 0, y, m_Width, y + m_Height);
 
-	if (m_Text->OverflowScrollIsActivated() && m_Font->CalculateWidth(m_Text->GetText()) > m_Width - m_BorderSizes->left - m_BorderSizes->right) { BuildBitmap(); }
+	if (!IsDrawingTiles()) { UpdateScrollingText(); }
 
 	m_DrawBitmap->DrawTrans(Screen->GetBitmap(), m_X, m_Y, &Rect);
 
@@ -240,6 +249,25 @@ void GUIButton::Draw(GUIScreen *Screen) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GUIButton::PrepareDraw(GUIScreen *Screen) {
+	UpdateScrollingText();
+
+	GUIPanel::PrepareDraw(Screen);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIButton::UpdateScrollingText() {
+	// The scrolling text is drawn into the button bitmap, so only rebuild it when the text is due to move, then come back when it next is
+	if (m_Text->OverflowScrollIsActivated() && m_Font->CalculateWidth(m_Text->GetText()) > m_Width - m_BorderSizes->left - m_BorderSizes->right) {
+		if (m_Text->GetOverflowScrollRedrawDelay() == 0) { BuildBitmap(false); }
+		double RedrawDelay = m_Text->GetOverflowScrollRedrawDelay();
+		if (RedrawDelay >= 0) { InvalidateAfter(RedrawDelay); }
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void GUIButton::OnMouseDown(int X, int Y, int Buttons, int Modifier) {
 	if (Buttons & MOUSE_LEFT) {
 		SetPushed(true);
@@ -372,6 +400,8 @@ void GUIButton::Resize(int Width, int Height) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIButton::SetPushed(bool pushed) {
+	Invalidate();
+
 	m_Pushed = pushed;
 	if (pushed) {
 		m_Text->ActivateDeactivateOverflowScroll(true);
@@ -76,6 +76,15 @@ public:
     void Draw(GUIScreen *Screen) override;
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PrepareDraw
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Moves the scrolling text on before drawing in tiles.
+// Arguments:       Screen class
+
+    void PrepareDraw(GUIScreen *Screen) override;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:  OnMouseDown
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -275,6 +284,9 @@ public:
 private:
 
 	GUIBitmap *m_DrawBitmap;
+	const GUISkin::SkinSection *m_UpSection; // Skin sections of the three button states, looked up when the skin changes
+	const GUISkin::SkinSection *m_OverSection;
+	const GUISkin::SkinSection *m_DownSection;
 
 	bool m_Pushed;
 	bool m_Over;
@@ -287,9 +299,20 @@ private:
 // Method:          BuildBitmap
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Create the button bitmap to draw.
+// Arguments:       Whether to mark the button as needing repainting. Not needed when
+//                  rebuilding while the button is being drawn.
+
+    void BuildBitmap(bool Invalidating = true);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          UpdateScrollingText
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Rebuilds the button bitmap if the text overflowing it is due to move,
+//                  and schedules the repaint for when it next is.
 // Arguments:       None.
 
-    void BuildBitmap();
+    void UpdateScrollingText();
 };
 };
 #endif
\ No newline at end of file
@@ -89,6 +89,8 @@ void GUICheckbox::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICheckbox::BuildBitmap() {
+	Invalidate();
+
 	std::string Filename;
 	unsigned long ColorIndex = 0;
 	int Values[4];
@@ -139,8 +141,10 @@ void GUICheckbox::Draw(GUIScreen *Screen) {
 		return;
 	}
 
-	// Setup the clipping
-	Screen->GetBitmap()->SetClipRect(GetRect());
+	// Setup the clipping, keeping within the area already being clipped to
+	GUIRect PrevClip;
+	Screen->GetBitmap()->GetClipRect(&PrevClip);
+	Screen->GetBitmap()->AddClipRect(GetRect());
 
 	// Calculate the y position of the base
 	// Make it centered vertically
@@ -175,7 +179,7 @@ void GUICheckbox::Draw(GUIScreen *Screen) {
 		m_Font->SetKerning(m_FontKerning);
 		m_Font->Draw(Screen->GetBitmap(), m_X + (m_ImageRects[0].right - m_ImageRects[0].left) + 2, m_Y + (m_Height / 2) - (m_Font->GetFontHeight() / 2) - 1, Text, m_FontShadow);
 	}
-	Screen->GetBitmap()->SetClipRect(nullptr);
+	Screen->GetBitmap()->SetClipRect(&PrevClip);
 
 	GUIPanel::Draw(Screen);
 }
@@ -268,6 +272,8 @@ void GUICheckbox::StoreProperties() {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICheckbox::SetText(const std::string &Text) {
+	Invalidate();
+
 	m_Text = Text;
 }
 
@@ -280,6 +286,8 @@ std::string GUICheckbox::GetText() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICheckbox::SetCheck(int Check) {
+	Invalidate();
+
 	m_Check = Check;
 }
 
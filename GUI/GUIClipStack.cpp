@@ -0,0 +1,69 @@
+#include "GUI.h"
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GUIClipStack::Clear() {
+		m_ClipRects.clear();
+		SetRect(&m_AppliedClipRect, 0, 0, -1, -1);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	const GUIRect & GUIClipStack::Push(GUIBitmap *bitmap, const GUIRect &rect) {
+		if (m_ClipRects.empty()) {
+			GUIRect bitmapClipRect;
+			bitmap->GetClipRect(&bitmapClipRect);
+			m_ClipRects.push_back(bitmapClipRect);
+			m_AppliedClipRect = bitmapClipRect;
+		}
+		const GUIRect &currentClipRect = m_ClipRects.back();
+		int left = std::max(rect.left, currentClipRect.left);
+		int top = std::max(rect.top, currentClipRect.top);
+		int right = std::min(rect.right, currentClipRect.right);
+		int bottom = std::min(rect.bottom, currentClipRect.bottom);
+
+		// Clamp like setting the clipping rectangle on the bitmap would, so Apply doesn't end up with something different from what was pushed
+		int bitmapWidth = bitmap->GetWidth();
+		int bitmapHeight = bitmap->GetHeight();
+		GUIRect newClipRect;
+		SetRect(&newClipRect, std::clamp(left, 0, std::max(bitmapWidth - 1, 0)), std::clamp(top, 0, std::max(bitmapHeight - 1, 0)), std::clamp(right + 1, 0, bitmapWidth) - 1, std::clamp(bottom + 1, 0, bitmapHeight) - 1);
+		m_ClipRects.push_back(newClipRect);
+		return m_ClipRects.back();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GUIClipStack::Pop(GUIBitmap *bitmap) {
+		if (m_ClipRects.size() < 2) {
+			return;
+		}
+		m_ClipRects.pop_back();
+		Apply(bitmap);
+		if (m_ClipRects.size() == 1) { m_ClipRects.clear(); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GUIClipStack::Apply(GUIBitmap *bitmap) {
+		if (m_ClipRects.empty()) {
+			return;
+		}
+		GUIRect &currentClipRect = m_ClipRects.back();
+		if (currentClipRect.left != m_AppliedClipRect.left || currentClipRect.top != m_AppliedClipRect.top || currentClipRect.right != m_AppliedClipRect.right || currentClipRect.bottom != m_AppliedClipRect.bottom) {
+			bitmap->SetClipRect(&currentClipRect);
+			m_AppliedClipRect = currentClipRect;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool GUIClipStack::IsVisible(const GUIRect &rect) const {
+		if (m_ClipRects.empty()) {
+			return true;
+		}
+		const GUIRect &currentClipRect = m_ClipRects.back();
+		return currentClipRect.right >= currentClipRect.left && currentClipRect.bottom >= currentClipRect.top && RectsOverlap(rect, currentClipRect);
+	}
+}
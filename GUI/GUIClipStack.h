@@ -0,0 +1,62 @@
+#ifndef _GUICLIPSTACK_
+#define _GUICLIPSTACK_
+
+namespace RTE {
+
+	class GUIBitmap;
+
+	/// <summary>
+	/// The nested clipping rectangles of a panel tree being drawn onto a bitmap, kept in software so the bitmap's clipping rectangle is only touched when it actually changes.
+	/// </summary>
+	class GUIClipStack {
+
+	public:
+
+		/// <summary>
+		/// Constructor method used to instantiate a GUIClipStack object in system memory.
+		/// </summary>
+		GUIClipStack() { Clear(); }
+
+		/// <summary>
+		/// Empties the stack without touching any bitmap.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Pushes the intersection of the current clipping rectangle and a rectangle, clamped to the bitmap the same way GUIBitmap::AddClipRect does.
+		/// If the stack is empty, the bitmap's current clipping rectangle is read first and becomes the bottom of the stack.
+		/// The bitmap's clipping rectangle isn't changed until Apply is called.
+		/// </summary>
+		/// <param name="bitmap">The bitmap being drawn onto.</param>
+		/// <param name="rect">The rectangle to clip to. Edges are inclusive.</param>
+		/// <returns>The new current clipping rectangle. Its right edge is left of its left edge, or its bottom above its top, if nothing can be drawn.</returns>
+		const GUIRect & Push(GUIBitmap *bitmap, const GUIRect &rect);
+
+		/// <summary>
+		/// Pops the current clipping rectangle and sets the bitmap's clipping rectangle back to the one under it, if it was changed.
+		/// Popping the last pushed rectangle leaves the bitmap clipped like it was before the first Push.
+		/// </summary>
+		/// <param name="bitmap">The bitmap being drawn onto.</param>
+		void Pop(GUIBitmap *bitmap);
+
+		/// <summary>
+		/// Sets the bitmap's clipping rectangle to the current one, if it isn't already.
+		/// Anything drawing onto the bitmap in between is expected to leave its clipping rectangle as it found it.
+		/// </summary>
+		/// <param name="bitmap">The bitmap being drawn onto.</param>
+		void Apply(GUIBitmap *bitmap);
+
+		/// <summary>
+		/// Gets whether a rectangle is at least partly inside the current clipping rectangle.
+		/// </summary>
+		/// <param name="rect">The rectangle to check. Edges are inclusive.</param>
+		/// <returns>Whether anything drawn inside the rectangle could show up.</returns>
+		bool IsVisible(const GUIRect &rect) const;
+
+	private:
+
+		std::vector<GUIRect> m_ClipRects; //!< The bitmap's clipping rectangle from before the first Push, followed by the pushed clipping rectangles.
+		GUIRect m_AppliedClipRect; //!< The clipping rectangle the bitmap is known to have.
+	};
+}
+#endif
@@ -3,6 +3,11 @@
 
 using namespace RTE;
 
+size_t GUICollectionBox::s_LayerCacheBudget = 32 * 1024 * 1024;
+size_t GUICollectionBox::s_LayerCacheSize = 0;
+std::vector<GUICollectionBox *> GUICollectionBox::s_CachedLayerBoxes;
+unsigned long GUICollectionBox::s_LayerDrawCount = 0;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GUICollectionBox::GUICollectionBox(GUIManager *Manager, GUIControlManager *ControlManager) : GUIControl(), GUIPanel(Manager) {
@@ -13,6 +18,12 @@ GUICollectionBox::GUICollectionBox(GUIManager *Manager, GUIControlManager *Contr
 	m_DrawType = Color;
 	m_DrawColor = 0;
 	m_DrawBitmap = nullptr;
+	m_CacheLayer = false;
+	m_LayerSize = 0;
+	m_LayerValid = false;
+	m_DrawingLayer = false;
+	m_LayerPrepared = false;
+	m_LayerLastDrawn = 0;
 
 	m_IsContainer = true; // We are a container
 }
@@ -76,11 +87,13 @@ void GUICollectionBox::Create(GUIProperties *Props) {
 		m_DrawType = Panel;
 	}
 	Props->GetValue("DrawColor", &m_DrawColor);
+	Props->GetValue("CacheLayer", &m_CacheLayer);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::Destroy() {
+	ReleaseLayer();
 	delete m_Background;
 	delete m_DrawBitmap;
 }
@@ -97,6 +110,8 @@ void GUICollectionBox::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::BuildBitmap() {
+	Invalidate();
+
 	// Free any old bitmap
 	delete m_DrawBitmap;
 
@@ -110,19 +125,36 @@ void GUICollectionBox::BuildBitmap() {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::Draw(GUIScreen *Screen) {
+	// The layer can't be redrawn from several threads at once, so when drawing in tiles it's used only if PrepareDraw got it ready
+	bool UseLayer = IsDrawingTiles() ? m_LayerPrepared : (m_CacheLayer && UpdateLayer(Screen));
+	if (UseLayer) {
+		// The children are clipped to the box including its right and bottom edges, so the layer is a pixel bigger than the box both ways
+		GUIRect Rect;
+		SetRect(&Rect, 0, 0, m_Width + 1, m_Height + 1);
+		Screen->DrawBitmapTrans(m_Layer->GetBitmap(), m_X, m_Y, &Rect);
+	} else {
+		DrawContents(Screen);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUICollectionBox::DrawContents(GUIScreen *Screen) {
 	if (m_DrawBackground) {
 		if (m_DrawType == Color) {
 			Screen->GetBitmap()->DrawRectangle(m_X, m_Y, m_Width, m_Height, m_Skin->ConvertColor(m_DrawColor, Screen->GetBitmap()->GetColorDepth()), true);
 		} else if (m_DrawType == Image) {
 			if (m_DrawBitmap && m_DrawBackground) {
-				// Setup the clipping
-				Screen->GetBitmap()->SetClipRect(GetRect());
+				// Setup the clipping, keeping within the area already being clipped to
+				GUIRect PrevClip;
+				Screen->GetBitmap()->GetClipRect(&PrevClip);
+				Screen->GetBitmap()->AddClipRect(GetRect());
 
 				// Draw the image
 				m_DrawBitmap->DrawTrans(Screen->GetBitmap(), m_X, m_Y, 0);
 
-				// Get rid of clipping
-				Screen->GetBitmap()->SetClipRect(0);
+				// Restore the previous clipping
+				Screen->GetBitmap()->SetClipRect(&PrevClip);
 			}
 		} else if (m_DrawType == Panel && m_DrawBackground) {
 			if (m_DrawBitmap) {
@@ -137,6 +169,115 @@ void GUICollectionBox::Draw(GUIScreen *Screen) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GUICollectionBox::PrepareDraw(GUIScreen *Screen) {
+	GUIPanel::PrepareDraw(Screen);
+
+	m_LayerPrepared = m_CacheLayer && UpdateLayer(Screen);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUICollectionBox::UpdateLayer(GUIScreen *Screen) {
+	int LayerWidth = m_Width + 1;
+	int LayerHeight = m_Height + 1;
+	int ColorDepth = Screen->GetBitmap()->GetColorDepth();
+
+	if (m_Layer && (m_Layer->GetBitmap()->GetWidth() != LayerWidth || m_Layer->GetBitmap()->GetHeight() != LayerHeight || m_Layer->GetBitmap()->GetColorDepth() != ColorDepth)) {
+		// Can't resize a layer that's being drawn into, this gets drawn directly until it's done
+		if (m_DrawingLayer) {
+			return false;
+		}
+		ReleaseLayer();
+	}
+	if (!m_Layer) {
+		size_t LayerSize = static_cast<size_t>(LayerWidth) * LayerHeight * ((ColorDepth + 7) / 8);
+		if (LayerSize > s_LayerCacheBudget || !ShrinkLayerCache(s_LayerCacheBudget - LayerSize)) {
+			return false;
+		}
+		m_Layer.reset(Screen->CreateOffscreen(LayerWidth, LayerHeight));
+		if (!m_Layer || !m_Layer->GetBitmap()) {
+			m_Layer.reset();
+			return false;
+		}
+		m_LayerSize = LayerSize;
+		m_LayerValid = false;
+		s_LayerCacheSize += m_LayerSize;
+		s_CachedLayerBoxes.push_back(this);
+	}
+	m_LayerLastDrawn = ++s_LayerDrawCount;
+
+	if (!m_LayerValid) {
+		GUIBitmap *LayerBitmap = m_Layer->GetBitmap();
+		LayerBitmap->SetClipRect(nullptr);
+		LayerBitmap->DrawRectangle(0, 0, LayerWidth, LayerHeight, LayerBitmap->GetColorKey(), true);
+
+		// Set before drawing, so anything invalidated while drawing gets the layer redrawn next time
+		m_LayerValid = true;
+		m_DrawingLayer = true;
+
+		// Draw the box and everything in it at the layer's origin. Anything invalidated meanwhile still marks the right area of the screen dirty
+		int X = m_X;
+		int Y = m_Y;
+		OffsetSubtree(-X, -Y);
+		if (m_Manager) { m_Manager->OffsetDirtyRects(X, Y); }
+		DrawContents(m_Layer.get());
+		if (m_Manager) { m_Manager->OffsetDirtyRects(-X, -Y); }
+		OffsetSubtree(X, Y);
+
+		m_DrawingLayer = false;
+	}
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUICollectionBox::ReleaseLayer() {
+	if (!m_Layer) {
+		return;
+	}
+	m_Layer.reset();
+	s_LayerCacheSize -= m_LayerSize;
+	m_LayerSize = 0;
+	m_LayerValid = false;
+	m_LayerPrepared = false;
+	s_CachedLayerBoxes.erase(std::find(s_CachedLayerBoxes.begin(), s_CachedLayerBoxes.end(), this));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUICollectionBox::SetCacheLayer(bool CacheLayer) {
+	Invalidate();
+
+	m_CacheLayer = CacheLayer;
+	if (!m_CacheLayer) { ReleaseLayer(); }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUICollectionBox::SetLayerCacheBudget(size_t Budget) {
+	s_LayerCacheBudget = Budget;
+	ShrinkLayerCache(s_LayerCacheBudget);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUICollectionBox::ShrinkLayerCache(size_t MaxSize) {
+	// Free the layers that were drawn the longest time ago first
+	while (s_LayerCacheSize > MaxSize) {
+		GUICollectionBox *Oldest = nullptr;
+		for (GUICollectionBox *Box : s_CachedLayerBoxes) {
+			if (!Box->m_DrawingLayer && (!Oldest || Box->m_LayerLastDrawn < Oldest->m_LayerLastDrawn)) { Oldest = Box; }
+		}
+		if (!Oldest) {
+			return false;
+		}
+		Oldest->ReleaseLayer();
+	}
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void GUICollectionBox::OnMouseDown(int X, int Y, int Buttons, int Modifier) {
 	CaptureMouse();
 }
@@ -167,8 +308,11 @@ void GUICollectionBox::Move(int X, int Y) {
 	int DX = X - m_X;
 	int DY = Y - m_Y;
 
+	Invalidate();
 	m_X = X;
 	m_Y = Y;
+	Invalidate();
+	LayoutChanged();
 
 	// Go through all my children moving them
 	std::vector<GUIControl *>::iterator it;
@@ -190,8 +334,11 @@ void GUICollectionBox::Resize(int Width, int Height) {
 	int OldWidth = m_Width;
 	int OldHeight = m_Height;
 
+	Invalidate();
 	m_Width = Width;
 	m_Height = Height;
+	Invalidate();
+	LayoutChanged();
 
 	// Go through all my children moving them
 	std::vector<GUIControl *>::iterator it;
@@ -234,6 +381,8 @@ void GUICollectionBox::GetControlRect(int *X, int *Y, int *Width, int *Height) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::SetDrawImage(GUIBitmap *Bitmap) {
+	Invalidate();
+
 	// Free any old bitmap
 	delete m_DrawBitmap;
 
@@ -243,18 +392,24 @@ void GUICollectionBox::SetDrawImage(GUIBitmap *Bitmap) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::SetDrawBackground(bool DrawBack) {
+	Invalidate();
+
 	m_DrawBackground = DrawBack;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::SetDrawType(int Type) {
+	Invalidate();
+
 	m_DrawType = Type;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUICollectionBox::SetDrawColor(unsigned long Color) {
+	Invalidate();
+
 	m_DrawColor = Color;
 }
 
@@ -264,6 +419,7 @@ void GUICollectionBox::StoreProperties() {
 	m_Properties.AddVariable("DrawBackground", m_DrawBackground);
 	m_Properties.AddVariable("DrawType", m_DrawType == Color ? "Color" : "Image");
 	m_Properties.AddVariable("DrawColor", (int)m_DrawColor);
+	m_Properties.AddVariable("CacheLayer", m_CacheLayer);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -281,4 +437,7 @@ void GUICollectionBox::ApplyProperties(GUIProperties *Props) {
 		m_DrawType = Image;
 	}
 	m_Properties.GetValue("DrawColor", &m_DrawColor);
+	bool CacheLayer = m_CacheLayer;
+	m_Properties.GetValue("CacheLayer", &CacheLayer);
+	SetCacheLayer(CacheLayer);
 }
\ No newline at end of file
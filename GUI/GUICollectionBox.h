@@ -88,6 +88,16 @@ public:
     void Draw(GUIScreen *Screen) override;
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PrepareDraw
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Prepares the contents and brings the cached layer up to date before
+//                  drawing in tiles.
+// Arguments:       Screen class
+
+    void PrepareDraw(GUIScreen *Screen) override;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:  OnMouseDown
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -234,6 +244,60 @@ public:
     unsigned long GetDrawColor() const { return m_DrawColor; }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SetCacheLayer
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets whether the box and everything in it are drawn once into an
+//                  offscreen layer and blitted from there, until something in the box is
+//                  invalidated. Worth it for boxes whose contents rarely change.
+// Arguments:       Whether to cache the layer.
+
+    void SetCacheLayer(bool CacheLayer);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetCacheLayer
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets whether the box and everything in it are drawn from a cached
+//                  offscreen layer.
+// Arguments:       None.
+// Returns:         Whether the layer is cached.
+
+    bool GetCacheLayer() const { return m_CacheLayer; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Static Method:   SetLayerCacheBudget
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets how much memory the cached layers of all boxes may take up
+//                  together. The layers drawn the longest time ago are freed to make
+//                  room, and boxes whose layer doesn't fit are drawn directly.
+// Arguments:       The budget in bytes.
+
+    static void SetLayerCacheBudget(size_t Budget);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Static Method:   GetLayerCacheBudget
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how much memory the cached layers of all boxes may take up
+//                  together.
+// Arguments:       None.
+// Returns:         The budget in bytes.
+
+    static size_t GetLayerCacheBudget() { return s_LayerCacheBudget; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Static Method:   GetLayerCacheSize
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how much memory the cached layers of all boxes take up right now.
+// Arguments:       None.
+// Returns:         The size of all the cached layers in bytes.
+
+    static size_t GetLayerCacheSize() { return s_LayerCacheSize; }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          ApplyProperties
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -243,8 +307,25 @@ public:
     void ApplyProperties(GUIProperties *Props) override;
 
 
+protected:
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          OnSubtreeInvalidated
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Called when the box or anything in it gets invalidated, so the cached
+//                  layer gets redrawn.
+// Arguments:       None.
+
+    void OnSubtreeInvalidated() override { m_LayerValid = false; }
+
+
 private:
 
+	static size_t s_LayerCacheBudget; // How many bytes the cached layers of all boxes may take up.
+	static size_t s_LayerCacheSize; // How many bytes the cached layers of all boxes take up.
+	static std::vector<GUICollectionBox *> s_CachedLayerBoxes; // The boxes that currently have a cached layer.
+	static unsigned long s_LayerDrawCount; // Counts up every time a cached layer is drawn, to tell which was drawn the longest time ago.
+
 	GUIBitmap *m_Background;
 
 	bool m_DrawBackground;
@@ -252,6 +333,56 @@ private:
 	unsigned long m_DrawColor;
 	GUIBitmap *m_DrawBitmap;
 
+	bool m_CacheLayer; // Whether the box and its contents are drawn from m_Layer.
+	std::unique_ptr<GUIScreen> m_Layer; // The offscreen screen the box and its contents get drawn into, with the box's top left corner at 0,0.
+	size_t m_LayerSize; // How many bytes m_Layer's bitmap takes up.
+	bool m_LayerValid; // Whether m_Layer shows what the box and its contents look like now.
+	bool m_DrawingLayer; // Whether m_Layer is being drawn into right now, so it mustn't be freed.
+	bool m_LayerPrepared; // Whether PrepareDraw brought m_Layer up to date, so it gets drawn from when drawing in tiles.
+	unsigned long m_LayerLastDrawn; // The value of s_LayerDrawCount when m_Layer was last drawn.
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawContents
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws the background and the children of the box.
+// Arguments:       Screen class.
+
+    void DrawContents(GUIScreen *Screen);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          UpdateLayer
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Makes sure the cached layer exists, fits in the budget and is up to
+//                  date, redrawing it if it isn't.
+// Arguments:       The screen the layer is going to be drawn onto.
+// Returns:         Whether the layer can be drawn. If not, the box has to be drawn
+//                  directly.
+
+    bool UpdateLayer(GUIScreen *Screen);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ReleaseLayer
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Frees the cached layer, if there is one.
+// Arguments:       None.
+
+    void ReleaseLayer();
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Static Method:   ShrinkLayerCache
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Frees the cached layers that were drawn the longest time ago until
+//                  the rest take up no more than the given size.
+// Arguments:       How many bytes the cached layers may take up afterwards.
+// Returns:         Whether they could be shrunk that far. Layers being drawn into
+//                  can't be freed.
+
+    static bool ShrinkLayerCache(size_t MaxSize);
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          BuildBitmap
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -610,6 +610,8 @@ void GUIComboBoxButton::OnMouseUp(int X, int Y, int Buttons, int Modifier) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIComboBoxButton::SetPushed(bool Pushed) {
+	Invalidate();
+
 	m_Pushed = Pushed;
 }
 
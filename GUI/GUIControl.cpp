@@ -9,8 +9,11 @@ GUIControl::GUIControl() {
 	m_SkinPreset = 1;
 	m_Properties.Clear();
 	m_ControlChildren.clear();
+	m_ChildGridVersion = 0;
+	m_ChildGridDirty = true;
 	m_ControlParent = nullptr;
 	m_IsContainer = false;
+	m_ControlManager = nullptr;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -52,7 +55,7 @@ void GUIControl::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIControl::AddEvent(int Type, int Msg, int Data) {
-	m_ControlManager->AddEvent(new GUIEvent(this, Type, Msg, Data));
+	m_ControlManager->AddEvent(this, Type, Msg, Data);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +98,7 @@ void GUIControl::AddChild(GUIControl *Control) {
 
 	Control->m_ControlParent = this;
 	m_ControlChildren.push_back(Control);
+	m_ChildGridDirty = true;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -105,45 +109,60 @@ std::vector<GUIControl *> * GUIControl::GetChildren() {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+const std::vector<int> & GUIControl::GetChildrenAtPoint(int X, int Y) {
+	// The children's panels are children of this control's panel, so any move or resize of theirs bumps its layout version
+	const GUIPanel *Panel = GetPanel();
+	if (m_ChildGridDirty || !Panel || Panel->GetChildLayoutVersion() != m_ChildGridVersion) {
+		std::vector<GUIRect> ChildRects;
+		ChildRects.reserve(m_ControlChildren.size());
+		for (GUIControl *C : m_ControlChildren) {
+			int ChildX = 0;
+			int ChildY = 0;
+			int ChildWidth = 0;
+			int ChildHeight = 0;
+			C->GetControlRect(&ChildX, &ChildY, &ChildWidth, &ChildHeight);
+			GUIRect ChildRect;
+			SetRect(&ChildRect, ChildX, ChildY, ChildX + ChildWidth, ChildY + ChildHeight);
+			ChildRects.push_back(ChildRect);
+		}
+		m_ChildGrid.Build(ChildRects);
+		m_ChildGridVersion = Panel ? Panel->GetChildLayoutVersion() : 0;
+		m_ChildGridDirty = !Panel;
+	}
+	return m_ChildGrid.GetCandidates(X, Y);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 bool GUIControl::Save(GUIWriter *W) {
-	std::string OutString = "";
-	std::string Name;
+	assert(W);
 
-	// Get the control to store its properties
-	StoreProperties();
+	// Write the same properties a snapshot holds, so there's only one way a control is saved
+	GUIProperties Props(GetName());
+	BuildSnapshot(&Props);
 
 	// Section Header
-	m_Properties.GetValue("Name", &Name);
+	*W << '[' << Props.GetName() << "]\n";
+	Props.Save(W);
 
-	OutString.append("[");
-	OutString.append(Name);
-	OutString.append("]\n");
-
-	// General control values
-	OutString.append("ControlType = ");
-	OutString += m_ControlID;
-	OutString.append("\n");
-
-	// Parent
-	OutString += "Parent = ";
-	if (m_ControlParent) {
-		OutString += m_ControlParent->GetName();
-	} else {
-		OutString += "None";
-	}
-	OutString += "\n";
+	return true;
+}
 
-	// Get the main panel and write its location
-	GUIPanel *Pan = GetPanel();
-	if (Pan) { OutString.append(Pan->ToString()); }
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIControl::BuildSnapshot(GUIProperties *Props) {
+	assert(Props);
+
+	// Get the control to store its properties
+	StoreProperties();
 
-	// Write out the properties
-	OutString.append(m_Properties.ToString());
+	Props->AddVariable("ControlType", m_ControlID);
+	Props->AddVariable("Parent", m_ControlParent ? m_ControlParent->GetName() : "None");
 
-	// Write to the writer class
-	*W << OutString;
+	GUIPanel *Pan = GetPanel();
+	if (Pan) { Pan->BuildProperties(Props); }
 
-	return true;
+	Props->Update(&m_Properties, true);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -244,8 +263,15 @@ GUIProperties * GUIControl::GetProperties() {
 void GUIControl::ApplyProperties(GUIProperties *Props) {
 	assert(Props);
 
+	std::string OldName = GetName();
 	m_Properties.Update(Props);
 
+	// Keep the manager's name lookup in sync if the Name property was changed
+	if (m_ControlManager && GetName() != OldName) { m_ControlManager->ControlRenamed(this, OldName); }
+
+	// Any property may change how the control looks
+	if (GetPanel()) { GetPanel()->Invalidate(); }
+
 	int X, Y;
 	int Width, Height;
 	bool Enabled;
@@ -292,6 +318,7 @@ void GUIControl::RemoveChild(const std::string Name) {
 		GUIControl *C = *it;
 		if (C && C->GetName().compare(Name) == 0) {
 			m_ControlChildren.erase(it);
+			m_ChildGridDirty = true;
 			break;
 		}
 	}
@@ -310,4 +337,5 @@ void GUIControl::RemoveChildren() {
 	}
 
 	m_ControlChildren.clear();
+	m_ChildGridDirty = true;
 }
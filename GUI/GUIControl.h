@@ -150,6 +150,17 @@ public:
     std::vector<GUIControl *> * GetChildren();
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetChildrenAtPoint
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the children whose control rectangle may contain a point. Rebuilds
+//                  the child grid if the children were added, removed or moved since.
+// Arguments:       Point.
+// Returns:         Indices into the children list, in ascending order.
+
+    const std::vector<int> & GetChildrenAtPoint(int X, int Y);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual Method:    GetPanel
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -170,6 +181,16 @@ public:
     bool Save(GUIWriter *W);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          BuildSnapshot
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Copies everything Save writes for this control into a properties
+//                  class, in the same order, so it can be written out later.
+// Arguments:       Properties class to add to. Should be named after this control.
+
+    void BuildSnapshot(GUIProperties *Props);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual Method:    StoreProperties
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -303,6 +324,10 @@ protected:
     GUIControl *m_ControlParent;
     std::vector<GUIControl *> m_ControlChildren;
 
+    GUIHitGrid m_ChildGrid; // Grid over the children control rectangles for hit testing
+    unsigned int m_ChildGridVersion; // Panel child layout version the grid was built at
+    bool m_ChildGridDirty; // The children list changed since the grid was built
+
     std::string m_ControlID;
 
     bool m_IsContainer;
@@ -1,7 +1,89 @@
 #include "GUI.h"
 
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GUI_LAYOUT_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 using namespace RTE;
 
+namespace {
+	// The compiled layout format. The file is the header, StringCount + 1 string offsets, the control records, the property records and then the string data, all 32 bit little-endian.
+	// String i is the bytes from offset i to offset i + 1 of the string data. Properties of a control are stored in order, so the loaded control is the same as the one saved.
+	// Parents are also stored as control indices, so loading links each control to its parent without looking the "Parent" property up by name.
+	// The first byte can't start a text layout, so a file starting with the magic is never mistaken for one.
+	const char c_BinaryLayoutMagic[4] = { '\x89', 'G', 'U', 'L' };
+	const uint32_t c_BinaryLayoutVersion = 3;
+
+	struct BinaryLayoutHeader {
+		char Magic[4];
+		uint32_t Version;
+		uint32_t StringCount;
+		uint32_t StringDataSize;
+		uint32_t ControlCount;
+		uint32_t PropertyCount;
+	};
+
+	struct BinaryLayoutControl {
+		uint32_t Name; // String index of the control name.
+		int32_t Parent; // Index of the parent control, -1 if it has none in this file.
+		uint32_t FirstProperty; // Index of the control's first property record.
+		uint32_t PropertyCount;
+	};
+
+	struct BinaryLayoutProperty {
+		uint32_t Name; // String index of the property name.
+		uint32_t Value; // String index of the property value.
+	};
+
+	// Finds where a layout line ends, at a newline, a tab or a line comment, 16 characters at a time where SSE2 is available since most of a layout is spent in here
+	size_t FindLayoutLineEnd(std::string_view Data, size_t Pos) {
+		const size_t Size = Data.size();
+		while (Pos < Size) {
+#ifdef GUI_LAYOUT_SSE2
+			const __m128i Newline = _mm_set1_epi8('\n');
+			const __m128i Return = _mm_set1_epi8('\r');
+			const __m128i Tab = _mm_set1_epi8('\t');
+			const __m128i Slash = _mm_set1_epi8('/');
+			// Skip 16 characters at a time while none of them can end the line, then move to the first one that can
+			while (Pos + 16 <= Size) {
+				__m128i Chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Data.data() + Pos));
+				__m128i LineBreaks = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chars, Newline), _mm_cmpeq_epi8(Chars, Return)), _mm_or_si128(_mm_cmpeq_epi8(Chars, Tab), _mm_cmpeq_epi8(Chars, Slash)));
+				int LineBreakMask = _mm_movemask_epi8(LineBreaks);
+				if (LineBreakMask != 0) {
+#ifdef _MSC_VER
+					unsigned long FirstBreak;
+					_BitScanForward(&FirstBreak, static_cast<unsigned long>(LineBreakMask));
+					Pos += FirstBreak;
+#else
+					Pos += static_cast<size_t>(__builtin_ctz(static_cast<unsigned int>(LineBreakMask)));
+#endif
+					break;
+				}
+				Pos += 16;
+			}
+#endif
+			char Char = Data[Pos];
+			if (Char == '\n' || Char == '\r' || Char == '\t' || (Char == '/' && Pos + 1 < Size && Data[Pos + 1] == '/')) {
+				return Pos;
+			}
+			Pos++;
+		}
+		return Size;
+	}
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GUIControlManager::GUIControlManager() {
@@ -10,7 +92,10 @@ GUIControlManager::GUIControlManager() {
 	m_Skin = nullptr;
 	m_GUIManager = nullptr;
 	m_ControlList.clear();
-	m_EventQueue.clear();
+	m_ControlMap.clear();
+	m_EventQueueHead = 0;
+	m_EventQueueCount = 0;
+	m_DroppedEventCount = 0;
 
 	m_CursorType = Pointer;
 }
@@ -69,25 +154,26 @@ void GUIControlManager::Destroy() {
 void GUIControlManager::Clear() {
 	std::vector<GUIControl *>::iterator it;
 
+	// The areas the controls covered need to be repainted without them. Done before deleting any, since invalidating a control reaches up to its parents
+	for (it = m_ControlList.begin(); it != m_ControlList.end(); it++) {
+		if ((*it)->GetPanel()) { (*it)->GetPanel()->Invalidate(); }
+	}
+
 	// Destroy every control
 	for (it = m_ControlList.begin(); it != m_ControlList.end(); it++) {
 		GUIControl *C = *it;
-
 		C->Destroy();
 		delete C;
 	}
 
 	m_ControlList.clear();
+	m_ControlMap.clear();
 
 	m_GUIManager->Clear();
 
-	// Destroy the event queue
-	std::vector<GUIEvent *>::iterator ite;
-	for (ite = m_EventQueue.begin(); ite != m_EventQueue.end(); ite++) {
-		GUIEvent *E = *ite;
-		if (E) { delete E; }
-	}
-	m_EventQueue.clear();
+	// Empty the event queue
+	m_EventQueueHead = 0;
+	m_EventQueueCount = 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -135,6 +221,7 @@ GUIControl * GUIControlManager::AddControl(const std::string &Name, const std::s
 	}
 	// Add the control to the list
 	m_ControlList.push_back(Control);
+	m_ControlMap.try_emplace(Control->GetName(), Control);
 
 	// Ready
 	Control->Activate();
@@ -144,7 +231,7 @@ GUIControl * GUIControlManager::AddControl(const std::string &Name, const std::s
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-GUIControl * GUIControlManager::AddControl(GUIProperties *Property) {
+GUIControl * GUIControlManager::AddControl(GUIProperties *Property, GUIControl *Parent) {
 	assert(Property);
 
 	// Get the control type and name
@@ -166,13 +253,15 @@ GUIControl * GUIControlManager::AddControl(GUIProperties *Property) {
 	Control->Create(Property);
 	Control->ChangeSkin(m_Skin);
 
-	// Get the parent control
-	std::string Parent;
-	Property->GetValue("Parent", &Parent);
-
-	GUIControl *Par = GetControl(Parent);
+	// Get the parent control, unless the caller already knows it
+	GUIControl *Par = Parent;
+	if (!Par) {
+		std::string ParentName;
+		Property->GetValue("Parent", &ParentName);
+		if (ParentName.compare("None") != 0) { Par = GetControl(ParentName); }
+	}
 	GUIPanel *Pan = nullptr;
-	if (Par && Parent.compare("None") != 0) {
+	if (Par) {
 		Pan = Par->GetPanel();
 		Par->AddChild(Control);
 	}
@@ -185,6 +274,7 @@ GUIControl * GUIControlManager::AddControl(GUIProperties *Property) {
 
 	// Add the control to the list
 	m_ControlList.push_back(Control);
+	m_ControlMap.try_emplace(Control->GetName(), Control);
 
 	// Ready
 	Control->Activate();
@@ -195,17 +285,13 @@ GUIControl * GUIControlManager::AddControl(GUIProperties *Property) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GUIControl * GUIControlManager::GetControl(const std::string &Name) {
-	std::vector<GUIControl *>::iterator it;
-
-	for (it = m_ControlList.begin(); it != m_ControlList.end(); it++) {
-		GUIControl *C = *it;
-		if (C->GetName().compare(Name) == 0) {
-			return C;
-		}
-	}
+	std::unordered_map<std::string, GUIControl *>::const_iterator it = m_ControlMap.find(Name);
 
 	// Not found
-	return nullptr;
+	if (it == m_ControlMap.end()) {
+		return nullptr;
+	}
+	return it->second;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -240,16 +326,18 @@ GUIControl * GUIControlManager::GetControlUnderPoint(int pointX, int pointY, GUI
 
 	// Check children
 	std::vector<GUIControl *> *List = pParent->GetChildren();
-	std::vector<GUIControl *>::reverse_iterator it;
 
 	assert(List);
 
 	// Control the depth. If negative, it'll go forever
 	if (depth != 0) {
-		for (it = List->rbegin(); it != List->rend(); it++) {
+		// Only the children whose grid cell holds the point can contain it. Check in reverse because the top most control is last in the list
+		const std::vector<int> &Candidates = pParent->GetChildrenAtPoint(pointX, pointY);
+		for (std::vector<int>::const_reverse_iterator it = Candidates.rbegin(); it != Candidates.rend(); it++) {
+			GUIControl *Child = (*List)[*it];
 			// Only check visible controls
-			if ((*it)->GetVisible()) {
-				GUIControl *C = GetControlUnderPoint(pointX, pointY, *it, depth - 1);
+			if (Child->GetVisible()) {
+				GUIControl *C = GetControlUnderPoint(pointX, pointY, Child, depth - 1);
 				if (C) {
 					return C;
 				}
@@ -266,32 +354,32 @@ GUIControl * GUIControlManager::GetControlUnderPoint(int pointX, int pointY, GUI
 void GUIControlManager::RemoveControl(const std::string &Name, bool RemoveFromParent) {
 	// NOTE: We can't simply remove it because some controls need to remove extra panels and it's silly to add 'remove' to every control to remove their extra panels (ie. Combobox).
 	// Signals and stuff are also linked in so we just remove the controls from the list and not from memory.
-	std::vector<GUIControl *>::iterator it;
-
-	for (it = m_ControlList.begin(); it != m_ControlList.end(); it++) {
-		GUIControl *C = *it;
-		if (C->GetName().compare(Name) == 0) {
-
-			// Just remove it from the list
-			C->SetVisible(false);
-			m_ControlList.erase(it);
+	std::unordered_map<std::string, GUIControl *>::iterator mapIt = m_ControlMap.find(Name);
+	if (mapIt == m_ControlMap.end()) {
+		return;
+	}
+	GUIControl *C = mapIt->second;
 
-			// Remove all my children
-			C->RemoveChildren();
+	// Just remove it from the list
+	C->SetVisible(false);
+	std::vector<GUIControl *>::iterator it = std::find(m_ControlList.begin(), m_ControlList.end(), C);
+	if (it != m_ControlList.end()) { m_ControlList.erase(it); }
+	// Another control may have the same name, in which case it takes over the name
+	IndexControlName(Name);
 
-			// Remove me from my parent
-			if (C->GetParent() && RemoveFromParent) { C->GetParent()->RemoveChild(Name); }
+	// Remove all my children
+	C->RemoveChildren();
 
-			break;
-		}
-	}
+	// Remove me from my parent
+	if (C->GetParent() && RemoveFromParent) { C->GetParent()->RemoveChild(Name); }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIControlManager::Update(bool ignoreKeyboardEvents) {
 	// Clear the event queue
-	m_EventQueue.clear();
+	m_EventQueueHead = 0;
+	m_EventQueueCount = 0;
 
 	// Process the manager
 	m_GUIManager->Update(ignoreKeyboardEvents);
@@ -340,15 +428,12 @@ void GUIControlManager::DrawMouse() {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool GUIControlManager::GetEvent(GUIEvent *Event) {
-	if (Event && !m_EventQueue.empty()) {
-
-		// Copy the event
-		*Event = *m_EventQueue.back();
+	if (Event && m_EventQueueCount > 0) {
+		// Copy out the oldest event so they come out in the order they were added
+		*Event = m_EventQueue[m_EventQueueHead];
 
-		// Free the event
-		if (GUIEvent *ptr = m_EventQueue.at(m_EventQueue.size() - 1)) { delete ptr; }
-
-		m_EventQueue.pop_back();
+		m_EventQueueHead = (m_EventQueueHead + 1) % c_EventQueueCapacity;
+		m_EventQueueCount--;
 		return true;
 	}
 	// Empty queue OR null Event pointer
@@ -357,9 +442,36 @@ bool GUIControlManager::GetEvent(GUIEvent *Event) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void GUIControlManager::AddEvent(GUIEvent *Event) {
-	// Add the event to the queue
-	if (Event) { m_EventQueue.push_back(Event); }
+void GUIControlManager::AddEvent(GUIControl *Control, int Type, int Msg, int Data) {
+	if (m_EventQueueCount == c_EventQueueCapacity) {
+		m_DroppedEventCount++;
+		return;
+	}
+	// Add the event to the back of the queue
+	m_EventQueue[(m_EventQueueHead + m_EventQueueCount) % c_EventQueueCapacity] = GUIEvent(Control, Type, Msg, Data);
+	m_EventQueueCount++;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIControlManager::ControlRenamed(GUIControl *Control, const std::string &OldName) {
+	assert(Control);
+
+	// Other controls may share either name, so both get looked up again rather than just moving this control's entry
+	IndexControlName(OldName);
+	IndexControlName(Control->GetName());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIControlManager::IndexControlName(const std::string &Name) {
+	// GetControl finds the first control in the list with a name, so that's the one the name maps to
+	std::vector<GUIControl *>::iterator it = std::find_if(m_ControlList.begin(), m_ControlList.end(), [&Name](GUIControl *C) { return C->GetName() == Name; });
+	if (it != m_ControlList.end()) {
+		m_ControlMap.insert_or_assign(Name, *it);
+	} else {
+		m_ControlMap.erase(Name);
+	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -377,9 +489,7 @@ bool GUIControlManager::Save(const std::string &Filename) {
 	}
 	bool Result = Save(&W);
 
-	W.EndWrite();
-
-	return Result;
+	return W.EndWrite() && Result;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -387,74 +497,439 @@ bool GUIControlManager::Save(const std::string &Filename) {
 bool GUIControlManager::Save(GUIWriter *W) {
 	assert(W);
 
-	// Go through each control
-	std::vector<GUIControl *>::iterator it;
+	std::vector<GUIProperties> Snapshot;
+	GetSnapshot(&Snapshot);
+	return SaveSnapshot(Snapshot, W);
+}
 
-	for (it = m_ControlList.begin(); it != m_ControlList.end(); it++) {
-		GUIControl *C = *it;
-		C->Save(W);
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIControlManager::GetSnapshot(std::vector<GUIProperties> *Snapshot) {
+	assert(Snapshot);
+
+	Snapshot->clear();
+	Snapshot->reserve(m_ControlList.size());
+	for (GUIControl *C : m_ControlList) {
+		C->BuildSnapshot(&Snapshot->emplace_back(C->GetName()));
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::SaveSnapshot(const std::vector<GUIProperties> &Snapshot, const std::string &Filename) {
+	std::string TempFilename = Filename + ".tmp";
+	GUIWriter W;
+	if (W.Create(TempFilename) != 0) {
+		return false;
+	}
+	bool Written = SaveSnapshot(Snapshot, &W);
+	Written = W.EndWrite() && Written;
+
+	return ReplaceWithTempFile(TempFilename, Filename, Written);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::SaveSnapshot(const std::vector<GUIProperties> &Snapshot, GUIWriter *W) {
+	assert(W);
+
+	for (const GUIProperties &Prop : Snapshot) {
+		*W << '[' << Prop.GetName() << "]\n";
+		Prop.Save(W);
 		// Separate controls by one line
 		W->NewLine();
 	}
+	return W->WriterOK();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::SaveBinary(const std::string &Filename) {
+	std::vector<GUIProperties> Snapshot;
+	GetSnapshot(&Snapshot);
+	return SaveBinarySnapshot(Snapshot, Filename);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::SaveBinarySnapshot(const std::vector<GUIProperties> &Snapshot, const std::string &Filename) {
+	// Every name and value goes into the string table once, however many controls use it
+	std::vector<std::string> StringList;
+	std::unordered_map<std::string, uint32_t> StringIndices;
+	auto AddString = [&StringList, &StringIndices](const std::string &String) {
+		std::pair<std::unordered_map<std::string, uint32_t>::iterator, bool> Result = StringIndices.try_emplace(String, static_cast<uint32_t>(StringList.size()));
+		if (Result.second) { StringList.push_back(String); }
+		return Result.first->second;
+	};
+
+	// Parent names are also stored as control indices. A repeated name refers to its first control, same as GetControl after loading
+	std::unordered_map<std::string, int32_t> ControlIndices;
+	for (int32_t Index = 0; Index < static_cast<int32_t>(Snapshot.size()); Index++) {
+		ControlIndices.try_emplace(Snapshot[Index].GetName(), Index);
+	}
+
+	std::vector<BinaryLayoutControl> ControlRecords;
+	std::vector<BinaryLayoutProperty> PropertyRecords;
+	ControlRecords.reserve(Snapshot.size());
+	for (const GUIProperties &Prop : Snapshot) {
+		BinaryLayoutControl Control;
+		Control.Name = AddString(Prop.GetName());
+		Control.Parent = -1;
+		Control.FirstProperty = static_cast<uint32_t>(PropertyRecords.size());
+		Control.PropertyCount = static_cast<uint32_t>(Prop.GetCount());
+
+		std::string Name;
+		std::string Value;
+		for (int Index = 0; Index < Prop.GetCount(); Index++) {
+			Prop.GetVariable(Index, &Name, &Value);
+			PropertyRecords.push_back({ AddString(Name), AddString(Value) });
+			if (Name == "Parent") {
+				std::unordered_map<std::string, int32_t>::const_iterator ParentEntry = ControlIndices.find(Value);
+				if (ParentEntry != ControlIndices.end()) { Control.Parent = ParentEntry->second; }
+			}
+		}
+		ControlRecords.push_back(Control);
+	}
+
+	std::vector<uint32_t> StringOffsets;
+	StringOffsets.reserve(StringList.size() + 1);
+	uint32_t StringDataSize = 0;
+	for (const std::string &String : StringList) {
+		StringOffsets.push_back(StringDataSize);
+		StringDataSize += static_cast<uint32_t>(String.size());
+	}
+	StringOffsets.push_back(StringDataSize);
+
+	BinaryLayoutHeader Header;
+	std::memcpy(Header.Magic, c_BinaryLayoutMagic, sizeof(Header.Magic));
+	Header.Version = c_BinaryLayoutVersion;
+	Header.StringCount = static_cast<uint32_t>(StringList.size());
+	Header.StringDataSize = StringDataSize;
+	Header.ControlCount = static_cast<uint32_t>(ControlRecords.size());
+	Header.PropertyCount = static_cast<uint32_t>(PropertyRecords.size());
+
+	std::string OutData;
+	OutData.reserve(sizeof(Header) + StringOffsets.size() * sizeof(uint32_t) + ControlRecords.size() * sizeof(BinaryLayoutControl) + PropertyRecords.size() * sizeof(BinaryLayoutProperty) + StringDataSize);
+	OutData.append(reinterpret_cast<const char *>(&Header), sizeof(Header));
+	OutData.append(reinterpret_cast<const char *>(StringOffsets.data()), StringOffsets.size() * sizeof(uint32_t));
+	OutData.append(reinterpret_cast<const char *>(ControlRecords.data()), ControlRecords.size() * sizeof(BinaryLayoutControl));
+	OutData.append(reinterpret_cast<const char *>(PropertyRecords.data()), PropertyRecords.size() * sizeof(BinaryLayoutProperty));
+	for (const std::string &String : StringList) {
+		OutData.append(String);
+	}
+	return WriteFileAtomic(Filename, OutData, true);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::WriteFileAtomic(const std::string &Filename, std::string_view Data, bool Binary) {
+	std::string TempFilename = Filename + ".tmp";
+	FILE *File = std::fopen(TempFilename.c_str(), Binary ? "wb" : "w");
+	if (!File) {
+		return false;
+	}
+	bool Written = std::fwrite(Data.data(), 1, Data.size(), File) == Data.size();
+	Written = std::fclose(File) == 0 && Written;
+
+	return ReplaceWithTempFile(TempFilename, Filename, Written);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::ReplaceWithTempFile(const std::string &TempFilename, const std::string &Filename, bool Written) {
+	// The data has to be on disk before the rename, otherwise a crash right after could leave the target empty
+	if (Written) {
+		FILE *File = std::fopen(TempFilename.c_str(), "ab");
+#ifdef _WIN32
+		Written = File && _commit(_fileno(File)) == 0;
+#else
+		Written = File && fsync(fileno(File)) == 0;
+#endif
+		if (File) { Written = std::fclose(File) == 0 && Written; }
+	}
 
+	std::error_code ErrorCode;
+	if (Written) { std::filesystem::rename(TempFilename, Filename, ErrorCode); }
+	if (!Written || ErrorCode) {
+		std::filesystem::remove(TempFilename, ErrorCode);
+		return false;
+	}
 	return true;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool GUIControlManager::Load(const std::string &Filename, bool keepOld) {
-	GUIReader reader;
-	if (reader.Create(Filename.c_str()) != 0) {
+bool GUIControlManager::Load(const std::string &Filename, bool keepOld, std::vector<std::string> *ProblemList) {
+	std::deque<GUIProperties> ControlList;
+	std::vector<int32_t> ParentList;
+	if (!ParseLayout(Filename, ControlList, ProblemList, &ParentList)) {
 		return false;
 	}
 
 	// Clear the current layout, IF directed to
 	if (!keepOld) { Clear(); }
 
-	std::vector<GUIProperties *> ControlList;
-	ControlList.clear();
+	// Go through each control item and create it
+	AddControls(ControlList, ParentList, [](GUIProperties &) { return true; });
 
-	GUIProperties *CurProp = nullptr;
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	while (!reader.GetStream()->eof()) {
-		std::string line = reader.ReadLine();
+bool GUIControlManager::LoadFiles(const std::vector<std::string> &FileList, bool keepOld, std::vector<std::string> *ProblemList) {
+	std::vector<std::deque<GUIProperties>> ParsedFiles(FileList.size());
+	std::vector<std::vector<int32_t>> ParsedParents(FileList.size());
+	std::unique_ptr<bool[]> ParseResults = std::make_unique<bool[]>(FileList.size());
+	std::vector<std::vector<std::string>> ParseProblems(FileList.size());
+
+	// Parsing only touches each file's own section list, so a few threads can take the files in turn
+	std::atomic<size_t> NextFile = 0;
+	auto ParseFiles = [&FileList, &ParsedFiles, &ParsedParents, &ParseResults, &ParseProblems, &NextFile]() {
+		for (size_t FileIndex = NextFile++; FileIndex < FileList.size(); FileIndex = NextFile++) {
+			ParseResults[FileIndex] = ParseLayout(FileList[FileIndex], ParsedFiles[FileIndex], &ParseProblems[FileIndex], &ParsedParents[FileIndex]);
+		}
+	};
+	size_t ThreadCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), FileList.size());
+	std::vector<std::thread> ParseThreads;
+	for (size_t ThreadIndex = 1; ThreadIndex < ThreadCount; ThreadIndex++) {
+		ParseThreads.emplace_back(ParseFiles);
+	}
+	// This thread does its share instead of waiting idle
+	ParseFiles();
+	for (std::thread &ParseThread : ParseThreads) {
+		ParseThread.join();
+	}
+
+	// Leave the current layout alone if there is nothing to replace it with, same as Load
+	if (std::none_of(ParseResults.get(), ParseResults.get() + FileList.size(), [](bool ParseResult) { return ParseResult; })) {
+		if (ProblemList) {
+			for (const std::string &Filename : FileList) { ProblemList->push_back(Filename + ": The file could not be read."); }
+		}
+		return false;
+	}
+
+	// Clear the current layout, IF directed to
+	if (!keepOld) { Clear(); }
 
-		if (line.empty()) {
+	// Controls are created in file order, so which file wins a name collision doesn't depend on which thread finished first
+	bool AllRead = true;
+	std::string Name;
+	for (size_t FileIndex = 0; FileIndex < FileList.size(); FileIndex++) {
+		if (ProblemList) { ProblemList->insert(ProblemList->end(), ParseProblems[FileIndex].begin(), ParseProblems[FileIndex].end()); }
+		if (!ParseResults[FileIndex]) {
+			AllRead = false;
+			if (ProblemList) { ProblemList->push_back(FileList[FileIndex] + ": The file could not be read."); }
 			continue;
 		}
+		AddControls(ParsedFiles[FileIndex], ParsedParents[FileIndex], [this, &Name, &FileName = FileList[FileIndex], ProblemList](GUIProperties &Prop) {
+			Prop.GetValue("Name", &Name);
+			if (GetControl(Name)) {
+				if (ProblemList) { ProblemList->push_back(FileName + ": A control named \"" + Name + "\" already exists, skipped it."); }
+				return false;
+			}
+			return true;
+		});
+	}
+	return AllRead;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-		// Is the line a section?
-		if (line.front() == '[' && line.back() == ']') {
-			GUIProperties *p = new GUIProperties(line.substr(1, line.size() - 2));
-			CurProp = p;
-			ControlList.push_back(p);
+void GUIControlManager::AddControls(std::deque<GUIProperties> &ControlList, const std::vector<int32_t> &ParentList, const std::function<bool(GUIProperties &)> &ShouldAdd) {
+	// Compiled layouts come with the index of each control's parent, so the parent is the control created for that section. Text layouts, parents
+	// that aren't in the file or weren't created here are looked up by name
+	std::vector<GUIControl *> CreatedControls(ParentList.empty() ? 0 : ControlList.size(), nullptr);
+	for (size_t Index = 0; Index < ControlList.size(); Index++) {
+		GUIProperties &Prop = ControlList[Index];
+		if (!ShouldAdd(Prop)) {
 			continue;
 		}
+		GUIControl *Parent = nullptr;
+		if (!ParentList.empty() && ParentList[Index] >= 0 && static_cast<size_t>(ParentList[Index]) < Index) { Parent = CreatedControls[ParentList[Index]]; }
+		GUIControl *Control = AddControl(&Prop, Parent);
+		if (!CreatedControls.empty()) { CreatedControls[Index] = Control; }
+	}
+}
 
-		// Is the line a valid property?
-		size_t Position = line.find_first_of('=');
-		if (Position != std::string::npos) {
-			// Break the line into variable & value, but only add a property if it belongs to a section
-			if (CurProp) {
-				// Grab the variable & value strings and trim them
-				std::string Name = reader.TrimString(line.substr(0, Position));
-				std::string Value = reader.TrimString(line.substr(Position + 1, std::string::npos));
-
-				// Add it to the current property
-				CurProp->AddVariable(Name, Value);
-			}
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::ParseLayout(const std::string &Filename, std::deque<GUIProperties> &SectionList, std::vector<std::string> *ProblemList, std::vector<int32_t> *ParentList) {
+	std::ifstream File(Filename, std::ios::binary);
+	if (!File.good()) {
+		return false;
+	}
+	File.seekg(0, std::ios::end);
+	std::streamoff FileSize = File.tellg();
+	File.seekg(0, std::ios::beg);
+	if (FileSize < 0) {
+		return false;
+	}
+	std::string Buffer(static_cast<size_t>(FileSize), '\0');
+	if (!File.read(Buffer.data(), FileSize)) {
+		return false;
+	}
+
+	if (Buffer.size() >= sizeof(BinaryLayoutHeader::Magic) && std::memcmp(Buffer.data(), c_BinaryLayoutMagic, sizeof(BinaryLayoutHeader::Magic)) == 0) {
+		return ParseBinaryLayout(Buffer, SectionList, ParentList);
+	}
+	ParseTextLayout(Buffer, Filename, SectionList, ProblemList);
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::ReadLayoutLine(std::string_view Data, size_t &Pos, int &LineNumber, LayoutLine &Line) {
+	const size_t Size = Data.size();
+
+	while (Pos < Size) {
+		// Skip whitespace, newlines and comments like GUIReader::DiscardEmptySpace
+		char Char = Data[Pos];
+		if (Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r') {
+			if (Char == '\n') { LineNumber++; }
+			Pos++;
 			continue;
 		}
+		if (Char == '/' && Pos + 1 < Size && Data[Pos + 1] == '/') {
+			Pos = Data.find_first_of("\n\r", Pos + 2);
+			if (Pos == std::string_view::npos) { Pos = Size; }
+			continue;
+		}
+		if (Char == '/' && Pos + 1 < Size && Data[Pos + 1] == '*') {
+			// The '*' that opens the comment can also close it, same as GUIReader
+			size_t CommentEnd = Data.find("*/", Pos + 1);
+			CommentEnd = (CommentEnd == std::string_view::npos) ? Size : CommentEnd + 2;
+			LineNumber += static_cast<int>(std::count(Data.begin() + Pos, Data.begin() + CommentEnd, '\n'));
+			Pos = CommentEnd;
+			continue;
+		}
+
+		// The line runs up to a newline, a tab or a line comment. It starts on a non-space, so only the end needs trimming, same as GUIReader::TrimString
+		size_t LineStart = Pos;
+		size_t LineEnd = FindLayoutLineEnd(Data, Pos);
+		Pos = LineEnd;
+		while (Data[LineEnd - 1] == ' ') {
+			LineEnd--;
+		}
+		std::string_view Text(Data.data() + LineStart, LineEnd - LineStart);
+
+		Line.LineNumber = LineNumber;
+		Line.Value = std::string_view();
+		if (Text.front() == '[' && Text.back() == ']') {
+			Line.Type = LayoutLine::Section;
+			Line.Name = Text.substr(1, Text.size() - 2);
+			return true;
+		}
+		size_t Position = Text.find('=');
+		if (Position == std::string_view::npos) {
+			Line.Type = LayoutLine::Invalid;
+			Line.Name = Text;
+			return true;
+		}
+		// Trim the spaces around the '=' off the name and the value
+		size_t NameEnd = Position;
+		while (NameEnd > 0 && Text[NameEnd - 1] == ' ') {
+			NameEnd--;
+		}
+		size_t ValueStart = Position + 1;
+		while (ValueStart < Text.size() && Text[ValueStart] == ' ') {
+			ValueStart++;
+		}
+		Line.Type = LayoutLine::Property;
+		Line.Name = Text.substr(0, NameEnd);
+		Line.Value = Text.substr(ValueStart);
+		return true;
 	}
+	return false;
+}
 
-	// Go through each control item and create it
-	std::vector<GUIProperties *>::iterator it;
-	for (it = ControlList.begin(); it != ControlList.end(); it++) {
-		GUIProperties *Prop = *it;
-		AddControl(Prop);
-		// Free the property class
-		delete Prop;
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIControlManager::ParseTextLayout(std::string_view Data, const std::string &Filename, std::deque<GUIProperties> &SectionList, std::vector<std::string> *ProblemList) {
+	size_t Pos = 0;
+	// Lines are counted on '\n' only, same as GUIReader, so CRLF files aren't counted twice
+	int LineNumber = 1;
+	LayoutLine Line;
+	GUIProperties *CurProp = nullptr;
+
+	while (ReadLayoutLine(Data, Pos, LineNumber, Line)) {
+		if (Line.Type == LayoutLine::Section) {
+			CurProp = &SectionList.emplace_back(std::string(Line.Name));
+		} else if (Line.Type == LayoutLine::Invalid) {
+			if (ProblemList) { ProblemList->push_back(Filename + ": Line " + std::to_string(Line.LineNumber) + " is neither a section nor a property, skipped it."); }
+		} else if (!CurProp) {
+			// Only add properties that belong to a section
+			if (ProblemList) { ProblemList->push_back(Filename + ": Line " + std::to_string(Line.LineNumber) + " has a property outside of any section, skipped it."); }
+		} else {
+			CurProp->AddVariable(Line.Name, Line.Value);
+		}
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::ParseBinaryLayout(std::string_view Data, std::deque<GUIProperties> &SectionList, std::vector<int32_t> *ParentList) {
+	BinaryLayoutHeader Header;
+	if (Data.size() < sizeof(Header)) {
+		return false;
+	}
+	std::memcpy(&Header, Data.data(), sizeof(Header));
+	if (std::memcmp(Header.Magic, c_BinaryLayoutMagic, sizeof(Header.Magic)) != 0 || Header.Version != c_BinaryLayoutVersion) {
+		return false;
+	}
+
+	// Check the tables fit in the data before pointing into it. Sizes are added up in 64 bits so bad counts can't wrap around
+	uint64_t OffsetsStart = sizeof(Header);
+	uint64_t ControlsStart = OffsetsStart + (static_cast<uint64_t>(Header.StringCount) + 1) * sizeof(uint32_t);
+	uint64_t PropertiesStart = ControlsStart + static_cast<uint64_t>(Header.ControlCount) * sizeof(BinaryLayoutControl);
+	uint64_t StringDataStart = PropertiesStart + static_cast<uint64_t>(Header.PropertyCount) * sizeof(BinaryLayoutProperty);
+	if (StringDataStart + Header.StringDataSize != Data.size()) {
+		return false;
+	}
+
+	// Every table starts at a multiple of 4 bytes from the start of the file, so they can be used in place
+	const uint32_t *StringOffsets = reinterpret_cast<const uint32_t *>(Data.data() + OffsetsStart);
+	const BinaryLayoutControl *Controls = reinterpret_cast<const BinaryLayoutControl *>(Data.data() + ControlsStart);
+	const BinaryLayoutProperty *Properties = reinterpret_cast<const BinaryLayoutProperty *>(Data.data() + PropertiesStart);
+	const std::string_view StringData = Data.substr(StringDataStart);
+
+	for (uint32_t Index = 0; Index < Header.StringCount; Index++) {
+		if (StringOffsets[Index] > StringOffsets[Index + 1] || StringOffsets[Index + 1] > Header.StringDataSize) {
+			return false;
+		}
 	}
+	auto GetString = [StringOffsets, &StringData](uint32_t Index) { return StringData.substr(StringOffsets[Index], StringOffsets[Index + 1] - StringOffsets[Index]); };
 
+	for (uint32_t ControlIndex = 0; ControlIndex < Header.ControlCount; ControlIndex++) {
+		const BinaryLayoutControl &Control = Controls[ControlIndex];
+		if (Control.Name >= Header.StringCount || Control.Parent < -1 || Control.Parent >= static_cast<int32_t>(Header.ControlCount) || Control.FirstProperty > Header.PropertyCount || Control.PropertyCount > Header.PropertyCount - Control.FirstProperty) {
+			return false;
+		}
+		if (ParentList) { ParentList->push_back(Control.Parent); }
+		GUIProperties &Prop = SectionList.emplace_back(std::string(GetString(Control.Name)));
+		for (uint32_t PropertyIndex = Control.FirstProperty; PropertyIndex < Control.FirstProperty + Control.PropertyCount; PropertyIndex++) {
+			const BinaryLayoutProperty &Property = Properties[PropertyIndex];
+			if (Property.Name >= Header.StringCount || Property.Value >= Header.StringCount) {
+				return false;
+			}
+			Prop.AddVariable(GetString(Property.Name), GetString(Property.Value));
+		}
+	}
 	return true;
-}
\ No newline at end of file
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIControlManager::ConvertLayout(const std::string &SourceFilename, const std::string &DestFilename) {
+	std::ifstream Source(SourceFilename, std::ios::binary);
+	char Magic[sizeof(BinaryLayoutHeader::Magic)] = {};
+	bool SourceIsBinary = Source.read(Magic, sizeof(Magic)) && std::memcmp(Magic, c_BinaryLayoutMagic, sizeof(Magic)) == 0;
+	Source.close();
+
+	std::deque<GUIProperties> SectionList;
+	if (!ParseLayout(SourceFilename, SectionList)) {
+		return false;
+	}
+	std::vector<GUIProperties> Snapshot(SectionList.begin(), SectionList.end());
+	return SourceIsBinary ? SaveSnapshot(Snapshot, DestFilename) : SaveBinarySnapshot(Snapshot, DestFilename);
+}
@@ -169,10 +169,11 @@ public:
 // Method:          AddControl
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Manually creates a control.
-// Arguments:       Properties.
+// Arguments:       Properties, Parent control if it's already known. Otherwise the
+//                  control named by the Parent property is used.
 // Returns:         GUIControl class created. 0 if not created.
 
-    GUIControl * AddControl(GUIProperties *Property);
+    GUIControl * AddControl(GUIProperties *Property, GUIControl *Parent = nullptr);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -230,6 +231,16 @@ public:
     bool GetEvent(GUIEvent *Event);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetDroppedEventCount
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how many events were thrown away because the queue was full.
+// Arguments:       None.
+// Returns:         The number of dropped events since the manager was created.
+
+    unsigned long GetDroppedEventCount() const { return m_DroppedEventCount; }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          SetCursor
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -259,6 +270,114 @@ public:
     bool Save(GUIWriter *W);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetSnapshot
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Copies the layout into a list of property sets, one per control in
+//                  save order, that can be written with SaveSnapshot without touching
+//                  the controls again.
+// Arguments:       List to fill. Anything already in it is removed.
+
+    void GetSnapshot(std::vector<GUIProperties> *Snapshot);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveSnapshot
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes a layout snapshot to a file in the same format as Save. The
+//                  data goes to a temporary file that is flushed to disk and then renamed
+//                  over the target, so the target is never left half written. Only uses
+//                  the snapshot, so it's safe to call from another thread.
+// Arguments:       Snapshot from GetSnapshot, Filename.
+// Returns:         True if successful.
+
+    static bool SaveSnapshot(const std::vector<GUIProperties> &Snapshot, const std::string &Filename);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveSnapshot
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes a layout snapshot to a Writer class. Save and the file version
+//                  of SaveSnapshot both write through this.
+// Arguments:       Snapshot from GetSnapshot, Writer class.
+// Returns:         True if successful.
+
+    static bool SaveSnapshot(const std::vector<GUIProperties> &Snapshot, GUIWriter *W);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveBinary
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Saves the layout to a file in the compiled binary format. Load reads
+//                  either format.
+// Arguments:       Filename.
+// Returns:         True if successful.
+
+    bool SaveBinary(const std::string &Filename);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SaveBinarySnapshot
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes a layout snapshot to a file in the compiled binary format. The
+//                  file is replaced atomically like in SaveSnapshot.
+// Arguments:       Snapshot from GetSnapshot, Filename.
+// Returns:         True if successful.
+
+    static bool SaveBinarySnapshot(const std::vector<GUIProperties> &Snapshot, const std::string &Filename);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ParseLayout
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Reads a whole layout file, INI or compiled, into one property set per
+//                  control without creating any controls. The format is told apart by
+//                  the compiled layout's magic number.
+// Arguments:       Filename, List to add the sections to, in file order.
+//                  Optional list to add a message to, with the file and line number, for
+//                  every line that was skipped.
+//                  Optional list to add the index of each section's parent section to,
+//                  -1 if it has none in the file. Only compiled layouts fill it in.
+// Returns:         True if the file could be read and, if compiled, is valid.
+
+    static bool ParseLayout(const std::string &Filename, std::deque<GUIProperties> &SectionList, std::vector<std::string> *ProblemList = nullptr, std::vector<int32_t> *ParentList = nullptr);
+
+
+    // One line of an INI layout, as views into the layout data.
+    struct LayoutLine {
+        enum LineType { Section, Property, Invalid };
+
+        LineType Type;
+        std::string_view Name; // Section name without the brackets, the property name, or the whole line if it's invalid.
+        std::string_view Value; // Property value, empty for the other types.
+        int LineNumber;
+    };
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ReadLayoutLine
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Reads the next line of an INI layout without copying anything. Follows
+//                  the same whitespace, comment and line rules as reading it through
+//                  GUIReader::ReadLine, and skips empty lines.
+// Arguments:       The whole layout, Position to read from, moved past the line read,
+//                  Line number at that position, kept up to date, The line read.
+// Returns:         False if there are no more lines.
+
+    static bool ReadLayoutLine(std::string_view Data, size_t &Pos, int &LineNumber, LayoutLine &Line);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ConvertLayout
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Converts a layout file between the INI and compiled formats. The
+//                  destination gets whichever format the source is not in.
+// Arguments:       Source filename, Destination filename.
+// Returns:         True if successful.
+
+    static bool ConvertLayout(const std::string &SourceFilename, const std::string &DestFilename);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Load
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -266,9 +385,28 @@ public:
 // Arguments:       Filename.
 //                  Whether to NOT clear out the manager, but just add the controls loaded
 //                  to the existing layout.
+//                  Optional list to add a message to, with the line number, for every
+//                  line that was skipped.
 // Returns:         True if successful.
 
-    bool Load(const std::string &Filename, bool keepOld = false);
+    bool Load(const std::string &Filename, bool keepOld = false, std::vector<std::string> *ProblemList = nullptr);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          LoadFiles
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Loads several layout files into this layout. The files are parsed in
+//                  parallel, then the controls are created on the calling thread in
+//                  file order, so the result is the same as loading them one by one.
+// Arguments:       Filenames, in the order their controls should be created.
+//                  Whether to NOT clear out the manager, but just add the controls loaded
+//                  to the existing layout.
+//                  Optional list to add a message to for every file that couldn't be read,
+//                  every line that was skipped and every control skipped because its
+//                  name was already taken.
+// Returns:         True if every file could be read.
+
+    bool LoadFiles(const std::vector<std::string> &FileList, bool keepOld = false, std::vector<std::string> *ProblemList = nullptr);
 
 
 	/// <summary>
@@ -285,17 +423,104 @@ private:
 	GUIManager *m_GUIManager;
 
 	std::vector<GUIControl *> m_ControlList;
-	std::vector<GUIEvent *> m_EventQueue;
+	std::unordered_map<std::string, GUIControl *> m_ControlMap; // Name to control lookup for GetControl, kept in sync with m_ControlList.
+
+	// Events are kept by value in a ring buffer so queuing one never allocates. When it's full, new events are dropped so the ones already queued are still delivered in order.
+	static constexpr int c_EventQueueCapacity = 256;
+	std::array<GUIEvent, c_EventQueueCapacity> m_EventQueue;
+	int m_EventQueueHead; // Index of the oldest queued event.
+	int m_EventQueueCount; // Number of queued events.
+	unsigned long m_DroppedEventCount; // Events thrown away because the queue was full.
 
 	int m_CursorType;
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          AddEvent
 //////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Add a new event to the queue.
-// Arguments:       Event point.
+// Description:     Add a new event to the queue. Drops the event if the queue is full.
+// Arguments:       Control, Event type, Msg, Data.
+
+	void AddEvent(GUIControl *Control, int Type, int Msg, int Data);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          AddControls
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Creates the controls of one parsed layout file in file order. With
+//                  parent indices from a compiled layout, each control is attached to the
+//                  control created for its parent section instead of looking it up by name.
+// Arguments:       Sections from ParseLayout, Parent indices from ParseLayout, empty for
+//                  text layouts, Function that tells whether a section should be added.
+
+	void AddControls(std::deque<GUIProperties> &ControlList, const std::vector<int32_t> &ParentList, const std::function<bool(GUIProperties &)> &ShouldAdd);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ParseTextLayout
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Splits an INI layout into one property set per [Section] in a single
+//                  pass with ReadLayoutLine. Lines that are neither a section nor a
+//                  property, and properties before the first section, are skipped.
+// Arguments:       The whole file, Its filename for the problem messages, List to add the
+//                  sections to, in file order, Optional list to add a message to for
+//                  every skipped line.
+
+	static void ParseTextLayout(std::string_view Data, const std::string &Filename, std::deque<GUIProperties> &SectionList, std::vector<std::string> *ProblemList);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ParseBinaryLayout
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Reads the sections out of a compiled layout. The tables are used in
+//                  place in the file data, nothing is copied until the properties are
+//                  filled in.
+// Arguments:       The whole file, List to add the sections to, in file order, Optional
+//                  list to add the index of each section's parent section to.
+// Returns:         True if the data is a valid compiled layout.
+
+	static bool ParseBinaryLayout(std::string_view Data, std::deque<GUIProperties> &SectionList, std::vector<int32_t> *ParentList);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          WriteFileAtomic
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes data to a temporary file, flushes it to disk and renames it
+//                  over the target, so the target is never left half written.
+// Arguments:       Filename, Data, Whether to write in binary mode instead of text mode.
+// Returns:         True if successful. The target is untouched on failure.
+
+	static bool WriteFileAtomic(const std::string &Filename, std::string_view Data, bool Binary);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ReplaceWithTempFile
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Flushes a fully written temporary file to disk and renames it over the
+//                  target. The temporary file is removed if anything fails.
+// Arguments:       Temporary filename, Filename, Whether the temporary file was written
+//                  completely. If not, it's only removed.
+// Returns:         True if the target was replaced.
+
+	static bool ReplaceWithTempFile(const std::string &TempFilename, const std::string &Filename, bool Written);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ControlRenamed
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Updates the name lookup after a control's Name property was changed.
+// Arguments:       The renamed control, the name it was registered under before.
+
+	void ControlRenamed(GUIControl *Control, const std::string &OldName);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IndexControlName
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Points a name in the lookup at the first control in the list with it,
+//                  or drops the name if no control has it anymore.
+// Arguments:       The name.
 
-	void AddEvent(GUIEvent *Event);
+	void IndexControlName(const std::string &Name);
 };
 };
 #endif  //  _GUICONTROLMANAGER_
\ No newline at end of file
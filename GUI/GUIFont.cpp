@@ -2,6 +2,9 @@
 
 using namespace RTE;
 
+thread_local bool GUIFont::s_UseThreadPens = false;
+thread_local std::unordered_map<const GUIFont *, GUIFont::FontPen> GUIFont::s_ThreadPens;
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GUIFont::GUIFont(const std::string &Name) {
@@ -9,13 +12,13 @@ GUIFont::GUIFont(const std::string &Name) {
 	m_Font = nullptr;
 	m_FontHeight = 0;
 	m_Name = Name;
-	m_Kerning = 0;
 	m_Leading = 0;
 	m_ColorCache.clear();
 
 	m_MainColor = 15; // Color index of the main font color
-	m_CurrentColor = m_MainColor;
-	m_CurrentBitmap = nullptr;
+	m_Pen.m_Color = m_MainColor;
+	m_Pen.m_Bitmap = nullptr;
+	m_Pen.m_Kerning = 0;
 
 	m_CharIndexCap = 256;
 }
@@ -32,14 +35,14 @@ bool GUIFont::Load(GUIScreen *Screen, const std::string &Filename) {
 	if (!m_Font) {
 		return false;
 	}
-	m_CurrentBitmap = m_Font;
+	m_Pen.m_Bitmap = m_Font;
 
 	// Clear the cache
 	m_ColorCache.clear();
 
 	// Convert the MainColor
-	m_MainColor = Screen->ConvertColor(m_MainColor, m_CurrentBitmap->GetColorDepth());
-	m_CurrentColor = m_MainColor;
+	m_MainColor = Screen->ConvertColor(m_MainColor, m_Font->GetColorDepth());
+	m_Pen.m_Color = m_MainColor;
 
 	// Set the color key to be the same color as the Top-Right hand corner pixel
 	unsigned long BackG = m_Font->GetPixel(m_Font->GetWidth() - 1, 0);
@@ -102,15 +105,52 @@ bool GUIFont::Load(GUIScreen *Screen, const std::string &Filename) {
 		}
 	}
 
+	CalculateGlyphSpans();
+
 	return true;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void GUIFont::Draw(GUIBitmap *Bitmap, int X, int Y, const std::string &Text, unsigned long Shadow) {
+void GUIFont::CalculateGlyphSpans() {
+	m_GlyphSpans.clear();
+
+	// Masked blits skip the mask color, so the spans have to cover exactly the other pixels
+	unsigned long MaskColor = m_Font->GetColorKey();
+
+	for (int chr = 32; chr < m_CharIndexCap; chr++) {
+		Character &Glyph = m_Characters[chr];
+		Glyph.m_SpanStart = m_GlyphSpans.size();
+
+		int SrcY = ((chr - 32) / 16) * m_FontHeight;
+		for (int Row = 0; Row < m_FontHeight && SrcY + Row < m_Font->GetHeight(); Row++) {
+			int SpanStart = -1;
+			// Go one past the last column so a span reaching the right edge gets closed
+			for (int Col = 0; Col <= Glyph.m_Width; Col++) {
+				bool Opaque = Col < Glyph.m_Width && Glyph.m_Offset + Col < m_Font->GetWidth() && m_Font->GetPixel(Glyph.m_Offset + Col, SrcY + Row) != MaskColor;
+				if (Opaque && SpanStart < 0) {
+					SpanStart = Col;
+				} else if (!Opaque && SpanStart >= 0) {
+					GUIPixelSpan Span;
+					Span.m_Row = Row;
+					Span.m_Start = SpanStart;
+					Span.m_Length = Col - SpanStart;
+					m_GlyphSpans.push_back(Span);
+					SpanStart = -1;
+				}
+			}
+		}
+		Glyph.m_SpanCount = m_GlyphSpans.size() - Glyph.m_SpanStart;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIFont::Draw(GUIBitmap *Bitmap, int X, int Y, const std::string_view &Text, unsigned long Shadow) {
 	unsigned char c;
 	GUIRect Rect;
-	GUIBitmap *Surf = m_CurrentBitmap;
+	const FontPen &Pen = GetPen();
+	GUIBitmap *Surf = Pen.m_Bitmap;
 	int initX = X;
 
 	assert(Surf);
@@ -125,8 +165,11 @@ void GUIFont::Draw(GUIBitmap *Bitmap, int X, int Y, const std::string &Text, uns
 		}
 	}
 
+	// Characters are copied span by span where the bitmaps allow it, otherwise with masked blits
+	bool UseSpans = !m_GlyphSpans.empty();
+
 	// Go through every character
-	for (int i = 0; i < Text.length(); i++) {
+	for (size_t i = 0; i < Text.length(); i++) {
 		c = Text.at(i);
 
 		if (c == '\n') {
@@ -143,22 +186,28 @@ void GUIFont::Draw(GUIBitmap *Bitmap, int X, int Y, const std::string &Text, uns
 		int offX = m_Characters[c].m_Offset;
 		int offY = ((c - 32) / 16) * m_FontHeight;
 		SetRect(&Rect, offX, offY, offX + CharWidth, offY + m_FontHeight);
+		const GUIPixelSpan *Spans = m_GlyphSpans.data() + m_Characters[c].m_SpanStart;
 
 		// Draw the shadow
-		if (Shadow && FSC) { FSC->m_Bitmap->DrawTrans(Bitmap, X + 1, Y + 1, &Rect); }
+		if (Shadow && FSC) {
+			UseSpans = UseSpans && FSC->m_Bitmap->DrawSpans(Bitmap, X + 1, Y + 1, Rect, Spans, m_Characters[c].m_SpanCount);
+			if (!UseSpans) { FSC->m_Bitmap->DrawTrans(Bitmap, X + 1, Y + 1, &Rect); }
+		}
 
 		// Draw the main color
-		Surf->DrawTrans(Bitmap, X, Y, &Rect);
+		UseSpans = UseSpans && Surf->DrawSpans(Bitmap, X, Y, Rect, Spans, m_Characters[c].m_SpanCount);
+		if (!UseSpans) { Surf->DrawTrans(Bitmap, X, Y, &Rect); }
 
 		// Find the starting position
-		X += CharWidth + m_Kerning;
+		X += CharWidth + Pen.m_Kerning;
 	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIFont::DrawAligned(GUIBitmap *Bitmap, int X, int Y, const std::string &Text, int HAlign, int VAlign, int MaxWidth, unsigned long Shadow) {
-	std::string TextLine = Text;
+	// Lines are views into the text so wrapping doesn't copy anything
+	std::string_view TextLine;
 	int lineStartPos = 0;
 	int lineEndPos = 0;
 	int lineWidth = 0;
@@ -167,16 +216,16 @@ void GUIFont::DrawAligned(GUIBitmap *Bitmap, int X, int Y, const std::string &Te
 
 	// Adjust the starting of the Y based on vertical alignment
 	if (VAlign == Middle) {
-		yLine -= (CalculateHeight(TextLine, MaxWidth) / 2);
+		yLine -= (CalculateHeight(Text, MaxWidth) / 2);
 	} else if (VAlign == Bottom) {
-		yLine -= CalculateHeight(TextLine, MaxWidth);
+		yLine -= CalculateHeight(Text, MaxWidth);
 	}
 
 	while (lineStartPos < Text.size()) {
 		// Find the next newline, if any
 		lineEndPos = Text.find('\n', lineStartPos);
 		// Grab the whole line
-		TextLine = Text.substr(lineStartPos, (lineEndPos == std::string::npos ? Text.size() : lineEndPos) - lineStartPos);
+		TextLine = std::string_view(Text).substr(lineStartPos, (lineEndPos == std::string::npos ? Text.size() : lineEndPos) - lineStartPos);
 		// Figure its width, in pixels
 		lineWidth = CalculateWidth(TextLine);
 
@@ -194,7 +243,7 @@ void GUIFont::DrawAligned(GUIBitmap *Bitmap, int X, int Y, const std::string &Te
 				// Update the new end position
 				lineEndPos = lastSpacePos;
 				// Get the new, shorter line
-				TextLine = Text.substr(lineStartPos, lineEndPos - lineStartPos);
+				TextLine = std::string_view(Text).substr(lineStartPos, lineEndPos - lineStartPos);
 				// Figure the new line width, in pixels
 				lineWidth = CalculateWidth(TextLine);
 			} while (lineWidth > MaxWidth);
@@ -240,29 +289,32 @@ void GUIFont::DrawAligned(GUIBitmap *Bitmap, int X, int Y, const std::string &Te
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIFont::SetColor(unsigned long Color) {
+	FontPen &Pen = GetPen();
+
 	// Only check the change if the color is different
-	if (Color != m_CurrentColor) {
+	if (Color != Pen.m_Color) {
 
 		// Find the cached color
 		FontColor *FC = GetFontColor(Color);
 
 		// Use the cached color, otherwise just draw the default bitmap
 		if (FC) {
-			m_CurrentBitmap = FC->m_Bitmap;
-			m_CurrentColor = Color;
+			Pen.m_Bitmap = FC->m_Bitmap;
+			Pen.m_Color = Color;
 		}
 	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int GUIFont::CalculateWidth(const std::string &Text) {
+int GUIFont::CalculateWidth(const std::string_view &Text) {
 	unsigned char c;
+	int Kerning = GetPen().m_Kerning;
 	int Width = 0;
 	int WidestLine = 0;
 
 	// Go through every character
-	for (int i = 0; i < Text.length(); i++) {
+	for (size_t i = 0; i < Text.length(); i++) {
 		c = Text.at(i);
 		// Reset line counting if newline encountered
 		if (c == '\n') {
@@ -279,7 +331,7 @@ int GUIFont::CalculateWidth(const std::string &Text) {
 		Width += m_Characters[c].m_Width;
 
 		// Add kerning
-		Width += m_Kerning;
+		Width += Kerning;
 	}
 	if (Width > WidestLine) { WidestLine = Width; }
 
@@ -290,7 +342,7 @@ int GUIFont::CalculateWidth(const std::string &Text) {
 
 int GUIFont::CalculateWidth(const char Character) {
 	if (Character >= 32 && Character < m_CharIndexCap) {
-		return m_Characters[Character].m_Width + m_Kerning;
+		return m_Characters[Character].m_Width + GetPen().m_Kerning;
 	}
 	return 0;
 }
@@ -302,12 +354,13 @@ int GUIFont::CalculateHeight(const std::string &Text, int MaxWidth) {
 		return 0;
 	}
 	unsigned char c;
+	int Kerning = GetPen().m_Kerning;
 	int Width = 0;
 	int Height = m_FontHeight;
 	int lastSpacePos = 0;
 
 	// Go through every character
-	for (int i = 0; i < Text.length(); i++) {
+	for (size_t i = 0; i < Text.length(); i++) {
 		c = Text.at(i);
 
 		// Add the new line's height if newline encountered
@@ -321,7 +374,7 @@ int GUIFont::CalculateHeight(const std::string &Text, int MaxWidth) {
 		}
 		if (c == ' ') { lastSpacePos = i; }
 
-		Width += m_Characters[c].m_Width + m_Kerning;
+		Width += m_Characters[c].m_Width + Kerning;
 		if (MaxWidth > 0 && Width > MaxWidth) {
 			// Rewind to the last space, and do line break, but only if we've passed a space since last wrap
 			if (lastSpacePos > 0) {
@@ -340,6 +393,8 @@ int GUIFont::CalculateHeight(const std::string &Text, int MaxWidth) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIFont::CacheColor(unsigned long Color) {
+	std::lock_guard<std::recursive_mutex> ColorCacheLock(m_ColorCacheMutex);
+
 	// Make sure we haven't already cached this color and it isn't a 0 color
 	if (GetFontColor(Color) != nullptr || !Color) {
 		return;
@@ -362,32 +417,36 @@ void GUIFont::CacheColor(unsigned long Color) {
 	unsigned long BackG = FC.m_Bitmap->GetPixel(FC.m_Bitmap->GetWidth() - 1, 0);
 	FC.m_Bitmap->SetColorKey(BackG);
 
-	// Go through the bitmap and change the pixels
-	for (int y = 0; y < FC.m_Bitmap->GetHeight(); y++) {
-		for (int x = 0; x < FC.m_Bitmap->GetWidth(); x++) {
-			if (FC.m_Bitmap->GetPixel(x, y) == m_MainColor) { FC.m_Bitmap->SetPixel(x, y, Color); }
-		}
-	}
+	// Change the main color pixels to the new color
+	FC.m_Bitmap->ReplaceColor(m_MainColor, Color);
 
-	// Add the color to the list
-	m_ColorCache.push_back(FC);
+	// Add the color to the cache
+	m_ColorCache.try_emplace(Color, FC);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-GUIFont::FontColor * GUIFont::GetFontColor(unsigned long Color) {
-	std::vector<FontColor>::iterator it;
-	FontColor *F = nullptr;
-	for (it = m_ColorCache.begin(); it != m_ColorCache.end(); it++) {
-		F = &(*it);
+void GUIFont::SetUseThreadPens(bool UseThreadPens) {
+	s_UseThreadPens = UseThreadPens;
+	s_ThreadPens.clear();
+}
 
-		// Colors match?
-		if (F->m_Color == Color) {
-			return F;
-		}
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+GUIFont::FontPen & GUIFont::GetPen() {
+	if (!s_UseThreadPens) {
+		return m_Pen;
 	}
-	// Not found
-	return nullptr;
+	return s_ThreadPens.try_emplace(this, m_Pen).first->second;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+GUIFont::FontColor * GUIFont::GetFontColor(unsigned long Color) {
+	// Cached colors are never removed while drawing and unordered_map doesn't move its elements, so the returned pointer stays valid after unlocking
+	std::lock_guard<std::recursive_mutex> ColorCacheLock(m_ColorCacheMutex);
+	std::unordered_map<unsigned long, FontColor>::iterator it = m_ColorCache.find(Color);
+	return (it != m_ColorCache.end()) ? &it->second : nullptr;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -405,7 +464,7 @@ std::string GUIFont::GetName() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 int GUIFont::GetKerning() const {
-	return m_Kerning;
+	return GetPen().m_Kerning;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -418,10 +477,10 @@ void GUIFont::Destroy() {
 	}
 
 	// Go through the color cache and destroy the bitmaps
-	std::vector<FontColor>::iterator it;
+	std::unordered_map<unsigned long, FontColor>::iterator it;
 	FontColor *FC = 0;
 	for (it = m_ColorCache.begin(); it != m_ColorCache.end(); it++) {
-		FC = &(*it);
+		FC = &it->second;
 		if (FC && FC->m_Bitmap) {
 			FC->m_Bitmap->Destroy();
 			delete FC->m_Bitmap;
@@ -29,6 +29,8 @@ public:
         int            m_Width;
         int            m_Height;
         int            m_Offset;
+        int            m_SpanStart; // Index of the first opaque span of this character in the span list
+        int            m_SpanCount;
     } Character;
 
     // Font Color structure
@@ -37,6 +39,13 @@ public:
         GUIBitmap    *m_Bitmap;
     } FontColor;
 
+    // What text is currently drawn with, as set by SetColor and SetKerning
+    typedef struct {
+        unsigned long  m_Color;
+        GUIBitmap     *m_Bitmap;
+        int            m_Kerning;
+    } FontPen;
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Constructor:     GUIFont
@@ -81,7 +90,7 @@ public:
 // Description:     Draws text to a bitmap.
 // Arguments:       Bitmap, Position, Text, Color, Drop-shadow, 0 = none.
 
-    void Draw(GUIBitmap *Bitmap, int X, int Y, const std::string &Text, unsigned long Shadow = 0);
+    void Draw(GUIBitmap *Bitmap, int X, int Y, const std::string_view &Text, unsigned long Shadow = 0);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -108,7 +117,7 @@ public:
 // Description:     Calculates the width of a piece of text.
 // Arguments:       Text.
 
-    int CalculateWidth(const std::string &Text);
+    int CalculateWidth(const std::string_view &Text);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -173,25 +182,64 @@ public:
 //                  between chars, 0 = chars are touching.
 // Arguments:       None.
 
-    void SetKerning(int newKerning = 1) { m_Kerning = newKerning; }
+    void SetKerning(int newKerning = 1) { GetPen().m_Kerning = newKerning; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Static Method:   SetUseThreadPens
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets whether the calling thread keeps a color and kerning of its own
+//                  for every font, instead of sharing the fonts' ones with other threads.
+//                  They start out as the shared ones. Used while several threads draw the
+//                  GUI at once, where every panel sets the color and kerning it draws with.
+// Arguments:       Whether the calling thread uses pens of its own. Turning them off
+//                  drops them.
+
+    static void SetUseThreadPens(bool UseThreadPens);
 
 private:
 
+    static thread_local bool s_UseThreadPens; // Whether this thread uses the pens in s_ThreadPens instead of the fonts' own.
+    static thread_local std::unordered_map<const GUIFont *, FontPen> s_ThreadPens; // This thread's pens for the fonts it drew with, when using pens of its own.
+
     GUIBitmap *m_Font;
     GUIScreen *m_Screen;
-    std::vector<FontColor > m_ColorCache;
+    std::unordered_map<unsigned long, FontColor> m_ColorCache; // Color to recolored font bitmap
+    std::recursive_mutex m_ColorCacheMutex; // Guards m_ColorCache, since shadow colors are cached while drawing, which several threads may be doing at once
 
     int m_FontHeight;
     unsigned long m_MainColor;
-    unsigned long m_CurrentColor;
-    GUIBitmap *m_CurrentBitmap;
+    FontPen m_Pen; // What text is drawn with, unless the drawing thread uses a pen of its own
     std::string m_Name;
     Character m_Characters[256];
 
     int m_CharIndexCap; // The highest index of valid characters that was read in from the file
 
-    int m_Kerning; // Spacing between characters
     int m_Leading; // Spacing between lines
+
+    std::vector<GUIPixelSpan> m_GlyphSpans; // Opaque pixel runs of all the characters, the same for every cached color
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          CalculateGlyphSpans
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Finds the runs of opaque pixels of every character so text can be
+//                  copied straight into memory bitmaps.
+// Arguments:       None.
+
+    void CalculateGlyphSpans();
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetPen
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the pen the calling thread draws with, see SetUseThreadPens.
+// Arguments:       None.
+// Returns:         The pen holding the current color and kerning (spacing between
+//                  characters).
+
+    FontPen & GetPen();
+    const FontPen & GetPen() const { return const_cast<GUIFont *>(this)->GetPen(); }
 };
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "GUI.h"
+
+namespace RTE {
+
+	const std::vector<int> GUIHitGrid::s_NoCandidates;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GUIHitGrid::Clear() {
+		SetRect(&m_Bounds, 0, 0, -1, -1);
+		m_CellWidth = 1;
+		m_CellHeight = 1;
+		m_Columns = 0;
+		m_Rows = 0;
+		m_Cells.clear();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GUIHitGrid::Build(const std::vector<GUIRect> &rectList) {
+		Clear();
+		if (rectList.empty()) {
+			return;
+		}
+
+		m_Bounds = rectList.front();
+		for (const GUIRect &rect : rectList) {
+			m_Bounds.left = std::min(m_Bounds.left, rect.left);
+			m_Bounds.top = std::min(m_Bounds.top, rect.top);
+			m_Bounds.right = std::max(m_Bounds.right, rect.right);
+			m_Bounds.bottom = std::max(m_Bounds.bottom, rect.bottom);
+		}
+
+		// Aim for about one rectangle per cell, but don't let the grid get silly for huge lists
+		int cellsPerSide = std::clamp(static_cast<int>(std::ceil(std::sqrt(static_cast<double>(rectList.size())))), 1, 64);
+		int boundsWidth = m_Bounds.right - m_Bounds.left + 1;
+		int boundsHeight = m_Bounds.bottom - m_Bounds.top + 1;
+		m_CellWidth = std::max((boundsWidth + cellsPerSide - 1) / cellsPerSide, 1);
+		m_CellHeight = std::max((boundsHeight + cellsPerSide - 1) / cellsPerSide, 1);
+		m_Columns = (boundsWidth + m_CellWidth - 1) / m_CellWidth;
+		m_Rows = (boundsHeight + m_CellHeight - 1) / m_CellHeight;
+		m_Cells.resize(m_Columns * m_Rows);
+
+		// Rectangles are added in list order so every cell's indices end up sorted
+		for (size_t index = 0; index < rectList.size(); index++) {
+			const GUIRect &rect = rectList[index];
+			if (rect.right < rect.left || rect.bottom < rect.top) {
+				continue;
+			}
+			int firstColumn = (rect.left - m_Bounds.left) / m_CellWidth;
+			int lastColumn = (rect.right - m_Bounds.left) / m_CellWidth;
+			int firstRow = (rect.top - m_Bounds.top) / m_CellHeight;
+			int lastRow = (rect.bottom - m_Bounds.top) / m_CellHeight;
+			for (int row = firstRow; row <= lastRow; row++) {
+				for (int column = firstColumn; column <= lastColumn; column++) {
+					m_Cells[row * m_Columns + column].push_back(static_cast<int>(index));
+				}
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	const std::vector<int> & GUIHitGrid::GetCandidates(int posX, int posY) const {
+		if (m_Cells.empty() || posX < m_Bounds.left || posX > m_Bounds.right || posY < m_Bounds.top || posY > m_Bounds.bottom) {
+			return s_NoCandidates;
+		}
+		int column = (posX - m_Bounds.left) / m_CellWidth;
+		int row = (posY - m_Bounds.top) / m_CellHeight;
+		return m_Cells[row * m_Columns + column];
+	}
+}
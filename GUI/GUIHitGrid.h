@@ -0,0 +1,49 @@
+#ifndef _GUIHITGRID_
+#define _GUIHITGRID_
+
+namespace RTE {
+
+	/// <summary>
+	/// A uniform grid over a list of rectangles, used to find which of them may contain a point without checking all of them.
+	/// </summary>
+	class GUIHitGrid {
+
+	public:
+
+		/// <summary>
+		/// Constructor method used to instantiate a GUIHitGrid object in system memory.
+		/// </summary>
+		GUIHitGrid() { Clear(); }
+
+		/// <summary>
+		/// Empties the grid.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Rebuilds the grid over a list of rectangles. The grid gets about as many cells as there are rectangles.
+		/// </summary>
+		/// <param name="rectList">The rectangles to index. Edges are inclusive, same as GUIPanel::PointInside.</param>
+		void Build(const std::vector<GUIRect> &rectList);
+
+		/// <summary>
+		/// Gets the indices of the rectangles that may contain a point. Every rectangle that does contain it is included, but some that don't may be too.
+		/// </summary>
+		/// <param name="posX">X position of the point.</param>
+		/// <param name="posY">Y position of the point.</param>
+		/// <returns>The indices into the list the grid was built from, in ascending order. Valid until the grid is rebuilt or cleared.</returns>
+		const std::vector<int> & GetCandidates(int posX, int posY) const;
+
+	private:
+
+		static const std::vector<int> s_NoCandidates; //!< Returned for points outside the grid.
+
+		GUIRect m_Bounds; //!< The area covered by the grid, the union of all the rectangles.
+		int m_CellWidth; //!< Width of each cell.
+		int m_CellHeight; //!< Height of each cell.
+		int m_Columns; //!< Number of cell columns.
+		int m_Rows; //!< Number of cell rows.
+		std::vector<std::vector<int>> m_Cells; //!< The indices of the rectangles overlapping each cell, row by row.
+	};
+}
+#endif
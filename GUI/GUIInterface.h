@@ -3,10 +3,19 @@
 
 // Header file for abstract classes used by the GUI library.
 
+#include "GUIClipStack.h"
+
 struct BITMAP;
 
 namespace RTE {
 
+#pragma region Pixel Span Structure
+	/// <summary>
+	/// A horizontal run of pixels within an area of a bitmap, relative to the area's top-left corner.
+	/// </summary>
+	struct GUIPixelSpan { unsigned short m_Row; unsigned short m_Start; unsigned short m_Length; };
+#pragma endregion
+
 #pragma region GUIBitmap
 	/// <summary>
 	/// An interface class inherited by the different types of bitmap methods.
@@ -97,6 +106,12 @@ namespace RTE {
 		/// </summary>
 		/// <param name="colorKey">Color key (mask color).</param>
 		virtual void SetColorKey(unsigned long colorKey) {}
+
+		/// <summary>
+		/// Gets the color key (mask color) of the bitmap, the color that DrawTrans skips.
+		/// </summary>
+		/// <returns>The color key of the bitmap.</returns>
+		virtual unsigned long GetColorKey() const = 0;
 #pragma endregion
 
 #pragma region Clipping
@@ -147,9 +162,35 @@ namespace RTE {
 		/// <param name="width">Target width of the bitmap.</param>
 		/// <param name="height">Target height of the bitmap.</param>
 		virtual void DrawTransScaled(GUIBitmap *destBitmap, int destX, int destY, int width, int height) = 0;
+
+		/// <summary>
+		/// Copies runs of pixels from a section of this bitmap onto another bitmap as they are, clipped to the destination's clipping rectangle.
+		/// Copying just the runs that aren't color-keyed gives the same result as DrawTrans without checking every pixel. Not supported by default.
+		/// </summary>
+		/// <param name="destBitmap">Bitmap to draw onto.</param>
+		/// <param name="destX">Destination X position.</param>
+		/// <param name="destY">Destination Y position.</param>
+		/// <param name="srcPosAndSizeRect">Source bitmap position and size rectangle. Has to be within the bitmap, and the runs within it.</param>
+		/// <param name="spans">The runs of pixels to copy, relative to the source rectangle's top-left corner.</param>
+		/// <param name="spanCount">Number of runs to copy.</param>
+		/// <returns>Whether the runs were copied. False if the pixels can't be copied directly between the two bitmaps, in which case nothing is drawn.</returns>
+		virtual bool DrawSpans(GUIBitmap * /*destBitmap*/, int /*destX*/, int /*destY*/, const GUIRect & /*srcPosAndSizeRect*/, const GUIPixelSpan * /*spans*/, int /*spanCount*/) { return false; }
 #pragma endregion
 
 #pragma region Primitive Drawing
+		/// <summary>
+		/// Replaces every pixel of one color on this bitmap with another color. Goes through GetPixel and SetPixel by default.
+		/// </summary>
+		/// <param name="oldColor">The color to replace.</param>
+		/// <param name="newColor">The color to replace it with.</param>
+		virtual void ReplaceColor(unsigned long oldColor, unsigned long newColor) {
+			for (int y = 0; y < GetHeight(); y++) {
+				for (int x = 0; x < GetWidth(); x++) {
+					if (GetPixel(x, y) == oldColor) { SetPixel(x, y, newColor); }
+				}
+			}
+		}
+
 		/// <summary>
 		/// Draws a line on this bitmap.
 		/// </summary>
@@ -205,6 +246,26 @@ namespace RTE {
 		/// <param name="height">Bitmap height.</param>
 		/// <returns>Pointer to the created bitmap.</returns>
 		virtual GUIBitmap * CreateBitmap(int width, int height) = 0;
+
+		/// <summary>
+		/// Lets the screen start loading a set of image files ahead of the CreateBitmap calls for them, so they can load in parallel. Does nothing by default.
+		/// </summary>
+		/// <param name="fileNames">File names of the images that are about to be created.</param>
+		virtual void PreloadBitmaps(const std::vector<std::string> & /*fileNames*/) {}
+
+		/// <summary>
+		/// Creates a screen that draws onto a new offscreen bitmap of its own, in the same format as this screen's, e.g. to cache drawn panels. Not supported by default.
+		/// </summary>
+		/// <param name="width">Width of the offscreen bitmap.</param>
+		/// <param name="height">Height of the offscreen bitmap.</param>
+		/// <returns>Pointer to the created screen, or nullptr if this screen can't make offscreen ones. Ownership IS transferred!</returns>
+		virtual GUIScreen * CreateOffscreen(int /*width*/, int /*height*/) { return nullptr; }
+
+		/// <summary>
+		/// Creates a screen that draws onto the same pixels as this one but keeps its own clipping rectangle, so several threads can draw onto different areas of this screen at once. Not supported by default.
+		/// </summary>
+		/// <returns>Pointer to the created screen, or nullptr if this screen can't make views of itself. Ownership IS transferred!</returns>
+		virtual GUIScreen * CreateView() { return nullptr; }
 #pragma endregion
 
 #pragma region Destruction
@@ -225,6 +286,12 @@ namespace RTE {
 		/// </summary>
 		/// <returns>Pointer to the bitmap representing the screen.</returns>
 		virtual GUIBitmap * GetBitmap() const = 0;
+
+		/// <summary>
+		/// Gets the clip stack panels use while they're being drawn onto this screen's bitmap.
+		/// </summary>
+		/// <returns>Reference to the clip stack of this screen.</returns>
+		GUIClipStack & GetClipStack() { return m_ClipStack; }
 #pragma endregion
 
 #pragma region Pure Virtual Methods
@@ -257,6 +324,10 @@ namespace RTE {
 
 		// Disallow the use of some implicit methods.
 		GUIScreen & operator=(const GUIScreen &rhs) = delete;
+
+	private:
+
+		GUIClipStack m_ClipStack; //!< The clipping rectangles of the panels being drawn onto this screen's bitmap.
 	};
 #pragma endregion
 }
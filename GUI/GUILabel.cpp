@@ -17,6 +17,9 @@ GUILabel::GUILabel(GUIManager *Manager, GUIControlManager *ControlManager) : GUI
 	m_VerticalOverflowScroll = false;
 	m_OverflowScrollState = OverflowScrollState::Deactivated;
 	m_OverflowScrollTimer = Timer();
+	m_OverflowScrollRedrawTime = 0;
+	m_OverflowScrollOffsetX = 0;
+	m_OverflowScrollOffsetY = 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -105,13 +108,35 @@ void GUILabel::ChangeSkin(GUISkin *Skin) {
 
 void GUILabel::Draw(GUIScreen *Screen) {
 	Draw(Screen->GetBitmap());
+
+	// Come back when the scrolling text is next due to move instead of repainting every frame
+	if (!IsDrawingTiles()) {
+		double RedrawDelay = GetOverflowScrollRedrawDelay();
+		if (RedrawDelay >= 0) { InvalidateAfter(RedrawDelay); }
+	}
+
 	GUIPanel::Draw(Screen);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GUILabel::PrepareDraw(GUIScreen *Screen) {
+	if (m_Font) {
+		m_Font->SetKerning(m_FontKerning);
+		UpdateOverflowScroll(m_HorizontalOverflowScroll ? m_Font->CalculateWidth(m_Text) : 0, m_VerticalOverflowScroll ? m_Font->CalculateHeight(m_Text) : 0);
+	}
+	double RedrawDelay = GetOverflowScrollRedrawDelay();
+	if (RedrawDelay >= 0) { InvalidateAfter(RedrawDelay); }
+
+	GUIPanel::PrepareDraw(Screen);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void GUILabel::Draw(GUIBitmap *Bitmap, bool overwiteFontColorAndKerning) {
-	// Setup the clipping
+	// Setup the clipping, keeping within the area already being clipped to
+	GUIRect PrevClip;
+	Bitmap->GetClipRect(&PrevClip);
 	Bitmap->AddClipRect(GetRect());
 
 	if (m_Font) {
@@ -138,61 +163,93 @@ void GUILabel::Draw(GUIBitmap *Bitmap, bool overwiteFontColorAndKerning) {
 
 		int textFullWidth = m_HorizontalOverflowScroll ? m_Font->CalculateWidth(m_Text) : 0;
 		int textFullHeight = m_VerticalOverflowScroll ? m_Font->CalculateHeight(m_Text) : 0;
-		bool modifyXPos = textFullWidth > m_Width;
-		bool modifyYPos = textFullHeight > m_Height;
-		xPos = modifyXPos ? m_X : xPos;
-		yPos = modifyYPos ? m_Y : yPos;
-		if (OverflowScrollIsActivated()) {
-			switch (m_OverflowScrollState) {
-				case OverflowScrollState::WaitAtStart:
-					if (m_OverflowScrollTimer.GetRealTimeLimitMS() == -1) {
-						m_OverflowScrollTimer.SetRealTimeLimitMS(1000);
-						m_OverflowScrollTimer.Reset();
-					} else if (m_OverflowScrollTimer.IsPastRealTimeLimit()) {
-						m_OverflowScrollState = OverflowScrollState::Scrolling;
-						m_OverflowScrollTimer.SetRealTimeLimitMS(-1);
-						break;
-					}
+		xPos = textFullWidth > m_Width ? m_X : xPos;
+		yPos = textFullHeight > m_Height ? m_Y : yPos;
+		if (!IsDrawingTiles()) { UpdateOverflowScroll(textFullWidth, textFullHeight); }
+		xPos -= m_OverflowScrollOffsetX;
+		yPos -= m_OverflowScrollOffsetY;
+		m_Font->DrawAligned(Bitmap, xPos, yPos, m_Text, m_HorizontalOverflowScroll && textFullWidth > m_Width ? GUIFont::Left : m_HAlignment, m_VerticalOverflowScroll && textFullHeight > m_Height ? GUIFont::Top : m_VAlignment, m_HorizontalOverflowScroll ? textFullWidth : m_Width, m_FontShadow);
+	}
+
+	Bitmap->SetClipRect(&PrevClip);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUILabel::UpdateOverflowScroll(int textFullWidth, int textFullHeight) {
+	bool modifyXPos = textFullWidth > m_Width;
+	bool modifyYPos = textFullHeight > m_Height;
+	m_OverflowScrollOffsetX = 0;
+	m_OverflowScrollOffsetY = 0;
+	m_OverflowScrollRedrawTime = -1;
+	if (OverflowScrollIsActivated()) {
+		switch (m_OverflowScrollState) {
+			case OverflowScrollState::WaitAtStart:
+				if (m_OverflowScrollTimer.GetRealTimeLimitMS() == -1) {
+					m_OverflowScrollTimer.SetRealTimeLimitMS(1000);
+					m_OverflowScrollTimer.Reset();
+				} else if (m_OverflowScrollTimer.IsPastRealTimeLimit()) {
+					m_OverflowScrollState = OverflowScrollState::Scrolling;
+					m_OverflowScrollTimer.SetRealTimeLimitMS(-1);
+					m_OverflowScrollRedrawTime = 0;
 					break;
-				case OverflowScrollState::Scrolling:
-					if (m_OverflowScrollTimer.GetRealTimeLimitMS() == -1) {
-						//TODO Maybe time limits should account for extra size vs width, so it scrolls slower on small labels, since it can be harder to read fast text on smaller areas. I think it's fine as-is though.
-						// Note - time limits set so 5 characters of fatfont horizontal overflow or one line of fatfont vertical overflow will take 1 second.
-						if (modifyXPos) {
-							m_OverflowScrollTimer.SetRealTimeLimitMS((1000.0 / 30.0) * static_cast<double>(textFullWidth - m_Width));
-						} else if (modifyYPos) {
-							m_OverflowScrollTimer.SetRealTimeLimitMS((1000.0 / 8.0) * static_cast<double>(textFullHeight - m_Height));
-						}
-						m_OverflowScrollTimer.Reset();
-					} else if (m_OverflowScrollTimer.IsPastRealTimeLimit()) {
-						m_OverflowScrollTimer.SetRealTimeLimitMS(-1);
-						m_OverflowScrollState = OverflowScrollState::WaitAtEnd;
-						break;
+				}
+				m_OverflowScrollRedrawTime = m_OverflowScrollTimer.GetRealTimeLimitMS();
+				break;
+			case OverflowScrollState::Scrolling:
+				if (m_OverflowScrollTimer.GetRealTimeLimitMS() == -1) {
+					//TODO Maybe time limits should account for extra size vs width, so it scrolls slower on small labels, since it can be harder to read fast text on smaller areas. I think it's fine as-is though.
+					// Note - time limits set so 5 characters of fatfont horizontal overflow or one line of fatfont vertical overflow will take 1 second.
+					if (modifyXPos) {
+						m_OverflowScrollTimer.SetRealTimeLimitMS((1000.0 / 30.0) * static_cast<double>(textFullWidth - m_Width));
+					} else if (modifyYPos) {
+						m_OverflowScrollTimer.SetRealTimeLimitMS((1000.0 / 8.0) * static_cast<double>(textFullHeight - m_Height));
 					}
-					xPos -= modifyXPos ? static_cast<int>(static_cast<double>(textFullWidth - m_Width) * m_OverflowScrollTimer.RealTimeLimitProgress()) : 0;
-					yPos -= modifyYPos ? static_cast<int>(static_cast<double>(textFullHeight - m_Height) * m_OverflowScrollTimer.RealTimeLimitProgress()) : 0;
+					m_OverflowScrollTimer.Reset();
+				} else if (m_OverflowScrollTimer.IsPastRealTimeLimit()) {
+					m_OverflowScrollTimer.SetRealTimeLimitMS(-1);
+					m_OverflowScrollState = OverflowScrollState::WaitAtEnd;
+					m_OverflowScrollRedrawTime = 0;
 					break;
-				case OverflowScrollState::WaitAtEnd:
-					if (m_OverflowScrollTimer.GetRealTimeLimitMS() == -1) {
-						m_OverflowScrollTimer.SetRealTimeLimitMS(1000);
-						m_OverflowScrollTimer.Reset();
-					} else if (m_OverflowScrollTimer.IsPastRealTimeLimit()) {
-						m_OverflowScrollTimer.SetRealTimeLimitMS(-1);
-						m_OverflowScrollState = OverflowScrollState::WaitAtStart;
-						break;
+				}
+				if (modifyXPos || modifyYPos) {
+					// Both directions scroll over the same time, each by its own overflow. The text only visibly moves a whole pixel at a time, so the next redraw is when either offset next goes up by one
+					double scrollProgress = m_OverflowScrollTimer.RealTimeLimitProgress();
+					double scrollTimeLimit = m_OverflowScrollTimer.GetRealTimeLimitMS();
+					m_OverflowScrollRedrawTime = scrollTimeLimit;
+					if (modifyXPos) {
+						int scrollDistance = textFullWidth - m_Width;
+						m_OverflowScrollOffsetX = static_cast<int>(static_cast<double>(scrollDistance) * scrollProgress);
+						m_OverflowScrollRedrawTime = std::min(scrollTimeLimit * static_cast<double>(m_OverflowScrollOffsetX + 1) / static_cast<double>(scrollDistance), m_OverflowScrollRedrawTime);
 					}
-					xPos -= modifyXPos ? (textFullWidth - m_Width) : 0;
-					yPos -= modifyYPos ? (textFullHeight - m_Height) : 0;
-					break;
-				default:
-					GUIAbort("Invalid GUILabel overflow scroll state " + static_cast<int>(m_OverflowScrollState));
+					if (modifyYPos) {
+						int scrollDistance = textFullHeight - m_Height;
+						m_OverflowScrollOffsetY = static_cast<int>(static_cast<double>(scrollDistance) * scrollProgress);
+						m_OverflowScrollRedrawTime = std::min(scrollTimeLimit * static_cast<double>(m_OverflowScrollOffsetY + 1) / static_cast<double>(scrollDistance), m_OverflowScrollRedrawTime);
+					}
+				}
+				break;
+			case OverflowScrollState::WaitAtEnd:
+				if (m_OverflowScrollTimer.GetRealTimeLimitMS() == -1) {
+					m_OverflowScrollTimer.SetRealTimeLimitMS(1000);
+					m_OverflowScrollTimer.Reset();
+				} else if (m_OverflowScrollTimer.IsPastRealTimeLimit()) {
+					m_OverflowScrollTimer.SetRealTimeLimitMS(-1);
+					m_OverflowScrollState = OverflowScrollState::WaitAtStart;
+					m_OverflowScrollRedrawTime = 0;
 					break;
-			}
+				}
+				m_OverflowScrollOffsetX = modifyXPos ? (textFullWidth - m_Width) : 0;
+				m_OverflowScrollOffsetY = modifyYPos ? (textFullHeight - m_Height) : 0;
+				m_OverflowScrollRedrawTime = m_OverflowScrollTimer.GetRealTimeLimitMS();
+				break;
+			default:
+				GUIAbort("Invalid GUILabel overflow scroll state " + static_cast<int>(m_OverflowScrollState));
+				break;
 		}
-		m_Font->DrawAligned(Bitmap, xPos, yPos, m_Text, m_HorizontalOverflowScroll && textFullWidth > m_Width ? GUIFont::Left : m_HAlignment, m_VerticalOverflowScroll && textFullHeight > m_Height ? GUIFont::Top : m_VAlignment, m_HorizontalOverflowScroll ? textFullWidth : m_Width, m_FontShadow);
 	}
-
-	Bitmap->SetClipRect(nullptr);
+	// Text that fits never moves, so there's nothing to come back for
+	if (!modifyXPos && !modifyYPos) { m_OverflowScrollRedrawTime = -1; }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -284,7 +341,18 @@ void GUILabel::ActivateDeactivateOverflowScroll(bool activateScroll) {
 	if (OverflowScrollIsEnabled() && activateScroll != OverflowScrollIsActivated()) {
 		m_OverflowScrollState = activateScroll ? OverflowScrollState::WaitAtStart : OverflowScrollState::Deactivated;
 		m_OverflowScrollTimer.SetRealTimeLimitMS(-1);
+		m_OverflowScrollRedrawTime = 0;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double GUILabel::GetOverflowScrollRedrawDelay() const {
+	if (!OverflowScrollIsActivated() || m_OverflowScrollRedrawTime < 0) {
+		return -1;
 	}
+	// The redraw time is relative to the scroll timer, which only gets reset when the label is drawn, so it stays valid until then
+	return std::max(m_OverflowScrollRedrawTime - m_OverflowScrollTimer.GetElapsedRealTimeMS(), 0.0);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
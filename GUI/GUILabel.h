@@ -80,6 +80,15 @@ public:
     void Draw(GUIBitmap *Bitmap, bool overwiteFontColorAndKerning = true);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PrepareDraw
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Moves the overflow scrolling text on before drawing in tiles.
+// Arguments:       Screen class
+
+    void PrepareDraw(GUIScreen *Screen) override;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:  OnMouseDown
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -161,7 +170,7 @@ public:
 // Description:     Sets the text of the label.
 // Arguments:       text.
 
-    void SetText(const std::string_view &text) { m_Text = text; }
+    void SetText(const std::string_view &text) { if (m_Text != text) { m_Text = text; Invalidate(); } }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -189,7 +198,7 @@ public:
 // Description:     Sets the horizontal alignment of the text of this label.
 // Arguments:       The desired alignment.
 
-    void SetHAlignment(int HAlignment = GUIFont::Left) { m_HAlignment = HAlignment; }
+    void SetHAlignment(int HAlignment = GUIFont::Left) { m_HAlignment = HAlignment; Invalidate(); }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -198,7 +207,7 @@ public:
 // Description:     Sets the vertical alignment of the text of this label.
 // Arguments:       The desired alignment.
 
-    void SetVAlignment(int VAlignment = GUIFont::Top) { m_VAlignment = VAlignment; }
+    void SetVAlignment(int VAlignment = GUIFont::Top) { m_VAlignment = VAlignment; Invalidate(); }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -260,6 +269,12 @@ public:
     /// <param name="activateScroll">Whether the overflow scrolling should activate (true) or deactivate (false).</param>
     void ActivateDeactivateOverflowScroll(bool activateScroll);
 
+    /// <summary>
+    /// Gets how long until the overflow scrolling text next needs drawing to keep moving. Only up to date after the GUILabel has been drawn.
+    /// </summary>
+    /// <returns>The time left in milliseconds, 0 if it's due now, or -1 if the text isn't going to move.</returns>
+    double GetOverflowScrollRedrawDelay() const;
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          StoreProperties
@@ -287,6 +302,16 @@ private:
     bool m_VerticalOverflowScroll;
     OverflowScrollState m_OverflowScrollState;
     Timer m_OverflowScrollTimer;
+    double m_OverflowScrollRedrawTime; //!< When the scrolling text next moves, in m_OverflowScrollTimer milliseconds. -1 if it isn't going to.
+    int m_OverflowScrollOffsetX; //!< How far the overflowing text is scrolled left, as of the last UpdateOverflowScroll.
+    int m_OverflowScrollOffsetY; //!< How far the overflowing text is scrolled up, as of the last UpdateOverflowScroll.
+
+    /// <summary>
+    /// Advances the overflow scrolling and works out how far the text is scrolled and when it next moves.
+    /// </summary>
+    /// <param name="textFullWidth">The width of the text if scrolling horizontally, otherwise 0.</param>
+    /// <param name="textFullHeight">The height of the text if scrolling vertically, otherwise 0.</param>
+    void UpdateOverflowScroll(int textFullWidth, int textFullHeight);
 };
 };
 #endif
\ No newline at end of file
@@ -32,6 +32,8 @@ GUIListPanel::GUIListPanel(GUIManager *Manager) : GUIPanel(Manager) {
 	m_AlternateDrawMode = false;
 	m_LoopSelectionScroll = false;
 	m_MouseScroll = false;
+	m_ItemStackHeights.assign(1, 0);
+	m_ItemStackHeightsDirty = false;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -61,6 +63,8 @@ GUIListPanel::GUIListPanel() : GUIPanel() {
 	m_AlternateDrawMode = false;
 	m_LoopSelectionScroll = false;
 	m_MouseScroll = false;
+	m_ItemStackHeights.assign(1, 0);
+	m_ItemStackHeightsDirty = false;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -105,6 +109,8 @@ void GUIListPanel::Destroy() {
 		if (I) { delete I; }
 	}
 	m_Items.clear();
+	m_ItemStackHeights.assign(1, 0);
+	m_ItemStackHeightsDirty = false;
 
 
 	// Destroy the horizontal scroll panel
@@ -155,6 +161,8 @@ void GUIListPanel::ClearList() {
 	}
 
 	m_Items.clear();
+	m_ItemStackHeights.assign(1, 0);
+	m_ItemStackHeightsDirty = false;
 
 	m_SelectedList.clear();
 
@@ -179,6 +187,7 @@ void GUIListPanel::AddItem(const std::string &Name, const std::string &rightText
 	I->m_ID = m_Items.size();
 
 	m_Items.push_back(I);
+	if (!m_ItemStackHeightsDirty) { m_ItemStackHeights.push_back(m_ItemStackHeights.back() + I->m_Height); }
 
 	// Calculate the largest width
 	if (m_Font) {
@@ -186,6 +195,11 @@ void GUIListPanel::AddItem(const std::string &Name, const std::string &rightText
 		m_LargestWidth = std::max(m_LargestWidth, FWidth);
 	}
 
+	// Everything gets updated at once when the update is unlocked
+	if (m_UpdateLocked) {
+		return;
+	}
+
 	// Adjust the scrollbars
 	AdjustScrollbars();
 	ScrollToItem(I);
@@ -214,6 +228,8 @@ void GUIListPanel::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIListPanel::BuildBitmap(bool UpdateBase, bool UpdateText) {
+	Invalidate();
+
 	// Gotta update the text if updating the base
 	if (UpdateBase)
 		UpdateText = true;
@@ -253,6 +269,8 @@ void GUIListPanel::BuildBitmap(bool UpdateBase, bool UpdateText) {
 		// Load the font
 		m_Skin->GetValue("Listbox", "Font", &Filename);
 		m_Font = m_Skin->GetFont(Filename);
+		// Item heights depend on the font
+		m_ItemStackHeightsDirty = true;
 		m_Skin->GetValue("Listbox", "FontColor", &m_FontColor);
 		m_Skin->GetValue("Listbox", "FontShadow", &m_FontShadow);
 		m_Skin->GetValue("Listbox", "FontKerning", &m_FontKerning);
@@ -263,11 +281,13 @@ void GUIListPanel::BuildBitmap(bool UpdateBase, bool UpdateText) {
 		m_Font->CacheColor(m_FontColor);
 		m_Font->CacheColor(m_FontSelectColor);
 
-		// Build only the background                                                 BG   Frame
-		m_Skin->BuildStandardRect(m_BaseBitmap, "Listbox", 0, 0, m_Width, m_Height, true, false);
+		const GUISkin::SkinSection *ListboxSection = m_Skin->GetSection("Listbox");
+
+		// Build only the background                                                        BG   Frame
+		m_Skin->BuildStandardRect(m_BaseBitmap, ListboxSection, 0, 0, m_Width, m_Height, true, false);
 
 		// Now build only the frame, and draw it on top of the 'text' layer later
-		m_Skin->BuildStandardRect(m_FrameBitmap, "Listbox", 0, 0, m_Width, m_Height, false, true);
+		m_Skin->BuildStandardRect(m_FrameBitmap, ListboxSection, 0, 0, m_Width, m_Height, false, true);
 	}
 
 	if (UpdateText) {
@@ -289,20 +309,16 @@ void GUIListPanel::BuildDrawBitmap() {
 	int Height = m_Height;
 	if (m_HorzScroll->_GetVisible()) { Height -= m_HorzScroll->GetHeight(); }
 
+	// Only draw the items from the scroll value onwards, skipping straight to the first visible one
+	UpdateItemStackHeights();
+	Count = GetFirstVisibleItemIndex();
+
 	int x = m_HorzScroll->GetValue();
-	int y = 1 + (m_VertScroll->_GetVisible() ? -m_VertScroll->GetValue() : 0);
-	int stackHeight = 0;
+	int y = 1 + (m_VertScroll->_GetVisible() ? -m_VertScroll->GetValue() : 0) + m_ItemStackHeights[Count];
 	int thirdWidth = m_Width / 3;
 
-	// Go through each item
-	for (it = m_Items.begin(); it != m_Items.end(); it++, Count++) {
-		stackHeight += GetItemHeight(*it);
-		// Only draw the items after the scroll value
-		if (m_VertScroll->_GetVisible() && stackHeight < m_VertScroll->GetValue()) {
-			y += GetItemHeight(*it);
-			continue;
-		}
-
+	// Go through each visible item
+	for (it = m_Items.begin() + Count; it != m_Items.end(); it++, Count++) {
 		Item *I = *it;
 
 		// Alternate drawing mode
@@ -359,7 +375,10 @@ void GUIListPanel::BuildDrawBitmap() {
 			if (it == m_Items.end() - 1) { m_DrawBitmap->DrawLine(4, y + itemHeight + 1, m_Width - 5, y + itemHeight + 1, 144); }
 
 			// Save the item height for later use in selection routines etc
-			I->m_Height = itemHeight;
+			if (I->m_Height != itemHeight) {
+				I->m_Height = itemHeight;
+				m_ItemStackHeightsDirty = true;
+			}
 			y += itemHeight;
 		} else {
 			// Regular drawing
@@ -469,12 +488,15 @@ void GUIListPanel::SelectItem(int X, int Y, int Modifier) {
 	int Height = m_Height;
 	if (m_HorzScroll->_GetVisible()) { Height -= m_HorzScroll->GetHeight(); }
 
-	int y = m_Y + 1;
+	// Items above the visible region can't be under the mouse so start from the first visible one
+	UpdateItemStackHeights();
+	int Count = GetFirstVisibleItemIndex();
+
+	int y = m_Y + 1 + m_ItemStackHeights[Count];
 	if (m_VertScroll->_GetVisible())
 		y -= m_VertScroll->GetValue();
-	int Count = 0;
 	//int stackHeight = 0;
-	for (it = m_Items.begin(); it != m_Items.end(); it++, Count++) {
+	for (it = m_Items.begin() + Count; it != m_Items.end(); it++, Count++) {
 		/*
 		stackHeight += GetItemHeight(*it);
 		// Only check the items after the scroll value
@@ -992,10 +1014,13 @@ GUIListPanel::Item * GUIListPanel::GetItem(int X, int Y) {
 	int Height = m_Height;
 	if (m_HorzScroll->_GetVisible()) { Height -= m_HorzScroll->GetHeight(); }
 
-	int y = m_Y + 1;
+	// Items above the visible region can't be under the mouse so start from the first visible one
+	UpdateItemStackHeights();
+	int Count = GetFirstVisibleItemIndex();
+
+	int y = m_Y + 1 + m_ItemStackHeights[Count];
 	if (m_VertScroll->_GetVisible()) { y -= m_VertScroll->GetValue(); }
-	int Count = 0;
-	for (std::vector<Item *>::iterator it = m_Items.begin(); it != m_Items.end(); it++, Count++) {
+	for (std::vector<Item *>::iterator it = m_Items.begin() + Count; it != m_Items.end(); it++, Count++) {
 		Item *pItem = *it;
 
 		// Return the item under the mouse
@@ -1045,21 +1070,53 @@ int GUIListPanel::GetItemHeight(Item *pItem) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 int GUIListPanel::GetStackHeight(Item *pItem) {
-	int height = 0;
+	UpdateItemStackHeights();
 
-	for (std::vector<Item *>::iterator iitr = m_Items.begin(); iitr != m_Items.end(); ++iitr) {
-		if ((*iitr) == pItem) {
-			break;
-		}
-		height += GetItemHeight((*iitr));
+	if (!pItem) {
+		return m_ItemStackHeights.back();
 	}
-	return height;
+	// The item's ID is its index in the list, unless it was overwritten through SetItemValues
+	if (pItem->m_ID >= 0 && pItem->m_ID < m_Items.size() && m_Items[pItem->m_ID] == pItem) {
+		return m_ItemStackHeights[pItem->m_ID];
+	}
+	std::vector<Item *>::iterator itemPos = std::find(m_Items.begin(), m_Items.end(), pItem);
+	return m_ItemStackHeights[itemPos - m_Items.begin()];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIListPanel::UpdateItemStackHeights() {
+	if (!m_ItemStackHeightsDirty) {
+		return;
+	}
+	m_ItemStackHeights.resize(m_Items.size() + 1);
+	m_ItemStackHeights[0] = 0;
+	for (int i = 0; i < m_Items.size(); i++) {
+		m_ItemStackHeights[i + 1] = m_ItemStackHeights[i] + GetItemHeight(m_Items[i]);
+	}
+	m_ItemStackHeightsDirty = false;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int GUIListPanel::GetFirstVisibleItemIndex() {
+	if (!m_VertScroll->_GetVisible() || m_Items.empty()) {
+		return 0;
+	}
+	UpdateItemStackHeights();
+
+	// The first item whose bottom edge is at or past the scroll value
+	std::vector<int>::iterator firstVisible = std::lower_bound(m_ItemStackHeights.begin() + 1, m_ItemStackHeights.end(), m_VertScroll->GetValue());
+	return std::min(static_cast<int>(firstVisible - (m_ItemStackHeights.begin() + 1)), static_cast<int>(m_Items.size() - 1));
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIListPanel::SetItemValues(int Index, Item &item) {
-	if (Index >= 0 && Index < m_Items.size()) { *(m_Items.at(Index)) = item; }
+	if (Index >= 0 && Index < m_Items.size()) {
+		*(m_Items.at(Index)) = item;
+		m_ItemStackHeightsDirty = true;
+	}
 	BuildBitmap(false, true);
 }
 
@@ -1124,6 +1181,7 @@ void GUIListPanel::DeleteItem(int Index) {
 		// Delete and remove it
 		delete *(m_Items.begin() + Index);
 		m_Items.erase(m_Items.begin() + Index);
+		m_ItemStackHeightsDirty = true;
 
 		// Reset the id's
 		std::vector<Item *>::iterator it;
@@ -256,6 +256,8 @@ public:
 // Method:          BeginUpdate
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Locks the control from updating every time a new item is added.
+//                  Use when adding many items at once so the scrollbars and bitmap are
+//                  only rebuilt once, on EndUpdate.
 // Arguments:       None.
 
     void BeginUpdate();
@@ -401,7 +403,7 @@ public:
 //                  rectangles, etc
 // Arguments:       The new mode setting.
 
-    void SetAlternateDrawMode(bool enableAltDrawMode = true) { m_AlternateDrawMode = enableAltDrawMode; }
+    void SetAlternateDrawMode(bool enableAltDrawMode = true) { m_AlternateDrawMode = enableAltDrawMode; m_ItemStackHeightsDirty = true; }
 
 
 
@@ -556,6 +558,9 @@ private:
 	std::vector<Item *> m_SelectedList;
 	unsigned long m_SelectedColorIndex;
 
+	std::vector<int> m_ItemStackHeights; //!< Running totals of the item heights. Entry N is the combined height of all the items before item N, the last entry is the height of the whole stack.
+	bool m_ItemStackHeightsDirty; //!< Whether item heights were changed and the running totals need recalculating.
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          BuildDrawBitmap
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -565,6 +570,25 @@ private:
     void BuildDrawBitmap();
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          UpdateItemStackHeights
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Recalculates the running totals of the item heights if they are dirty.
+// Arguments:       None.
+
+    void UpdateItemStackHeights();
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetFirstVisibleItemIndex
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the index of the first item that is at least partially visible
+//                  with the current vertical scroll value.
+// Arguments:       None.
+
+    int GetFirstVisibleItemIndex();
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          AdjustScrollbars
 //////////////////////////////////////////////////////////////////////////////////////////
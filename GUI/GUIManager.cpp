@@ -9,6 +9,15 @@ GUIManager::GUIManager(GUIInput *input) {
 	m_Input = input;
 	m_MouseEnabled = true;
 	m_UseValidation = false;
+	m_DirtyRectOffsetX = 0;
+	m_DirtyRectOffsetY = 0;
+	m_DrawThreads = 1;
+	m_DrawingTiles = false;
+	m_DrawWorkFrame = 0;
+	m_DrawWorkersBusy = 0;
+	m_StopDrawWorkers = false;
+	m_DrawViewScreen = nullptr;
+	m_DrawViewBitmap = nullptr;
 
 	Clear();
 
@@ -26,6 +35,7 @@ GUIManager::GUIManager(GUIInput *input) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GUIManager::~GUIManager() {
+	StopDrawWorkers();
 	delete m_pTimer;
 	m_pTimer = nullptr;
 }
@@ -67,6 +77,7 @@ void GUIManager::AddPanel(GUIPanel *panel) {
 
 		// Add the panel to the list
 		m_PanelList.push_back(panel);
+		panel->Invalidate();
 	}
 }
 
@@ -134,11 +145,15 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 		// Mouse Up
 		if (Released != GUIPanel::MOUSE_NONE && CurPanel) {
 			CurPanel->OnMouseUp(MouseX, MouseY, Released, Mod);
+			CurPanel->Invalidate();
 		}
 
 		// Double click (on the mouse up)
 		if (Released != GUIPanel::MOUSE_NONE && m_DoubleClickButtons != GUIPanel::MOUSE_NONE) {
-			if (CurPanel) { CurPanel->OnDoubleClick(MouseX, MouseY, m_DoubleClickButtons, Mod); }
+			if (CurPanel) {
+				CurPanel->OnDoubleClick(MouseX, MouseY, m_DoubleClickButtons, Mod);
+				CurPanel->Invalidate();
+			}
 			m_LastMouseDown[0] = m_LastMouseDown[1] = m_LastMouseDown[2] = -99999.0f;
 		}
 
@@ -166,12 +181,17 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 			}
 
 			// OnMouseDown event
-			if (CurPanel) { CurPanel->OnMouseDown(MouseX, MouseY, Pushed, Mod); }
+			if (CurPanel) {
+				CurPanel->OnMouseDown(MouseX, MouseY, Pushed, Mod);
+				CurPanel->Invalidate();
+			}
 		}
 
 		// Mouse move
 		if ((DeltaX != 0 || DeltaY != 0) && CurPanel) {
 			CurPanel->OnMouseMove(MouseX, MouseY, Buttons, Mod);
+			// Plain mouse movement doesn't change how panels look, only dragging does
+			if (Buttons != GUIPanel::MOUSE_NONE || CurPanel->IsCaptured()) { CurPanel->Invalidate(); }
 		}
 
 		// Mouse Hover
@@ -182,6 +202,7 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 			if (m_HoverPanel && m_HoverPanel->PointInside(MouseX, MouseY)/*GetPanelID() == CurPanel->GetPanelID()*/) {
 				// call the OnMouseHover event
 				m_HoverPanel->OnMouseHover(MouseX, MouseY, Buttons, Mod);
+				m_HoverPanel->Invalidate();
 			}
 		}
 
@@ -197,12 +218,21 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 		}
 
 		// OnMouseEnter
-		if (Enter && CurPanel) { CurPanel->OnMouseEnter(MouseX, MouseY, Buttons, Mod); }
+		if (Enter && CurPanel) {
+			CurPanel->OnMouseEnter(MouseX, MouseY, Buttons, Mod);
+			CurPanel->Invalidate();
+		}
 
 		// OnMouseLeave
-		if (Leave &&m_MouseOverPanel) { m_MouseOverPanel->OnMouseLeave(MouseX, MouseY, Buttons, Mod); }
+		if (Leave &&m_MouseOverPanel) {
+			m_MouseOverPanel->OnMouseLeave(MouseX, MouseY, Buttons, Mod);
+			m_MouseOverPanel->Invalidate();
+		}
 
-		if (MouseWheelChange &&CurPanel) { CurPanel->OnMouseWheelChange(MouseX, MouseY, Mod, MouseWheelChange); }
+		if (MouseWheelChange &&CurPanel) {
+			CurPanel->OnMouseWheelChange(MouseX, MouseY, Mod, MouseWheelChange);
+			CurPanel->Invalidate();
+		}
 
 		m_MouseOverPanel = CurPanel;
 	}
@@ -228,16 +258,19 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 				case GUIInput::Pushed:
 					m_FocusPanel->OnKeyDown(i, Mod);
 					m_FocusPanel->OnKeyPress(i, Mod);
+					m_FocusPanel->Invalidate();
 					break;
 
 					// KeyUp
 				case GUIInput::Released:
 					m_FocusPanel->OnKeyUp(i, Mod);
+					m_FocusPanel->Invalidate();
 					break;
 
 					// KeyPress
 				case GUIInput::Repeat:
 					m_FocusPanel->OnKeyPress(i, Mod);
+					m_FocusPanel->Invalidate();
 					break;
 				default:
 					break;
@@ -249,19 +282,231 @@ void GUIManager::Update(bool ignoreKeyboardEvents) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIManager::Draw(GUIScreen *Screen) {
-	// Go through drawing panels that are invalid
+	// When using validation only the area set as the clipping rect is being repainted, so panels outside of it can be skipped
+	GUIRect DrawArea;
+	Screen->GetBitmap()->GetClipRect(&DrawArea);
+
+	if (m_DrawThreads > 1 && DrawTiles(Screen, DrawArea)) {
+		return;
+	}
+
 	std::vector<GUIPanel *>::iterator it;
 
 	for (it = m_PanelList.begin(); it != m_PanelList.end(); it++) {
 		GUIPanel *p = *it;
 
 		// Draw the panel
-		if ((!p->IsValid() || !m_UseValidation) && p->_GetVisible()) { p->Draw(Screen); }
+		if (p->_GetVisible() && (!m_UseValidation || RectsOverlap(*p->GetRect(), DrawArea))) { p->Draw(Screen); }
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIManager::DrawTiles(GUIScreen *Screen, const GUIRect &DrawArea) {
+	if (DrawArea.right < DrawArea.left || DrawArea.bottom < DrawArea.top) {
+		return false;
+	}
+	int TileColumns = (DrawArea.right - DrawArea.left) / c_DrawTileSize + 1;
+	int TileRows = (DrawArea.bottom - DrawArea.top) / c_DrawTileSize + 1;
+	int ThreadCount = std::min(m_DrawThreads, TileColumns * TileRows);
+	if (ThreadCount < 2) {
+		return false;
+	}
+
+	// Each thread draws through a view of the screen so it has clipping of its own. The views are made again if the screen or its bitmap changed since
+	GUIBitmap *ScreenBitmap = Screen->GetBitmap();
+	if (Screen != m_DrawViewScreen || ScreenBitmap != m_DrawViewBitmap || (!m_DrawViews.empty() && (m_DrawViews.front()->GetBitmap()->GetWidth() != ScreenBitmap->GetWidth() || m_DrawViews.front()->GetBitmap()->GetHeight() != ScreenBitmap->GetHeight()))) {
+		m_DrawViews.clear();
+		m_DrawViewScreen = Screen;
+		m_DrawViewBitmap = ScreenBitmap;
+	}
+	while (m_DrawViews.size() < static_cast<size_t>(ThreadCount)) {
+		m_DrawViews.emplace_back(Screen->CreateView());
+		if (!m_DrawViews.back()) {
+			m_DrawViews.clear();
+			return false;
+		}
+	}
+
+	// Bring the panels up to date on this thread, then record which ones overlap each tile, in drawing order
+	std::vector<std::vector<GUIPanel *>> TilePanels(TileColumns * TileRows);
+	for (GUIPanel *P : m_PanelList) {
+		if (!P->_GetVisible() || !RectsOverlap(*P->GetRect(), DrawArea)) {
+			continue;
+		}
+		P->PrepareDraw(Screen);
+
+		const GUIRect &Rect = *P->GetRect();
+		int FirstColumn = (std::max(Rect.left, DrawArea.left) - DrawArea.left) / c_DrawTileSize;
+		int LastColumn = (std::min(Rect.right, DrawArea.right) - DrawArea.left) / c_DrawTileSize;
+		int FirstRow = (std::max(Rect.top, DrawArea.top) - DrawArea.top) / c_DrawTileSize;
+		int LastRow = (std::min(Rect.bottom, DrawArea.bottom) - DrawArea.top) / c_DrawTileSize;
+		for (int Row = FirstRow; Row <= LastRow; Row++) {
+			for (int Column = FirstColumn; Column <= LastColumn; Column++) {
+				TilePanels[Row * TileColumns + Column].push_back(P);
+			}
+		}
+	}
+
+	// Threads take the next tile until there are none left, so they all keep busy even when some tiles have a lot more to draw than others
+	std::atomic<int> NextTile = 0;
+	auto DrawTileQueue = [&](int ViewIndex) {
+		GUIScreen *View = m_DrawViews[ViewIndex].get();
+		GUIFont::SetUseThreadPens(true);
+		for (int Tile = NextTile++; Tile < static_cast<int>(TilePanels.size()); Tile = NextTile++) {
+			if (TilePanels[Tile].empty()) {
+				continue;
+			}
+			GUIRect TileRect;
+			int Left = DrawArea.left + (Tile % TileColumns) * c_DrawTileSize;
+			int Top = DrawArea.top + (Tile / TileColumns) * c_DrawTileSize;
+			SetRect(&TileRect, Left, Top, std::min(Left + c_DrawTileSize - 1, static_cast<int>(DrawArea.right)), std::min(Top + c_DrawTileSize - 1, static_cast<int>(DrawArea.bottom)));
+			View->GetBitmap()->SetClipRect(&TileRect);
+
+			for (GUIPanel *P : TilePanels[Tile]) {
+				P->Draw(View);
+			}
+		}
+		GUIFont::SetUseThreadPens(false);
+	};
+
+	if (m_DrawWorkers.empty()) {
+		m_StopDrawWorkers = false;
+		m_DrawWorkFrame = 0;
+		for (int ViewIndex = 1; ViewIndex < m_DrawThreads; ViewIndex++) {
+			m_DrawWorkers.emplace_back(&GUIManager::DrawWorkerLoop, this, ViewIndex);
+		}
+	}
+	m_DrawingTiles = true;
+	{
+		std::lock_guard<std::mutex> DrawWorkLock(m_DrawWorkMutex);
+		// There can be fewer views in use than drawing threads when there are only a few tiles, the spare threads have nothing to do this frame
+		m_DrawWork = [&DrawTileQueue, ThreadCount](int ViewIndex) {
+			if (ViewIndex < ThreadCount) { DrawTileQueue(ViewIndex); }
+		};
+		m_DrawWorkersBusy = static_cast<int>(m_DrawWorkers.size());
+		m_DrawWorkFrame++;
+	}
+	m_DrawWorkReady.notify_all();
+	DrawTileQueue(0);
+	{
+		std::unique_lock<std::mutex> DrawWorkLock(m_DrawWorkMutex);
+		m_DrawWorkDone.wait(DrawWorkLock, [this]() { return m_DrawWorkersBusy == 0; });
+		m_DrawWork = nullptr;
+	}
+	m_DrawingTiles = false;
+
+	return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIManager::DrawWorkerLoop(int ViewIndex) {
+	int LastFrame = 0;
+	std::unique_lock<std::mutex> DrawWorkLock(m_DrawWorkMutex);
+	while (true) {
+		m_DrawWorkReady.wait(DrawWorkLock, [this, &LastFrame]() { return m_StopDrawWorkers || m_DrawWorkFrame != LastFrame; });
+		if (m_StopDrawWorkers) {
+			return;
+		}
+		LastFrame = m_DrawWorkFrame;
+
+		DrawWorkLock.unlock();
+		m_DrawWork(ViewIndex);
+		DrawWorkLock.lock();
+
+		if (--m_DrawWorkersBusy == 0) { m_DrawWorkDone.notify_one(); }
 	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GUIManager::StopDrawWorkers() {
+	{
+		std::lock_guard<std::mutex> DrawWorkLock(m_DrawWorkMutex);
+		m_StopDrawWorkers = true;
+	}
+	m_DrawWorkReady.notify_all();
+	for (std::thread &DrawWorker : m_DrawWorkers) {
+		DrawWorker.join();
+	}
+	m_DrawWorkers.clear();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIManager::SetDrawThreads(int Threads) {
+	int NewDrawThreads = Threads > 0 ? Threads : std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+	// The drawing threads are started again with the new count the next time tiles are drawn
+	if (NewDrawThreads != m_DrawThreads) { StopDrawWorkers(); }
+	m_DrawThreads = NewDrawThreads;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIManager::AddDirtyRect(const GUIRect &Rect) {
+	if (m_UseValidation && Rect.right >= Rect.left && Rect.bottom >= Rect.top) {
+		GUIRect ScreenRect;
+		SetRect(&ScreenRect, Rect.left + m_DirtyRectOffsetX, Rect.top + m_DirtyRectOffsetY, Rect.right + m_DirtyRectOffsetX, Rect.bottom + m_DirtyRectOffsetY);
+		std::lock_guard<std::mutex> DirtyRectLock(m_DirtyRectMutex);
+		m_DirtyRects.push_back(ScreenRect);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIManager::ScheduleDirtyRect(const GUIRect &Rect, double DelayMS) {
+	if (!m_UseValidation || Rect.right < Rect.left || Rect.bottom < Rect.top) {
+		return;
+	}
+	double DueTime = m_pTimer->GetElapsedRealTimeMS() + std::max(DelayMS, 0.0);
+	GUIRect ScreenRect;
+	SetRect(&ScreenRect, Rect.left + m_DirtyRectOffsetX, Rect.top + m_DirtyRectOffsetY, Rect.right + m_DirtyRectOffsetX, Rect.bottom + m_DirtyRectOffsetY);
+	std::lock_guard<std::mutex> DirtyRectLock(m_DirtyRectMutex);
+
+	// Panels reschedule every time they're drawn, so only keep one entry per area
+	for (std::pair<GUIRect, double> &Scheduled : m_ScheduledDirtyRects) {
+		const GUIRect &ScheduledRect = Scheduled.first;
+		if (ScheduledRect.left == ScreenRect.left && ScheduledRect.top == ScreenRect.top && ScheduledRect.right == ScreenRect.right && ScheduledRect.bottom == ScreenRect.bottom) {
+			Scheduled.second = std::min(Scheduled.second, DueTime);
+			return;
+		}
+	}
+	m_ScheduledDirtyRects.emplace_back(ScreenRect, DueTime);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double GUIManager::GetScheduledRepaintDelay() const {
+	if (m_ScheduledDirtyRects.empty()) {
+		return -1;
+	}
+	double FirstDueTime = m_ScheduledDirtyRects.front().second;
+	for (const std::pair<GUIRect, double> &Scheduled : m_ScheduledDirtyRects) {
+		FirstDueTime = std::min(FirstDueTime, Scheduled.second);
+	}
+	return std::max(FirstDueTime - m_pTimer->GetElapsedRealTimeMS(), 0.0);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const std::vector<GUIRect> & GUIManager::GetDirtyRects() {
+	if (!m_ScheduledDirtyRects.empty()) {
+		double CurTime = m_pTimer->GetElapsedRealTimeMS();
+		m_ScheduledDirtyRects.erase(std::remove_if(m_ScheduledDirtyRects.begin(), m_ScheduledDirtyRects.end(), [this, CurTime](const std::pair<GUIRect, double> &Scheduled) {
+			if (Scheduled.second > CurTime) {
+				return false;
+			}
+			m_DirtyRects.push_back(Scheduled.first);
+			return true;
+		}), m_ScheduledDirtyRects.end());
+	}
+	GUIUtil::MergeOverlappingRects(m_DirtyRects);
+	return m_DirtyRects;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void GUIManager::CaptureMouse(GUIPanel *Panel) {
 	assert(Panel);
 
@@ -341,17 +586,23 @@ void GUIManager::TrackMouseHover(GUIPanel *Pan, bool Enabled, int Delay) {
 	assert(Pan);
 	m_HoverTrack = Enabled;
 	m_HoverPanel = Pan;
-	if (m_HoverTrack) { m_HoverTime = m_pTimer->GetElapsedRealTimeMS() + ((float)Delay / 1000.0F); }
+	if (m_HoverTrack) { m_HoverTime = m_pTimer->GetElapsedRealTimeMS() + (float)Delay; }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIManager::SetFocus(GUIPanel *Pan) {
 	// Send the LoseFocus event to the old panel (if there is one)
-	if (m_FocusPanel) { m_FocusPanel->OnLoseFocus(); }
+	if (m_FocusPanel) {
+		m_FocusPanel->OnLoseFocus();
+		m_FocusPanel->Invalidate();
+	}
 
 	m_FocusPanel = Pan;
 
 	// Send the GainFocus event to the new panel
-	if (m_FocusPanel) { m_FocusPanel->OnGainFocus(); }
+	if (m_FocusPanel) {
+		m_FocusPanel->OnGainFocus();
+		m_FocusPanel->Invalidate();
+	}
 }
\ No newline at end of file
@@ -131,6 +131,125 @@ public:
     void SetFocus(GUIPanel *Pan);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SetUseValidation
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Enables or disables tracking of the screen areas that need repainting.
+//                  When disabled, invalidated panels don't record any dirty rectangles.
+// Arguments:       Whether to track dirty rectangles or not.
+
+    void SetUseValidation(bool useValidation) { m_UseValidation = useValidation; if (!m_UseValidation) { m_DirtyRects.clear(); m_ScheduledDirtyRects.clear(); } }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetUseValidation
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets whether the screen areas that need repainting are being tracked.
+// Arguments:       None.
+
+    bool GetUseValidation() const { return m_UseValidation; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          AddDirtyRect
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Marks an area of the screen as needing to be repainted. Does nothing
+//                  if validation isn't being used.
+// Arguments:       The screen area to repaint.
+
+    void AddDirtyRect(const GUIRect &Rect);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ScheduleDirtyRect
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Marks an area of the screen as needing to be repainted once some time
+//                  has passed, so animating panels don't have to repaint every frame.
+//                  Scheduling the same area again keeps whichever time comes first.
+//                  Does nothing if validation isn't being used.
+// Arguments:       The screen area to repaint, Delay (milliseconds).
+
+    void ScheduleDirtyRect(const GUIRect &Rect, double DelayMS);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetScheduledRepaintDelay
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how long until the next scheduled area is due for repainting.
+// Arguments:       None.
+// Returns:         The time left in milliseconds, 0 if one is already due, or -1 if
+//                  nothing is scheduled.
+
+    double GetScheduledRepaintDelay() const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetDirtyRects
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the screen areas that need repainting since the last time the
+//                  list was cleared, including scheduled ones that are now due.
+//                  Overlapping areas are merged together.
+// Arguments:       None.
+
+    const std::vector<GUIRect> & GetDirtyRects();
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          ClearDirtyRects
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Clears the list of screen areas that need repainting. Should be
+//                  called once the areas were repainted.
+// Arguments:       None.
+
+    void ClearDirtyRects() { m_DirtyRects.clear(); }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          OffsetDirtyRects
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Shifts the areas passed to AddDirtyRect and ScheduleDirtyRect from now
+//                  on, for while panels are moved away from their place on the screen to
+//                  be drawn somewhere else. Calls add up, so undo with the opposite offset.
+// Arguments:       The amount to shift the areas by on the X and Y axis.
+
+    void OffsetDirtyRects(int X, int Y) { m_DirtyRectOffsetX += X; m_DirtyRectOffsetY += Y; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SetDrawThreads
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets how many threads draw the panels. With more than one, the area
+//                  being drawn is split into tiles and the panels overlapping each tile
+//                  are drawn into it in parallel, clipped to the tile, after PrepareDraw
+//                  is called on them. The result is the same as drawing on one thread as
+//                  long as panels draw within their rectangles. Drawing stays on one
+//                  thread with screens that can't make views of themselves. The extra
+//                  threads and the views they draw through are kept between frames.
+// Arguments:       The number of threads, including the calling one. 0 uses one per
+//                  hardware thread.
+
+    void SetDrawThreads(int Threads);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetDrawThreads
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how many threads draw the panels.
+// Arguments:       None.
+
+    int GetDrawThreads() const { return m_DrawThreads; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsDrawingTiles
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets whether the panels are being drawn in tiles on several threads
+//                  right now, so Draw must leave the panels as PrepareDraw left them.
+// Arguments:       None.
+
+    bool IsDrawingTiles() const { return m_DrawingTiles; }
+
+
 private:
 
 	std::vector<GUIPanel *> m_PanelList;
@@ -154,8 +273,33 @@ private:
 	float m_HoverTime;
 
 	bool m_UseValidation;
+	std::vector<GUIRect> m_DirtyRects; // Screen areas that need repainting, only tracked when using validation.
+	std::vector<std::pair<GUIRect, double>> m_ScheduledDirtyRects; // Screen areas to add to the dirty ones once m_pTimer reaches their time in milliseconds.
+	int m_DirtyRectOffsetX; // Added to the X of the areas marked for repainting, see OffsetDirtyRects.
+	int m_DirtyRectOffsetY; // Added to the Y of the areas marked for repainting, see OffsetDirtyRects.
+	std::mutex m_DirtyRectMutex; // Guards adding to the dirty rect lists, since panels drawn in tiles can invalidate themselves from several threads at once.
 	int m_UniqueIDCount;
 
+	// Tiles are square, big enough that each one is worth handing to a thread but small enough to spread the panels evenly over the threads.
+	static constexpr int c_DrawTileSize = 128;
+	int m_DrawThreads; // How many threads draw the panels, including the one calling Draw.
+	bool m_DrawingTiles; // Whether the panels are being drawn in tiles on several threads right now.
+
+	// The threads that draw tiles alongside the one calling Draw are started the first time tiles are drawn and wait for the next frame in between.
+	std::vector<std::thread> m_DrawWorkers;
+	std::function<void(int)> m_DrawWork; // What the drawing threads do for the frame being drawn, given the index of their view.
+	int m_DrawWorkFrame; // Goes up by one every time a frame is handed to the drawing threads.
+	int m_DrawWorkersBusy; // How many drawing threads haven't finished the frame yet.
+	bool m_StopDrawWorkers; // Tells the drawing threads to return.
+	std::mutex m_DrawWorkMutex; // Guards the members above between Draw and the drawing threads.
+	std::condition_variable m_DrawWorkReady; // Wakes the drawing threads when there's a frame to draw or they should stop.
+	std::condition_variable m_DrawWorkDone; // Wakes Draw when the last drawing thread is done with the frame.
+
+	// Views of the screen, one per drawing thread, kept for as long as tiles are drawn onto the same screen bitmap.
+	std::vector<std::unique_ptr<GUIScreen>> m_DrawViews;
+	GUIScreen *m_DrawViewScreen; // The screen m_DrawViews were made from.
+	GUIBitmap *m_DrawViewBitmap; // The bitmap of that screen at the time.
+
 	Timer *m_pTimer;
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -186,6 +330,38 @@ private:
 
     bool MouseInRect(const GUIRect *Rect, int X, int Y);
 
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawTiles
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Draws the panels overlapping an area in tiles on m_DrawThreads threads.
+// Arguments:       Screen, The area to draw, which the screen is clipped to.
+// Returns:         Whether the panels were drawn. False if the area is too small to split
+//                  or the screen can't make views of itself.
+
+    bool DrawTiles(GUIScreen *Screen, const GUIRect &DrawArea);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          DrawWorkerLoop
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Runs on each drawing thread. Waits for a frame, does the thread's share
+//                  of m_DrawWork and waits again, until told to stop.
+// Arguments:       The view index the thread draws through. 0 is used by the thread
+//                  calling Draw, so these start at 1.
+
+    void DrawWorkerLoop(int ViewIndex);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          StopDrawWorkers
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Stops and joins the drawing threads. They're started again the next
+//                  time tiles are drawn.
+// Arguments:       None.
+
+    void StopDrawWorkers();
+
 };
 };
 #endif
\ No newline at end of file
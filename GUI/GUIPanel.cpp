@@ -26,6 +26,7 @@ void GUIPanel::Clear() {
 	m_Y = 0;
 	m_Width = 0;
 	m_Height = 0;
+	SetRect(&m_Rect, 0, 0, 0, 0);
 	m_ID = -1;
 	m_GotFocus = false;
 	m_Captured = false;
@@ -40,6 +41,10 @@ void GUIPanel::Clear() {
 	m_SignalTarget = this;
 	m_ZPos = 0;
 
+	m_ChildGrid.Clear();
+	m_ChildLayoutVersion = 1;
+	m_ChildGridVersion = 0;
+
 	m_Font = nullptr;
 	m_FontColor = 0;
 	m_FontShadow = 0;
@@ -96,6 +101,8 @@ void GUIPanel::AddChild(GUIPanel *child, bool convertToAbsolutePos) {
 
 		// Add the child to the list
 		m_Children.push_back(child);
+		m_ChildLayoutVersion++;
+		child->Invalidate();
 	}
 }
 
@@ -108,7 +115,9 @@ void GUIPanel::RemoveChild(const GUIPanel *pChild) {
 	for (std::vector<GUIPanel *>::iterator itr = m_Children.begin(); itr != m_Children.end(); itr++) {
 		const GUIPanel *pPanel = *itr;
 		if (pPanel && pPanel == pChild) {
+			(*itr)->Invalidate();
 			m_Children.erase(itr);
+			m_ChildLayoutVersion++;
 			break;
 		}
 	}
@@ -132,6 +141,27 @@ void GUIPanel::LoadProperties(GUIProperties *Props) {
 
 void GUIPanel::Invalidate() {
 	m_ValidRegion = false;
+
+	if (m_Visible) {
+		// Let this panel and everything above it know so any cached drawing of them gets redone
+		for (GUIPanel *P = this; P; P = P->m_Parent) {
+			P->OnSubtreeInvalidated();
+		}
+		// Let the manager know which area of the screen needs repainting
+		if (m_Manager) { m_Manager->AddDirtyRect(*GetRect()); }
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIPanel::InvalidateAfter(double DelayMS) {
+	if (m_Visible) {
+		// The panel will look different by the time the area is repainted, so cached drawings of it can't be reused
+		for (GUIPanel *P = this; P; P = P->m_Parent) {
+			P->OnSubtreeInvalidated();
+		}
+		if (m_Manager) { m_Manager->ScheduleDirtyRect(*GetRect(), DelayMS); }
+	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -143,30 +173,63 @@ bool GUIPanel::IsValid() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::Draw(GUIScreen *Screen) {
-	// Validate this panel
-	m_ValidRegion = true;
+	// Validate this panel. Prepared panels already are, and aren't written to since other threads may be drawing them too
+	if (!m_ValidRegion) { m_ValidRegion = true; }
 
-	// Calculate this panel's clipping region - set the clipping rect to be the intersection of what
-	// was already set by the parent, and the dimensions of this panel.
-	Screen->GetBitmap()->AddClipRect(GetRect());
-	// Now save this intersection clipping rect so we can re-set it before each new child is drawn
-	GUIRect thisClip;
-	Screen->GetBitmap()->GetClipRect(&thisClip);
+	if (m_Children.empty()) {
+		return;
+	}
+
+	// Work out this panel's clipping region in software - the intersection of what was already set by the parent, and the dimensions of this panel.
+	// The bitmap's clipping rect is only changed when a child actually gets drawn, and children entirely outside the region are skipped.
+	GUIClipStack &ClipStack = Screen->GetClipStack();
+	ClipStack.Push(Screen->GetBitmap(), *GetRect());
 
 	// Draw children
 	std::vector<GUIPanel *>::iterator it;
 	for (it = m_Children.begin(); it != m_Children.end(); it++) {
 		GUIPanel *P = *it;
 
-		if (P->_GetVisible()) {
-			// Re-set the clipping rect of this panel since the last child has messed with it
-			Screen->GetBitmap()->SetClipRect(&thisClip);
+		if (P->_GetVisible() && ClipStack.IsVisible(*P->GetRect())) {
+			ClipStack.Apply(Screen->GetBitmap());
 			P->Draw(Screen);
 		}
 	}
 
-	// Get rid of the clipping rect since the parent will re-set it if necessary
-	Screen->GetBitmap()->SetClipRect(nullptr);
+	// Restore the clipping rect to what it was so drawing stays confined to the region being repainted
+	ClipStack.Pop(Screen->GetBitmap());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIPanel::PrepareDraw(GUIScreen *Screen) {
+	m_ValidRegion = true;
+	GetRect();
+
+	std::vector<GUIPanel *>::iterator it;
+	for (it = m_Children.begin(); it != m_Children.end(); it++) {
+		GUIPanel *P = *it;
+
+		if (P->_GetVisible()) { P->PrepareDraw(Screen); }
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GUIPanel::IsDrawingTiles() const {
+	return m_Manager && m_Manager->IsDrawingTiles();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIPanel::OffsetSubtree(int DX, int DY) {
+	m_X += DX;
+	m_Y += DY;
+
+	std::vector<GUIPanel *>::iterator it;
+	for (it = m_Children.begin(); it != m_Children.end(); it++) {
+		(*it)->OffsetSubtree(DX, DY);
+	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -244,11 +307,12 @@ GUIPanel * GUIPanel::BottomPanelUnderPoint(int x, int y) {
 		return nullptr;
 	}
 
-	// Go through the children
+	// Go through the children that may be under the point
 	GUIPanel *CurPanel = nullptr;
-	std::vector<GUIPanel *>::iterator it;
-	for (it = m_Children.begin(); it != m_Children.end(); it++) {
-		GUIPanel *P = *it;
+	const std::vector<int> &Candidates = GetChildrenAtPoint(x, y);
+	std::vector<int>::const_iterator it;
+	for (it = Candidates.begin(); it != Candidates.end(); it++) {
+		GUIPanel *P = m_Children[*it];
 		if (P) {
 			CurPanel = P->BottomPanelUnderPoint(x, y);
 			if (CurPanel != nullptr) {
@@ -271,11 +335,12 @@ GUIPanel * GUIPanel::TopPanelUnderPoint(int x, int y) {
 		return nullptr;
 	}
 
-	// Go through the children
+	// Go through the children that may be under the point, topmost first
 	GUIPanel *CurPanel = nullptr;
-	std::vector<GUIPanel *>::reverse_iterator it;
-	for (it = m_Children.rbegin(); it != m_Children.rend(); it++) {
-		GUIPanel *P = *it;
+	const std::vector<int> &Candidates = GetChildrenAtPoint(x, y);
+	std::vector<int>::const_reverse_iterator it;
+	for (it = Candidates.rbegin(); it != Candidates.rend(); it++) {
+		GUIPanel *P = m_Children[*it];
 		if (P) {
 			CurPanel = P->TopPanelUnderPoint(x, y);
 			if (CurPanel != nullptr) {
@@ -290,6 +355,26 @@ GUIPanel * GUIPanel::TopPanelUnderPoint(int x, int y) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+const std::vector<int> & GUIPanel::GetChildrenAtPoint(int x, int y) {
+	if (m_ChildGridVersion != m_ChildLayoutVersion) {
+		std::vector<GUIRect> ChildRects(m_Children.size());
+		for (size_t i = 0; i < m_Children.size(); i++) {
+			const GUIPanel *P = m_Children[i];
+			// Missing children get an empty rect so they're never a candidate
+			if (P) {
+				SetRect(&ChildRects[i], P->m_X, P->m_Y, P->m_X + P->m_Width, P->m_Y + P->m_Height);
+			} else {
+				SetRect(&ChildRects[i], 0, 0, -1, -1);
+			}
+		}
+		m_ChildGrid.Build(ChildRects);
+		m_ChildGridVersion = m_ChildLayoutVersion;
+	}
+	return m_ChildGrid.GetCandidates(x, y);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 bool GUIPanel::PointInside(int X, int Y) {
 	// Can't be inside an invisible panel
 	if (!m_Visible) {
@@ -308,8 +393,12 @@ bool GUIPanel::PointInside(int X, int Y) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::SetSize(int Width, int Height) {
+	// Both the area we're leaving and the area we're taking up need repainting
+	Invalidate();
 	m_Width = Width;
 	m_Height = Height;
+	Invalidate();
+	LayoutChanged();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -318,8 +407,11 @@ void GUIPanel::SetPositionAbs(int X, int Y, bool moveChildren) {
 	int DX = X - m_X;
 	int DY = Y - m_Y;
 
+	Invalidate();
 	m_X = X;
 	m_Y = Y;
+	Invalidate();
+	LayoutChanged();
 
 	// Move children
 	if (moveChildren) {
@@ -340,8 +432,11 @@ void GUIPanel::SetPositionRel(int X, int Y) {
 	int DX = X - m_X;
 	int DY = Y - m_Y;
 
+	Invalidate();
 	m_X = X;
 	m_Y = Y;
+	Invalidate();
+	LayoutChanged();
 
 	// Move children
 	std::vector<GUIPanel *>::iterator it;
@@ -354,8 +449,12 @@ void GUIPanel::SetPositionRel(int X, int Y) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::MoveRelative(int dX, int dY) {
+	Invalidate();
+
 	m_X += dX;
 	m_Y += dY;
+	Invalidate();
+	LayoutChanged();
 
 	// Move children
 	std::vector<GUIPanel *>::iterator it;
@@ -380,7 +479,13 @@ void GUIPanel::CenterInParent(bool centerX, bool centerY) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::_SetVisible(bool Visible) {
+	if (m_Visible == Visible) {
+		return;
+	}
+	// Invalidate while visible so the area gets repainted whether we're being shown or hidden
+	Invalidate();
 	m_Visible = Visible;
+	Invalidate();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -392,7 +497,10 @@ bool GUIPanel::_GetVisible() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPanel::_SetEnabled(bool Enabled) {
-	m_Enabled = Enabled;
+	if (m_Enabled != Enabled) {
+		m_Enabled = Enabled;
+		Invalidate();
+	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -416,7 +524,8 @@ int GUIPanel::GetHeight() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GUIRect * GUIPanel::GetRect() {
-	SetRect(&m_Rect, m_X, m_Y, m_X + m_Width, m_Y + m_Height);
+	// Only written when the panel changed, so panels being drawn by several threads at once, which PrepareDraw brought up to date, are only read
+	if (m_Rect.left != m_X || m_Rect.top != m_Y || m_Rect.right != m_X + m_Width || m_Rect.bottom != m_Y + m_Height) { SetRect(&m_Rect, m_X, m_Y, m_X + m_Width, m_Y + m_Height); }
 
 	return &m_Rect;
 }
@@ -444,6 +553,12 @@ void GUIPanel::TrackMouseHover(bool Enabled, int Delay) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GUIPanel::LayoutChanged() {
+	if (m_Parent) { m_Parent->m_ChildLayoutVersion++; }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void GUIPanel::SetFocus() {
 	m_Manager->SetFocus(this);
 }
@@ -558,6 +673,10 @@ void GUIPanel::_ChangeZ(GUIPanel *Child, int Type) {
 			break;
 	}
 
+	// The child is now drawn in a different order relative to its siblings
+	Child->Invalidate();
+	m_ChildLayoutVersion++;
+
 	// Go through and re-order the Z positions
 	Count = 0;
 	for (it = m_Children.begin(); it != m_Children.end(); it++, Count++) {
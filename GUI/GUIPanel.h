@@ -86,6 +86,18 @@ public:
     GUIPanel *TopPanelUnderPoint(int x, int y);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetChildrenAtPoint
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets the children that may be under a point, using a grid that is
+//                  rebuilt only when the children's layout changes.
+// Arguments:       X, Y Coordinates of point
+// Return value:    Indices into the children list in Z order, bottom first. Includes every
+//                  child under the point but may include others too.
+
+    const std::vector<int> & GetChildrenAtPoint(int x, int y);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          AddChild
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -125,12 +137,35 @@ public:
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          Invalidate
 //////////////////////////////////////////////////////////////////////////////////////////
-// Description:     Invalidates the panel
+// Description:     Invalidates the panel and marks the area it covers on the screen as dirty
+//                  so it gets repainted on the next frame.
 // Arguments:       None.
 
     void Invalidate();
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          InvalidateAfter
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Schedules the area the panel covers on the screen to be marked as
+//                  dirty once some time has passed. Used by animating panels to come
+//                  back when they next change instead of repainting every frame.
+// Arguments:       Delay (milliseconds).
+
+    void InvalidateAfter(double DelayMS);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetChildLayoutVersion
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets a counter that changes whenever a child of this panel is added,
+//                  removed, reordered, moved or resized.
+// Arguments:       None.
+// Returns:         The layout version of this panel's children.
+
+    unsigned int GetChildLayoutVersion() const { return m_ChildLayoutVersion; }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          IsValid
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -149,6 +184,19 @@ public:
     virtual void Draw(GUIScreen *Screen);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Virtual Method:  PrepareDraw
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Called on every visible panel before the manager draws them in tiles,
+//                  where Draw can run on several threads at once and so mustn't change
+//                  the panel. Anything Draw would otherwise update, like rebuilt bitmaps
+//                  or animation state, should be brought up to date here. Prepares the
+//                  visible children by default.
+// Arguments:       Screen class
+
+    virtual void PrepareDraw(GUIScreen *Screen);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Virtual Method:  OnMouseDown
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -345,7 +393,7 @@ public:
 // Description:     Sets the font this panel will be using
 // Arguments:       The new font, ownership is NOT transferred!
 
-    virtual void SetFont(GUIFont *pFont) { m_Font = pFont; m_ValidRegion = false; }
+    virtual void SetFont(GUIFont *pFont) { m_Font = pFont; Invalidate(); }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -621,6 +669,49 @@ protected:
     void TrackMouseHover(bool Enabled, int Delay);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          LayoutChanged
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Lets the parent know this panel was moved or resized so its hit
+//                  testing grid gets rebuilt. Needed whenever the position or size
+//                  members are changed directly.
+// Arguments:       None.
+
+    void LayoutChanged();
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IsDrawingTiles
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets whether the manager is drawing in tiles on several threads right
+//                  now, in which case Draw must leave the panel as PrepareDraw left it.
+// Arguments:       None.
+
+    bool IsDrawingTiles() const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Virtual Method:  OnSubtreeInvalidated
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Called when this panel or any visible panel under it gets invalidated,
+//                  so anything caching how they look can be dropped. Does nothing by
+//                  default.
+// Arguments:       None.
+
+    virtual void OnSubtreeInvalidated() {}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          OffsetSubtree
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Moves this panel and all the panels under it without invalidating or
+//                  changing the layout, to draw them somewhere other than the screen for
+//                  a moment. Has to be undone with the opposite offset straight after.
+// Arguments:       The amount to move by on the X and Y axis.
+
+    void OffsetSubtree(int DX, int DY);
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          _ChangeZ
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -665,6 +756,10 @@ protected:
 		bool m_ValidRegion;
 		int m_ZPos;
 
+		GUIHitGrid m_ChildGrid; // Hit testing grid over the children
+		unsigned int m_ChildLayoutVersion; // Changes whenever a child is added, removed, reordered, moved or resized
+		unsigned int m_ChildGridVersion; // The layout version the child grid was built for
+
 		GUIPanel *m_SignalTarget;
 };
 };
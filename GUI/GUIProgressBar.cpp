@@ -102,6 +102,8 @@ void GUIProgressBar::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIProgressBar::BuildBitmap() {
+	Invalidate();
+
 	// Free any old bitmaps
 	if (m_DrawBitmap) {
 		m_DrawBitmap->Destroy();
@@ -176,11 +178,13 @@ void GUIProgressBar::Draw(GUIScreen *Screen) {
 	}
 	if (m_IndicatorImage->GetWidth() + m_Spacing > 0) { Count = Count / (float)(m_IndicatorImage->GetWidth() + m_Spacing); }
 
-	// Setup the clipping
+	// Setup the clipping, keeping within the area already being clipped to
+	GUIRect PrevClip;
+	Screen->GetBitmap()->GetClipRect(&PrevClip);
 	GUIRect Rect = *GetRect();
 	Rect.left++;
 	Rect.right -= 2;
-	Screen->GetBitmap()->SetClipRect(&Rect);
+	Screen->GetBitmap()->AddClipRect(&Rect);
 
 	int x = m_X + 2;
 	int Limit = (int)ceil(Count);
@@ -189,7 +193,7 @@ void GUIProgressBar::Draw(GUIScreen *Screen) {
 		x += m_IndicatorImage->GetWidth() + m_Spacing;
 	}
 
-	Screen->GetBitmap()->SetClipRect(nullptr);
+	Screen->GetBitmap()->SetClipRect(&PrevClip);
 
 	GUIPanel::Draw(Screen);
 }
@@ -253,6 +257,8 @@ void GUIProgressBar::StoreProperties() {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIProgressBar::SetValue(int Value) {
+	Invalidate();
+
 	int OldValue = m_Value;
 	m_Value = Value;
 
@@ -273,6 +279,8 @@ int GUIProgressBar::GetValue() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIProgressBar::SetMinimum(int Minimum) {
+	Invalidate();
+
 	m_Minimum = Minimum;
 }
 
@@ -285,6 +293,8 @@ int GUIProgressBar::GetMinimum() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIProgressBar::SetMaximum(int Maximum) {
+	Invalidate();
+
 	m_Maximum = Maximum;
 }
 
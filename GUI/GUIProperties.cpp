@@ -6,14 +6,14 @@ using namespace RTE;
 
 GUIProperties::GUIProperties(const std::string &Name) {
 	m_Name = Name;
-	m_VariableList.clear();
+	Clear();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 GUIProperties::GUIProperties() {
 	m_Name = "";
-	m_VariableList.clear();
+	Clear();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -25,34 +25,29 @@ GUIProperties::~GUIProperties() {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIProperties::Clear() {
-	// Free the list
-	std::vector <PropVariable *>::iterator it;
-
-	for (it = m_VariableList.begin(); it != m_VariableList.end(); it++) {
-		PropVariable *p = *it;
-
-		// Free the property
-		delete p;
-	}
 	m_VariableList.clear();
+	m_VariableIndex.clear();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void GUIProperties::AddVariable(const std::string &Variable, const std::string &Value) {
+void GUIProperties::AddVariable(std::string_view Variable, std::string_view Value) {
+	size_t NameHash = HashName(Variable);
+
 	// If this property already exists, just update it
-	std::string Val;
-	if (GetValue(Variable, &Val)) {
-		SetValue(Variable, Value);
+	PropVariable *Existing = FindVariable(Variable, NameHash);
+	if (Existing) {
+		Existing->SetValue(Value);
 		return;
 	}
 
-	PropVariable *Prop = new PropVariable;
-
-	Prop->m_Name = Variable;
-	Prop->m_Value = Value;
-
-	m_VariableList.push_back(Prop);
+	// Most controls have between 10 and 20 properties, so start with room for that many instead of growing one by one
+	if (m_VariableList.empty()) { m_VariableList.reserve(16); }
+	PropVariable &Prop = m_VariableList.emplace_back();
+	Prop.m_Name.assign(Variable);
+	Prop.m_NameHash = NameHash;
+	Prop.SetValue(Value);
+	IndexVariable(m_VariableList.size() - 1);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -82,21 +77,12 @@ void GUIProperties::AddVariable(const std::string &Variable, bool Value) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool GUIProperties::SetValue(const std::string &Variable, const std::string &Value) {
-	// Find the property
-	std::vector <PropVariable *>::iterator it;
-
-	for (it = m_VariableList.begin(); it != m_VariableList.end(); it++) {
-		PropVariable *p = *it;
-
-		// Matching name?
-		if (stricmp(p->m_Name.c_str(), Variable.c_str()) == 0) {
-			p->m_Value = Value;
-			return true;
-		}
+	PropVariable *Prop = FindVariable(Variable, HashName(Variable));
+	if (!Prop) {
+		return false;
 	}
-
-	// Not set
-	return false;
+	Prop->SetValue(Value);
+	return true;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,34 +99,30 @@ bool GUIProperties::SetValue(const std::string &Variable, int Value) {
 void GUIProperties::Update(GUIProperties *Props, bool Add) {
 	assert(Props);
 
-	std::vector <PropVariable *>::iterator it1;
+	std::vector<PropVariable>::iterator it1;
 
 	for (it1 = Props->m_VariableList.begin(); it1 != Props->m_VariableList.end(); it1++) {
-		const PropVariable *Src = *it1;
-
-		// Set the variable
-		if (!SetValue(Src->m_Name, Src->m_Value) && Add) { AddVariable(Src->m_Name, Src->m_Value); }
+		const PropVariable &Src = *it1;
+
+		// Set the variable, the source's name hash can be reused since hashes don't depend on the instance
+		PropVariable *Dest = FindVariable(Src.m_Name, Src.m_NameHash);
+		if (Dest) {
+			Dest->SetValue(Src.m_Value);
+		} else if (Add) {
+			AddVariable(Src.m_Name, Src.m_Value);
+		}
 	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool GUIProperties::GetValue(const std::string &Variable, std::string *Value) {
-	// Find the property
-	std::vector <PropVariable *>::iterator it;
-
-	for (it = m_VariableList.begin(); it != m_VariableList.end(); it++) {
-		const PropVariable *p = *it;
-
-		// Matching name?
-		if (stricmp(p->m_Name.c_str(), Variable.c_str()) == 0) {
-			*Value = p->m_Value;
-			return true;
-		}
+	const PropVariable *Prop = FindVariable(Variable, HashName(Variable));
+	if (!Prop) {
+		return false;
 	}
-
-	// Not found
-	return false;
+	*Value = Prop->m_Value;
+	return true;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -212,13 +194,16 @@ int GUIProperties::GetValue(const std::string &Variable, int *Array, int MaxArra
 bool GUIProperties::GetValue(const std::string &Variable, int *Value) {
 	assert(Value);
 
-	std::string val;
-
-	// Get the string
-	if (!GetValue(Variable, &val)) {
+	PropVariable *Prop = FindVariable(Variable, HashName(Variable));
+	if (!Prop) {
 		return false;
 	}
-	*Value = atoi(val.c_str());
+	// Only parse the string the first time the value is read as a number
+	if (!Prop->m_NumericCached) {
+		Prop->m_NumericValue = atol(Prop->m_Value.c_str());
+		Prop->m_NumericCached = true;
+	}
+	*Value = static_cast<int>(Prop->m_NumericValue);
 
 	// Found the value
 	return true;
@@ -229,13 +214,16 @@ bool GUIProperties::GetValue(const std::string &Variable, int *Value) {
 bool GUIProperties::GetValue(const std::string &Variable, unsigned long *Value) {
 	assert(Value);
 
-	std::string val;
-
-	// Get the string
-	if (!GetValue(Variable, &val)) {
+	PropVariable *Prop = FindVariable(Variable, HashName(Variable));
+	if (!Prop) {
 		return false;
 	}
-	*Value = atol(val.c_str());
+	// Only parse the string the first time the value is read as a number
+	if (!Prop->m_NumericCached) {
+		Prop->m_NumericValue = atol(Prop->m_Value.c_str());
+		Prop->m_NumericCached = true;
+	}
+	*Value = Prop->m_NumericValue;
 
 	// Found the value
 	return true;
@@ -246,17 +234,16 @@ bool GUIProperties::GetValue(const std::string &Variable, unsigned long *Value)
 bool GUIProperties::GetValue(const std::string &Variable, bool *Value) {
 	assert(Value);
 
-	std::string val;
-
-	// Get the string
-	if (!GetValue(Variable, &val)) {
+	PropVariable *Prop = FindVariable(Variable, HashName(Variable));
+	if (!Prop) {
 		return false;
 	}
-	// Default is false
-	*Value = false;
-
-	// Convert the string into a boolean
-	if (stricmp(val.c_str(), "true") == 0) { *Value = true; }
+	// Only parse the string the first time the value is read as a boolean, anything other than "true" is false
+	if (!Prop->m_BoolCached) {
+		Prop->m_BoolValue = stricmp(Prop->m_Value.c_str(), "true") == 0;
+		Prop->m_BoolCached = true;
+	}
+	*Value = Prop->m_BoolValue;
 
 	// Found the value
 	return true;
@@ -270,17 +257,17 @@ std::string GUIProperties::GetName() const {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::string GUIProperties::ToString() {
+std::string GUIProperties::ToString() const {
 	std::string OutString = "";
 
 	// Go through each value
-	std::vector <PropVariable *>::iterator it;
+	std::vector<PropVariable>::const_iterator it;
 	for (it = m_VariableList.begin(); it != m_VariableList.end(); it++) {
-		const PropVariable *V = *it;
+		const PropVariable &V = *it;
 
-		OutString += V->m_Name;
+		OutString += V.m_Name;
 		OutString.append(" = ");
-		OutString += V->m_Value;
+		OutString += V.m_Value;
 		OutString.append("\n");
 	}
 	return OutString;
@@ -288,21 +275,31 @@ std::string GUIProperties::ToString() {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GUIProperties::Save(GUIWriter *W) const {
+	assert(W);
+
+	for (const PropVariable &V : m_VariableList) {
+		*W << V.m_Name << " = " << V.m_Value << '\n';
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 int GUIProperties::GetCount() const {
 	return m_VariableList.size();
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool GUIProperties::GetVariable(int Index, std::string *Name, std::string *Value) {
+bool GUIProperties::GetVariable(int Index, std::string *Name, std::string *Value) const {
 	// Check for a bad index
-	if (Index < 0 || Index >= m_VariableList.size()) {
+	if (Index < 0 || Index >= static_cast<int>(m_VariableList.size())) {
 		return false;
 	}
 
-	const PropVariable *P = (PropVariable *)m_VariableList.at(Index);
-	if (Name) { *Name = P->m_Name; }
-	if (Value) { *Value = P->m_Value; }
+	const PropVariable &P = m_VariableList.at(Index);
+	if (Name) { *Name = P.m_Name; }
+	if (Value) { *Value = P.m_Value; }
 
 	return true;
 }
@@ -311,12 +308,18 @@ bool GUIProperties::GetVariable(int Index, std::string *Name, std::string *Value
 
 bool GUIProperties::SetVariable(int Index, const std::string &Name, const std::string &Value) {
 	// Check for a bad index
-	if (Index < 0 || Index >= m_VariableList.size()) {
+	if (Index < 0 || Index >= static_cast<int>(m_VariableList.size())) {
 		return false;
 	}
-	PropVariable *P = m_VariableList.at(Index);
-	P->m_Name = Name;
-	P->m_Value = Value;
+	PropVariable &P = m_VariableList.at(Index);
+	size_t NameHash = HashName(Name);
+	bool Renamed = P.m_NameHash != NameHash;
+	P.m_Name = Name;
+	P.m_NameHash = NameHash;
+	P.SetValue(Value);
+
+	// The variable is now in a different slot of the lookup table
+	if (Renamed) { RebuildIndex(); }
 
 	return true;
 }
@@ -324,21 +327,80 @@ bool GUIProperties::SetVariable(int Index, const std::string &Name, const std::s
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIProperties::Sort(bool Ascending) {
-	// Simple bubble sort
+	// Stable so variables with the same name keep their order, same as the bubble sort this used to be
+	std::stable_sort(m_VariableList.begin(), m_VariableList.end(), [Ascending](const PropVariable &V, const PropVariable &V2) {
+		return Ascending ? V.m_Name.compare(V2.m_Name) < 0 : V.m_Name.compare(V2.m_Name) > 0;
+	});
+	RebuildIndex();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	for (int i = 0; i < m_VariableList.size(); i++) {
+// Lower cases ASCII letters the way stricmp compares them, without a call into the locale for every character like std::tolower
+static inline unsigned char FoldCase(char Char) {
+	return (Char >= 'A' && Char <= 'Z') ? static_cast<unsigned char>(Char - 'A' + 'a') : static_cast<unsigned char>(Char);
+}
 
-		for (int j = 0; j < m_VariableList.size() - 1 - i; j++) {
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-			PropVariable *V = m_VariableList.at(j);
-			PropVariable *V2 = m_VariableList.at(j + 1);
+size_t GUIProperties::HashName(std::string_view Name) {
+	// FNV-1a over the lower case characters
+	size_t Hash = 2166136261U;
+	for (const char &Char : Name) {
+		Hash ^= static_cast<size_t>(FoldCase(Char));
+		Hash *= 16777619U;
+	}
+	return Hash;
+}
 
-			if ((V->m_Name.compare(V2->m_Name) > 0 && Ascending) || (V->m_Name.compare(V2->m_Name) < 0 && !Ascending)) {
-				// Swap em
-				PropVariable temp = *V;
-				*V = *V2;
-				*V2 = temp;
-			}
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+GUIProperties::PropVariable * GUIProperties::FindVariable(std::string_view Name, size_t NameHash) {
+	if (m_VariableIndex.empty()) {
+		return nullptr;
+	}
+	size_t Mask = m_VariableIndex.size() - 1;
+	for (size_t Slot = NameHash & Mask; m_VariableIndex[Slot] != -1; Slot = (Slot + 1) & Mask) {
+		PropVariable &Prop = m_VariableList[m_VariableIndex[Slot]];
+		if (Prop.m_NameHash == NameHash && Prop.m_Name.size() == Name.size() && std::equal(Name.begin(), Name.end(), Prop.m_Name.begin(), [](char A, char B) { return FoldCase(A) == FoldCase(B); })) {
+			return &Prop;
 		}
 	}
+	return nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIProperties::IndexVariable(int Index) {
+	// Keep the table at most half full so probe sequences stay short
+	if (m_VariableList.size() * 2 > m_VariableIndex.size()) {
+		RebuildIndex();
+		return;
+	}
+	size_t Mask = m_VariableIndex.size() - 1;
+	size_t Slot = m_VariableList[Index].m_NameHash & Mask;
+	while (m_VariableIndex[Slot] != -1) {
+		Slot = (Slot + 1) & Mask;
+	}
+	m_VariableIndex[Slot] = Index;
 }
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUIProperties::RebuildIndex() {
+	size_t TableSize = 32;
+	while (TableSize < m_VariableList.size() * 2) {
+		TableSize *= 2;
+	}
+	m_VariableIndex.assign(TableSize, -1);
+
+	// Indexed in list order so the first of any duplicate names is found first, same as a front to back search
+	size_t Mask = TableSize - 1;
+	for (size_t Index = 0; Index < m_VariableList.size(); Index++) {
+		size_t Slot = m_VariableList[Index].m_NameHash & Mask;
+		while (m_VariableIndex[Slot] != -1) {
+			Slot = (Slot + 1) & Mask;
+		}
+		m_VariableIndex[Slot] = static_cast<int>(Index);
+	}
+}
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 namespace RTE {
 
+class GUIWriter;
+
 /// <summary>
 /// A class containing properties for controls and skins.
 /// </summary>
@@ -56,7 +58,7 @@ public:
 // Description:     Adds a new variable to the properties
 // Arguments:       Variable, Value
 
-    void AddVariable(const std::string &Variable, const std::string &Value);
+    void AddVariable(std::string_view Variable, std::string_view Value);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -184,7 +186,17 @@ public:
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Converts the properties to a string
 
-    std::string ToString();
+    std::string ToString() const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          Save
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Writes the properties straight to a writer, in the same format as
+//                  ToString.
+// Arguments:       Writer class.
+
+    void Save(GUIWriter *W) const;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -200,7 +212,7 @@ public:
 //////////////////////////////////////////////////////////////////////////////////////////
 // Description:     Gets a variable based on index
 
-    bool GetVariable(int Index, std::string *Name, std::string *Value);
+    bool GetVariable(int Index, std::string *Name, std::string *Value) const;
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -222,14 +234,60 @@ public:
 private:
 
     // Variable structure
-    typedef struct {
+    struct PropVariable {
         std::string m_Name;
         std::string m_Value;
-    } PropVariable;
+        size_t m_NameHash; // Hash of the case-folded name, used for lookups.
+        bool m_NumericCached; // Whether m_NumericValue holds the parsed value of m_Value.
+        long m_NumericValue;
+        bool m_BoolCached; // Whether m_BoolValue holds the parsed value of m_Value.
+        bool m_BoolValue;
+
+        void SetValue(std::string_view Value) { m_Value.assign(Value); m_NumericCached = false; m_BoolCached = false; }
+    };
 
     std::string m_Name;
 
-    std::vector<PropVariable *> m_VariableList;
+    std::vector<PropVariable> m_VariableList;
+    std::vector<int> m_VariableIndex; // Open addressing hash table of indices into m_VariableList, -1 marks an empty slot. Size is always zero or a power of two.
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          HashName
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Hashes a variable name case-insensitively.
+// Arguments:       Variable name.
+// Returns:         The hash of the lower case variable name.
+
+    static size_t HashName(std::string_view Name);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          FindVariable
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Finds a variable by name, case-insensitively.
+// Arguments:       Variable name, hash of the name from HashName.
+// Returns:         Pointer to the variable, or nullptr if there is no such variable.
+
+    PropVariable * FindVariable(std::string_view Name, size_t NameHash);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          IndexVariable
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Adds a variable to the lookup table, growing the table if needed.
+// Arguments:       Index of the variable in the variable list.
+
+    void IndexVariable(int Index);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          RebuildIndex
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Rebuilds the lookup table from the variable list.
+// Arguments:       None.
+
+    void RebuildIndex();
 };
 };
 #endif
\ No newline at end of file
@@ -150,6 +150,8 @@ void GUIPropertyPage::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIPropertyPage::BuildBitmap() {
+	Invalidate();
+
 	// Free any old bitmap
 	if (m_DrawBitmap) {
 		m_DrawBitmap->Destroy();
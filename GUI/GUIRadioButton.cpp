@@ -80,6 +80,8 @@ void GUIRadioButton::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIRadioButton::BuildBitmap() {
+	Invalidate();
+
 	std::string Filename;
 	unsigned long ColorIndex = 0;
 	int Values[4];
@@ -130,8 +132,10 @@ void GUIRadioButton::Draw(GUIScreen *Screen) {
 	if (!m_Image) {
 		return;
 	}
-	// Setup the clipping
-	Screen->GetBitmap()->SetClipRect(GetRect());
+	// Setup the clipping, keeping within the area already being clipped to
+	GUIRect PrevClip;
+	Screen->GetBitmap()->GetClipRect(&PrevClip);
+	Screen->GetBitmap()->AddClipRect(GetRect());
 
 	// Calculate the y position of the base
 	// Make it centered vertically
@@ -167,7 +171,7 @@ void GUIRadioButton::Draw(GUIScreen *Screen) {
 		m_Font->SetKerning(m_FontKerning);
 		m_Font->Draw(Screen->GetBitmap(), m_X + (m_ImageRects[0].right - m_ImageRects[0].left), m_Y + (m_Height / 2) - (m_Font->GetFontHeight() / 2) - 1, Text, m_FontShadow);
 	}
-	Screen->GetBitmap()->SetClipRect(nullptr);
+	Screen->GetBitmap()->SetClipRect(&PrevClip);
 
 	GUIPanel::Draw(Screen);
 }
@@ -254,6 +258,7 @@ void GUIRadioButton::SetCheck(bool Check) {
 	}
 
 	m_Checked = Check;
+	Invalidate();
 
 	AddEvent(GUIEvent::Notification, Changed, Check);
 
@@ -294,6 +299,8 @@ bool GUIRadioButton::GetCheck() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIRadioButton::SetText(const std::string &Text) {
+	Invalidate();
+
 	m_Text = Text;
 }
 
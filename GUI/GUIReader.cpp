@@ -3,9 +3,186 @@
 
 namespace RTE {
 
+	/// <summary>
+	/// An istream over a single file that reads it in large chunks, or over all of it at once if it was already loaded by a prefetch.
+	/// Also has versions of the single character istream operations that skip the per-call sentry, for the loops that eat through the file one character at a time.
+	/// They set the same state flags as the istream operations they stand in for, so mixing them with regular extraction behaves the same.
+	/// </summary>
+	class GUIReader::FileStream : public std::istream {
+
+	public:
+
+		static constexpr size_t c_ChunkSize = 64 * 1024; //!< How much of a file is read from disk at a time.
+
+		/// <summary>
+		/// Constructor method used to instantiate a FileStream object that reads a file from disk as it goes.
+		/// </summary>
+		/// <param name="reader">The reader to pass every chunk read to, so it can prefetch the include files named in it.</param>
+		/// <param name="filePath">Path to the file to read.</param>
+		FileStream(GUIReader *reader, const std::string &filePath) : std::istream(nullptr), m_Buffer(reader, filePath) {
+			rdbuf(&m_Buffer);
+			if (!m_Buffer.IsOpen()) { setstate(std::ios_base::failbit); }
+		}
+
+		/// <summary>
+		/// Constructor method used to instantiate a FileStream object over the whole contents of a file that were already read.
+		/// </summary>
+		/// <param name="reader">The reader to pass the contents to, so it can prefetch the include files named in them.</param>
+		/// <param name="fileData">The contents of the file.</param>
+		FileStream(GUIReader *reader, std::string &&fileData) : std::istream(nullptr), m_Buffer(reader, std::move(fileData)) {
+			rdbuf(&m_Buffer);
+		}
+
+		/// <summary>
+		/// Gets whether the file this reads from was opened.
+		/// </summary>
+		/// <returns>Whether the file is open.</returns>
+		bool IsOpen() const { return m_Buffer.IsOpen(); }
+
+		/// <summary>
+		/// Same as peek().
+		/// </summary>
+		/// <returns>The next character, or EOF.</returns>
+		int PeekChar() {
+			if (!good()) {
+				setstate(std::ios_base::failbit);
+				return EOF;
+			}
+			int nextChar = m_Buffer.sgetc();
+			if (nextChar == EOF) { setstate(std::ios_base::eofbit); }
+			return nextChar;
+		}
+
+		/// <summary>
+		/// Same as get().
+		/// </summary>
+		/// <returns>The character extracted, or EOF.</returns>
+		int GetChar() {
+			if (!good()) {
+				setstate(std::ios_base::failbit);
+				return EOF;
+			}
+			int nextChar = m_Buffer.sbumpc();
+			if (nextChar == EOF) { setstate(std::ios_base::eofbit | std::ios_base::failbit); }
+			return nextChar;
+		}
+
+		/// <summary>
+		/// Same as ignore(1).
+		/// </summary>
+		void IgnoreChar() {
+			if (!good()) {
+				setstate(std::ios_base::failbit);
+			} else if (m_Buffer.sbumpc() == EOF) {
+				setstate(std::ios_base::eofbit);
+			}
+		}
+
+		/// <summary>
+		/// Same as unget().
+		/// </summary>
+		void UngetChar() {
+			clear(rdstate() & ~std::ios_base::eofbit);
+			if (!good()) {
+				setstate(std::ios_base::failbit);
+			} else if (m_Buffer.sungetc() == EOF) {
+				setstate(std::ios_base::badbit);
+			}
+		}
+
+		/// <summary>
+		/// Same as putback().
+		/// </summary>
+		/// <param name="charToPutBack">The character to put back.</param>
+		void PutBackChar(char charToPutBack) {
+			clear(rdstate() & ~std::ios_base::eofbit);
+			if (!good()) {
+				setstate(std::ios_base::failbit);
+			} else if (m_Buffer.sputbackc(charToPutBack) == EOF) {
+				setstate(std::ios_base::badbit);
+			}
+		}
+
+	private:
+
+		/// <summary>
+		/// The streambuf behind FileStream. Keeps one chunk of the file in memory and refills it from disk when it runs out.
+		/// </summary>
+		class ChunkBuffer : public std::streambuf {
+
+		public:
+
+			ChunkBuffer(GUIReader *reader, const std::string &filePath) : m_Reader(reader), m_File(filePath), m_IsOpen(m_File.is_open()) {
+				// Most include files are much smaller than a chunk, so only make room for as much as there is to read. One more than that so the first read already reaches the end.
+				std::error_code sizeError;
+				uintmax_t fileSize = std::filesystem::file_size(filePath, sizeError);
+				m_ReadSize = sizeError ? c_ChunkSize : static_cast<size_t>(std::min<uintmax_t>(fileSize + 1, c_ChunkSize));
+			}
+
+			ChunkBuffer(GUIReader *reader, std::string &&fileData) : m_Reader(reader), m_Chunk(std::move(fileData)), m_ReadSize(0), m_IsOpen(true) {
+				setg(m_Chunk.data(), m_Chunk.data(), m_Chunk.data() + m_Chunk.size());
+				m_Reader->PrefetchIncludeFiles(m_Chunk);
+			}
+
+			bool IsOpen() const { return m_IsOpen; }
+
+		protected:
+
+			int_type underflow() override {
+				if (gptr() < egptr()) {
+					return traits_type::to_int_type(*gptr());
+				}
+				if (!m_File.is_open()) {
+					return traits_type::eof();
+				}
+				// Keep the last character in front of the new chunk so it can still be put back after a refill
+				bool keepLastChar = eback() < gptr();
+				char lastChar = keepLastChar ? gptr()[-1] : '\0';
+
+				m_Chunk.resize(m_ReadSize + 1);
+				m_File.read(&m_Chunk[1], static_cast<std::streamsize>(m_ReadSize));
+				std::streamsize readCount = m_File.gcount();
+				// Close the file once it's read to the end, so the next underflow doesn't make room for a chunk that isn't there
+				if (m_File.eof()) { m_File.close(); }
+				m_ReadSize = c_ChunkSize;
+				if (readCount <= 0) {
+					return traits_type::eof();
+				}
+				m_Chunk[0] = lastChar;
+				setg(&m_Chunk[keepLastChar ? 0 : 1], &m_Chunk[1], &m_Chunk[1] + readCount);
+				m_Reader->PrefetchIncludeFiles(std::string_view(&m_Chunk[1], static_cast<size_t>(readCount)));
+
+				return traits_type::to_int_type(*gptr());
+			}
+
+		private:
+
+			GUIReader *m_Reader; //!< The reader this belongs to.
+			std::ifstream m_File; //!< The file being read from, not open if the whole file was handed over at construction.
+			std::string m_Chunk; //!< The part of the file currently in memory.
+			size_t m_ReadSize; //!< How much to read from the file into the next chunk. The whole file if it fits in one chunk, otherwise a full chunk.
+			bool m_IsOpen; //!< Whether there is a file to read from.
+		};
+
+		ChunkBuffer m_Buffer; //!< The buffer this stream reads from.
+	};
+
+	/// <summary>
+	/// An include file being loaded in the background.
+	/// </summary>
+	struct GUIReader::PrefetchedFile {
+		static constexpr size_t c_MaxPending = 16; //!< How many include files can be queued, loading or waiting to be used at the same time.
+
+		size_t PrefetchIndex; //!< How many prefetches were started before this one, so the oldest can be dropped first when making room.
+		std::string FilePath; //!< Path of the file to load.
+		std::string FileData; //!< The contents of the file, filled in by the prefetch thread.
+		std::promise<bool> LoadedPromise; //!< Set by the prefetch thread once it's done with FileData.
+		std::future<bool> Loaded; //!< Whether the file could be read. Ready once the prefetch thread is done with FileData.
+	};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	GUIReader::StreamInfo::StreamInfo(std::ifstream *stream, const std::string &filePath, int currentLine, int prevIndent) : Stream(stream), FilePath(filePath), CurrentLine(currentLine), PreviousIndent(prevIndent) {}
+	GUIReader::StreamInfo::StreamInfo(FileStream *stream, const std::string &filePath, int currentLine, int prevIndent) : Stream(stream), FilePath(filePath), CurrentLine(currentLine), PreviousIndent(prevIndent) {}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -20,6 +197,8 @@ namespace RTE {
 		m_ReportTabs = "\t";
 		m_FileName.clear();
 		m_SkipIncludes = false;
+		m_PrefetchCount = 0;
+		m_StopPrefetching = false;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +207,20 @@ namespace RTE {
 		Clear();
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GUIReader::~GUIReader() {
+		// Files still queued are never loaded, the thread only has to finish the one it's on before the prefetched files can go
+		if (m_PrefetchThread.joinable()) {
+			{
+				std::lock_guard<std::mutex> prefetchLock(m_PrefetchMutex);
+				m_StopPrefetching = true;
+			}
+			m_PrefetchQueued.notify_one();
+			m_PrefetchThread.join();
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int GUIReader::Create(const std::string &fileName) {
@@ -39,7 +232,7 @@ namespace RTE {
 		// Extract the file name and module name from the path
 		m_FileName = m_FilePath.substr(m_FilePath.find_last_of("/\\") + 1);
 
-		m_Stream = std::make_unique<std::ifstream>(fileName);
+		m_Stream = std::make_unique<FileStream>(this, fileName);
 		return m_Stream->good() ? 0 : -1;
 	}
 
@@ -80,14 +273,14 @@ namespace RTE {
 
 		std::string retString;
 		char temp;
-		char peek = static_cast<char>(m_Stream->peek());
+		char peek = static_cast<char>(m_Stream->PeekChar());
 
 		while (peek != '\n' && peek != '\r' && peek != '\t') {
-			temp = static_cast<char>(m_Stream->get());
+			temp = static_cast<char>(m_Stream->GetChar());
 
 			// Check for line comment "//"
-			if (peek == '/' && m_Stream->peek() == '/') {
-				m_Stream->unget();
+			if (peek == '/' && m_Stream->PeekChar() == '/') {
+				m_Stream->UngetChar();
 				break;
 			}
 
@@ -95,7 +288,7 @@ namespace RTE {
 			if (!m_Stream->good()) { ReportError("Stream failed for some reason"); }
 
 			retString.append(1, temp);
-			peek = static_cast<char>(m_Stream->peek());
+			peek = static_cast<char>(m_Stream->PeekChar());
 		}
 		return TrimString(retString);
 	}
@@ -110,15 +303,15 @@ namespace RTE {
 		char peek;
 
 		while (true) {
-			peek = static_cast<char>(m_Stream->peek());
+			peek = static_cast<char>(m_Stream->PeekChar());
 			if (peek == '=') {
-				m_Stream->ignore(1);
+				m_Stream->IgnoreChar();
 				break;
 			}
 			if (peek == '\n' || peek == '\r' || peek == '\t') {
 				ReportError("Property name wasn't followed by a value");
 			}
-			temp = static_cast<char>(m_Stream->get());
+			temp = static_cast<char>(m_Stream->GetChar());
 			if (m_Stream->eof()) {
 				EndIncludeFile();
 				break;
@@ -190,7 +383,7 @@ namespace RTE {
 		bool discardedLine = false;
 
 		while (true) {
-			peek = static_cast<char>(m_Stream->peek());
+			peek = static_cast<char>(m_Stream->PeekChar());
 
 			// If we have hit the end and don't have any files to resume, then quit and indicate that
 			if (m_Stream->eof()) {
@@ -201,40 +394,40 @@ namespace RTE {
 
 			// Discard spaces
 			if (peek == ' ') {
-				m_Stream->ignore(1);
+				m_Stream->IgnoreChar();
 			// Discard tabs, and count them
 			} else if (peek == '\t') {
 				indent++;
-				m_Stream->ignore(1);
+				m_Stream->IgnoreChar();
 			// Discard newlines and reset the tab count for the new line, also count the lines
 			} else if (peek == '\n' || peek == '\r') {
 				// So we don't count lines twice when there are both newline and carriage return at the end of lines
 				if (peek == '\n') { m_CurrentLine++; }
 				indent = 0;
 				discardedLine = true;
-				m_Stream->ignore(1);
+				m_Stream->IgnoreChar();
 
 			// Comment line?
-			} else if (m_Stream->peek() == '/') {
-				char temp = static_cast<char>(m_Stream->get());
+			} else if (m_Stream->PeekChar() == '/') {
+				char temp = static_cast<char>(m_Stream->GetChar());
 				char temp2;
 
 				// Confirm that it's a comment line, if so discard it and continue
-				if (m_Stream->peek() == '/') {
-					while (m_Stream->peek() != '\n' && m_Stream->peek() != '\r' && !m_Stream->eof()) { m_Stream->ignore(1); }
+				if (m_Stream->PeekChar() == '/') {
+					while (m_Stream->PeekChar() != '\n' && m_Stream->PeekChar() != '\r' && !m_Stream->eof()) { m_Stream->IgnoreChar(); }
 				// Block comment
-				} else if (m_Stream->peek() == '*') {
+				} else if (m_Stream->PeekChar() == '*') {
 					// Find the matching "*/"
-					while (!((temp2 = static_cast<char>(m_Stream->get())) == '*' && m_Stream->peek() == '/') && !m_Stream->eof()) {
+					while (!((temp2 = static_cast<char>(m_Stream->GetChar())) == '*' && m_Stream->PeekChar() == '/') && !m_Stream->eof()) {
 						// Count the lines within the comment though
 						if (temp2 == '\n') { ++m_CurrentLine; }
 					}
 					// Discard that final '/'
-					if (!m_Stream->eof()) { m_Stream->ignore(1); }
+					if (!m_Stream->eof()) { m_Stream->IgnoreChar(); }
 
 				// Not a comment, so it's data, so quit.
 				} else {
-					m_Stream->putback(temp);
+					m_Stream->PutBackChar(temp);
 					break;
 				}
 			} else {
@@ -255,7 +448,7 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool GUIReader::ReaderOK() const {
-		return m_Stream.get() && !m_Stream->fail() && m_Stream->is_open();
+		return m_Stream.get() && !m_Stream->fail() && m_Stream->IsOpen();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -274,7 +467,15 @@ namespace RTE {
 		m_StreamStack.emplace(StreamInfo(m_Stream.release(), m_FilePath, m_CurrentLine, m_PreviousIndent));
 
 		m_FilePath = includeFilePath;
-		m_Stream = std::make_unique<std::ifstream>(m_FilePath);
+
+		// Use the prefetched contents if the file was seen coming, otherwise read it from disk now
+		if (std::unordered_map<std::string, std::unique_ptr<PrefetchedFile>>::iterator prefetchedFileEntry = m_PrefetchedFiles.find(m_FilePath); prefetchedFileEntry != m_PrefetchedFiles.end()) {
+			// Take it out of the map first, the new stream will add the include files it names to it
+			std::unique_ptr<PrefetchedFile> prefetchedFile = std::move(prefetchedFileEntry->second);
+			m_PrefetchedFiles.erase(prefetchedFileEntry);
+			if (prefetchedFile->Loaded.get()) { m_Stream = std::make_unique<FileStream>(this, std::move(prefetchedFile->FileData)); }
+		}
+		if (!m_Stream) { m_Stream = std::make_unique<FileStream>(this, m_FilePath); }
 
 		if (m_Stream->fail() || !std::filesystem::exists(includeFilePath)) {
 			// Backpedal and set up to read the next property in the old stream
@@ -322,6 +523,106 @@ namespace RTE {
 		return true;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GUIReader::PrefetchIncludeFiles(std::string_view text) {
+		// With one hardware thread the files would be read on the same core either way, and handing them over to another thread only adds to it
+		static const bool canPrefetch = std::thread::hardware_concurrency() > 1;
+		if (m_SkipIncludes || !canPrefetch) {
+			return;
+		}
+		const std::string_view includeFileName = "IncludeFile";
+		for (size_t namePos = text.find(includeFileName); namePos != std::string_view::npos; namePos = text.find(includeFileName, namePos + includeFileName.size())) {
+			size_t valueStart = text.find_first_not_of(' ', namePos + includeFileName.size());
+			if (valueStart == std::string_view::npos || text[valueStart] != '=') {
+				continue;
+			}
+			// Pick out the value the same way ReadPropValue will
+			size_t valueEnd = text.find_first_of("\n\r\t", valueStart + 1);
+			if (valueEnd == std::string_view::npos) {
+				continue;
+			}
+			std::string_view includeFileValue = text.substr(valueStart + 1, valueEnd - valueStart - 1);
+			includeFileValue = includeFileValue.substr(0, includeFileValue.find("//"));
+			if (size_t equalsPos = includeFileValue.find('='); equalsPos != std::string_view::npos) { includeFileValue.remove_prefix(equalsPos + 1); }
+			size_t trimStart = includeFileValue.find_first_not_of(' ');
+			if (trimStart == std::string_view::npos) {
+				continue;
+			}
+			includeFileValue = includeFileValue.substr(trimStart, includeFileValue.find_last_not_of(' ') - trimStart + 1);
+
+			std::string includeFilePath = std::filesystem::path(includeFileValue).generic_string();
+			if (m_PrefetchedFiles.find(includeFilePath) != m_PrefetchedFiles.end()) {
+				continue;
+			}
+			// Files that are never included, like ones named in a comment, are only taken out of the map by making room for new ones.
+			// Drop the oldest file that's done loading, or skip this one if none of them are loaded yet so the number of files held stays capped.
+			if (m_PrefetchedFiles.size() >= PrefetchedFile::c_MaxPending) {
+				std::unordered_map<std::string, std::unique_ptr<PrefetchedFile>>::iterator oldestLoadedEntry = m_PrefetchedFiles.end();
+				for (std::unordered_map<std::string, std::unique_ptr<PrefetchedFile>>::iterator prefetchedFileEntry = m_PrefetchedFiles.begin(); prefetchedFileEntry != m_PrefetchedFiles.end(); ++prefetchedFileEntry) {
+					if (prefetchedFileEntry->second->Loaded.wait_for(std::chrono::seconds(0)) == std::future_status::ready && (oldestLoadedEntry == m_PrefetchedFiles.end() || prefetchedFileEntry->second->PrefetchIndex < oldestLoadedEntry->second->PrefetchIndex)) {
+						oldestLoadedEntry = prefetchedFileEntry;
+					}
+				}
+				if (oldestLoadedEntry == m_PrefetchedFiles.end()) {
+					continue;
+				}
+				m_PrefetchedFiles.erase(oldestLoadedEntry);
+			}
+			std::unique_ptr<PrefetchedFile> &prefetchedFile = m_PrefetchedFiles[includeFilePath];
+			prefetchedFile = std::make_unique<PrefetchedFile>();
+			prefetchedFile->PrefetchIndex = m_PrefetchCount++;
+			prefetchedFile->FilePath = includeFilePath;
+			prefetchedFile->Loaded = prefetchedFile->LoadedPromise.get_future();
+			{
+				std::lock_guard<std::mutex> prefetchLock(m_PrefetchMutex);
+				m_PrefetchQueue.push_back(prefetchedFile.get());
+			}
+			// One thread loads all the queued files, so a deep include tree doesn't start a thread for every file in it
+			if (!m_PrefetchThread.joinable()) {
+				m_PrefetchThread = std::thread(&GUIReader::LoadPrefetchedFiles, this);
+			} else {
+				m_PrefetchQueued.notify_one();
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GUIReader::LoadPrefetchedFiles() {
+		while (true) {
+			PrefetchedFile *prefetchedFile = nullptr;
+			{
+				std::unique_lock<std::mutex> prefetchLock(m_PrefetchMutex);
+				m_PrefetchQueued.wait(prefetchLock, [this]() { return m_StopPrefetching || !m_PrefetchQueue.empty(); });
+				if (m_StopPrefetching) {
+					return;
+				}
+				prefetchedFile = m_PrefetchQueue.front();
+				m_PrefetchQueue.pop_front();
+			}
+			// Text mode like the FileStream would use, so the contents come out exactly as they would have been read from disk
+			std::ifstream includeFile(prefetchedFile->FilePath);
+			if (!includeFile.is_open()) {
+				prefetchedFile->LoadedPromise.set_value(false);
+				continue;
+			}
+			// Read as much as the file's size plus one in one go, which already reaches the end since text mode can only make the contents shorter. Only a file that grew since takes more reads.
+			std::error_code sizeError;
+			uintmax_t fileSize = std::filesystem::file_size(prefetchedFile->FilePath, sizeError);
+			size_t readSize = sizeError ? FileStream::c_ChunkSize : static_cast<size_t>(fileSize + 1);
+			std::string &fileData = prefetchedFile->FileData;
+			while (includeFile.good()) {
+				size_t readStart = fileData.size();
+				fileData.resize(readStart + readSize);
+				includeFile.read(fileData.data() + readStart, static_cast<std::streamsize>(readSize));
+				fileData.resize(readStart + static_cast<size_t>(includeFile.gcount()));
+				readSize = FileStream::c_ChunkSize;
+			}
+			prefetchedFile->LoadedPromise.set_value(!includeFile.bad());
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIReader & GUIReader::operator>>(bool &var) {
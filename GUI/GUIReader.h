@@ -16,6 +16,11 @@ namespace RTE {
 		/// </summary>
 		GUIReader();
 
+		/// <summary>
+		/// Destructor method used to clean up a GUIReader object before deletion from system memory. Waits for any include files still being prefetched.
+		/// </summary>
+		~GUIReader();
+
 		/// <summary>
 		/// Makes the GUIReader object ready for use.
 		/// </summary>
@@ -134,6 +139,9 @@ namespace RTE {
 
 	protected:
 
+		class FileStream;
+		struct PrefetchedFile;
+
 		/// <summary>
 		/// A struct containing information from the currently used stream.
 		/// </summary>
@@ -141,17 +149,24 @@ namespace RTE {
 			/// <summary>
 			/// Constructor method used to instantiate a StreamInfo object in system memory.
 			/// </summary>
-			StreamInfo(std::ifstream *stream, const std::string &filePath, int currentLine, int prevIndent);
+			StreamInfo(FileStream *stream, const std::string &filePath, int currentLine, int prevIndent);
 
 			// NOTE: These members are owned by the reader that owns this struct, so are not deleted when this is destroyed.
-			std::ifstream *Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
+			FileStream *Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
 			std::string FilePath; //!< Currently used stream's filepath.
 			int CurrentLine; //!< The line number the stream is on.
 			int PreviousIndent; //!< Count of tabs encountered on the last line DiscardEmptySpace() discarded.
 		};
 
-		std::unique_ptr<std::ifstream> m_Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
+		std::unique_ptr<FileStream> m_Stream; //!< Currently used stream, is not on the StreamStack until a new stream is opened.
 		std::stack<StreamInfo> m_StreamStack; //!< Stack of open streams in this GUIReader, each one representing a file opened to read from within another.
+		std::unordered_map<std::string, std::unique_ptr<PrefetchedFile>> m_PrefetchedFiles; //!< Include files found in the text read so far that are being loaded in the background, by path.
+		size_t m_PrefetchCount; //!< How many include file prefetches were started, used to tell which of the prefetched files is the oldest.
+		std::deque<PrefetchedFile *> m_PrefetchQueue; //!< Prefetched files the prefetch thread hasn't started loading yet, oldest first. Owned by m_PrefetchedFiles.
+		std::thread m_PrefetchThread; //!< Loads the queued include files one after another. Started by the first prefetch.
+		std::mutex m_PrefetchMutex; //!< Guards m_PrefetchQueue and m_StopPrefetching.
+		std::condition_variable m_PrefetchQueued; //!< Wakes the prefetch thread when a file is queued or it should stop.
+		bool m_StopPrefetching; //!< Tells the prefetch thread to stop.
 		bool m_EndOfStreams; //!< All streams have been depleted.
 
 		std::string m_FilePath; //!< Currently used stream's filepath.
@@ -186,6 +201,18 @@ namespace RTE {
 		/// </summary>
 		/// <returns>Whether there were any stream on the stack to resume.</returns>
 		bool EndIncludeFile();
+
+		/// <summary>
+		/// Starts loading the files named by any IncludeFile properties in a piece of text in the background, so they are ready by the time StartIncludeFile reaches them.
+		/// A match inside a comment or a value cut off at the end of the text only costs a wasted or skipped prefetch, never a difference in what is read.
+		/// </summary>
+		/// <param name="text">The text to look for include files in.</param>
+		void PrefetchIncludeFiles(std::string_view text);
+
+		/// <summary>
+		/// Runs on the prefetch thread, loading the queued include files oldest first until the reader is destroyed.
+		/// </summary>
+		void LoadPrefetchedFiles();
 #pragma endregion
 
 		/// <summary>
@@ -8,6 +8,8 @@ using namespace RTE;
 GUIScrollPanel::GUIScrollPanel(GUIManager *Manager) : GUIPanel(Manager) {
 	m_Skin = nullptr;
 	m_DrawBitmap[0] = m_DrawBitmap[1] = m_DrawBitmap[2] = nullptr;
+	m_ButtonUpSection = m_ButtonDownSection = nullptr;
+	m_KnobUpSection = m_KnobDownSection = nullptr;
 	m_ButtonSize = 17;
 	m_MinimumKnobSize = 9;
 	m_SmallChange = 1;
@@ -24,6 +26,8 @@ GUIScrollPanel::GUIScrollPanel(GUIManager *Manager) : GUIPanel(Manager) {
 GUIScrollPanel::GUIScrollPanel() : GUIPanel() {
 	m_Skin = nullptr;
 	m_DrawBitmap[0] = m_DrawBitmap[1] = m_DrawBitmap[2] = nullptr;
+	m_ButtonUpSection = m_ButtonDownSection = nullptr;
+	m_KnobUpSection = m_KnobDownSection = nullptr;
 	m_ButtonSize = 17;
 	m_MinimumKnobSize = 9;
 	m_SmallChange = 1;
@@ -93,6 +97,11 @@ void GUIScrollPanel::ChangeSkin(GUISkin *Skin) {
 
 	m_Skin = Skin;
 
+	m_ButtonUpSection = m_Skin->GetSection("ScrollButton_Up");
+	m_ButtonDownSection = m_Skin->GetSection("ScrollButton_Down");
+	m_KnobUpSection = m_Skin->GetSection("ScrollKnob_Up");
+	m_KnobDownSection = m_Skin->GetSection("ScrollKnob_Down");
+
 	// Build the bitmap
 	BuildBitmap(true, true);
 }
@@ -100,6 +109,8 @@ void GUIScrollPanel::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIScrollPanel::BuildBitmap(bool UpdateSize, bool UpdateKnob) {
+	Invalidate();
+
 	// It is normal if this function is called but the skin has not been set so we just ignore the call if the skin has not been set
 	if (!m_Skin) {
 		return;
@@ -170,12 +181,12 @@ void GUIScrollPanel::BuildBitmap(bool UpdateSize, bool UpdateKnob) {
 	if (UpdateKnob && m_KnobLength > 0) {
 		if (m_Orientation == Vertical) {
 			// Vertical
-			BuildKnob("ScrollKnob_Up", 0, 0, m_Width, m_KnobLength);
-			BuildKnob("ScrollKnob_Down", m_Width, 0, m_Width, m_KnobLength);
+			BuildKnob(m_KnobUpSection, 0, 0, m_Width, m_KnobLength);
+			BuildKnob(m_KnobDownSection, m_Width, 0, m_Width, m_KnobLength);
 		} else {
 			// Horizontal
-			BuildKnob("ScrollKnob_Up", 0, 0, m_KnobLength, m_Height);
-			BuildKnob("ScrollKnob_Down", 0, m_Height, m_KnobLength, m_Height);
+			BuildKnob(m_KnobUpSection, 0, 0, m_KnobLength, m_Height);
+			BuildKnob(m_KnobDownSection, 0, m_Height, m_KnobLength, m_Height);
 		}
 	}
 
@@ -188,9 +199,9 @@ void GUIScrollPanel::BuildBitmap(bool UpdateSize, bool UpdateKnob) {
 
 void GUIScrollPanel::BuildButton(const std::string &ArrowName, int Y, int Width, int Height) {
 	// Create the buttons
-	m_Skin->BuildStandardRect(m_DrawBitmap[ButtonStates], "ScrollButton_Up", 0, Y, Width, Height);
+	m_Skin->BuildStandardRect(m_DrawBitmap[ButtonStates], m_ButtonUpSection, 0, Y, Width, Height);
 
-	m_Skin->BuildStandardRect(m_DrawBitmap[ButtonStates], "ScrollButton_Down", Width, Y, Width, Height);
+	m_Skin->BuildStandardRect(m_DrawBitmap[ButtonStates], m_ButtonDownSection, Width, Y, Width, Height);
 
 	// Draw the arrows
 	int Values[4];
@@ -244,13 +255,15 @@ void GUIScrollPanel::BuildBackground() {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void GUIScrollPanel::BuildKnob(const std::string &Section, int X, int Y, int Width, int Height) {
+void GUIScrollPanel::BuildKnob(const GUISkin::SkinSection *Section, int X, int Y, int Width, int Height) {
 	if (m_DrawBitmap[KnobStates]) { m_Skin->BuildStandardRect(m_DrawBitmap[KnobStates], Section, X, Y, Width, Height); }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIScrollPanel::SetMinimum(int Min) {
+	Invalidate();
+
 	m_Minimum = Min;
 	m_Minimum = std::min(m_Minimum, m_Maximum);
 
@@ -261,6 +274,8 @@ void GUIScrollPanel::SetMinimum(int Min) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIScrollPanel::SetMaximum(int Max) {
+	Invalidate();
+
 	m_Maximum = Max;
 	m_Maximum = std::max(m_Maximum, m_Minimum);
 
@@ -281,6 +296,8 @@ void GUIScrollPanel::SetValue(int Value) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIScrollPanel::SetPageSize(int PageSize) {
+	Invalidate();
+
 	m_PageSize = PageSize;
 	m_PageSize = std::max(m_PageSize, 1);
 
@@ -291,6 +308,8 @@ void GUIScrollPanel::SetPageSize(int PageSize) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIScrollPanel::SetOrientation(int Orientation) {
+	Invalidate();
+
 	m_Orientation = Orientation;
 
 	// Rebuild the whole bitmap
@@ -371,6 +390,14 @@ void GUIScrollPanel::Draw(GUIScreen *Screen) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void GUIScrollPanel::PrepareDraw(GUIScreen *Screen) {
+	if (m_RebuildKnob || m_RebuildSize) { BuildBitmap(m_RebuildSize, m_RebuildKnob); }
+
+	GUIPanel::PrepareDraw(Screen);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void GUIScrollPanel::OnMouseDown(int X, int Y, int Buttons, int Modifier) {
 	m_ButtonPushed[0] = m_ButtonPushed[1] = false;
 	m_GrabbedKnob = false;
@@ -638,6 +665,8 @@ void GUIScrollPanel::SetSize(int Width, int Height) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUIScrollPanel::CalculateKnob() {
+	Invalidate();
+
 	int MoveLength = 1;
 
 	// Calculate the length of the movable area (panel minus buttons)
@@ -87,6 +87,15 @@ public:
     void Draw(GUIScreen *Screen) override;
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PrepareDraw
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Rebuilds the bitmaps if needed before drawing in tiles.
+// Arguments:       Screen class
+
+    void PrepareDraw(GUIScreen *Screen) override;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          OnMouseDown
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -278,6 +287,12 @@ private:
 	GUISkin *m_Skin;
 	GUIBitmap *m_DrawBitmap[3];
 
+	// Skin sections of the buttons and the knob, looked up when the skin changes
+	const GUISkin::SkinSection *m_ButtonUpSection;
+	const GUISkin::SkinSection *m_ButtonDownSection;
+	const GUISkin::SkinSection *m_KnobUpSection;
+	const GUISkin::SkinSection *m_KnobDownSection;
+
 	// User attributes
 	int m_Orientation;
 	int m_Minimum;
@@ -324,7 +339,7 @@ private:
 // Description:     Build the knob.
 // Arguments:       None.
 
-    void BuildKnob(const std::string &Section, int X, int Y, int Width, int Height);
+    void BuildKnob(const GUISkin::SkinSection *Section, int X, int Y, int Width, int Height);
 
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -13,6 +13,11 @@ GUISkin::GUISkin(GUIScreen *Screen) {
 	m_MousePointers[1] = nullptr;
 	m_MousePointers[2] = nullptr;
 
+	m_NineSliceBudget = 4 * 1024 * 1024;
+	m_NineSliceCacheSize = 0;
+	m_NineSliceHits = 0;
+	m_NineSliceMisses = 0;
+
 	Clear();
 }
 
@@ -26,6 +31,7 @@ GUISkin::~GUISkin() {
 
 void GUISkin::Clear() {
 	m_PropList.clear();
+	m_SectionMap.clear();
 	m_ImageCache.clear();
 	m_FontCache.clear();
 	m_Directory = "";
@@ -46,6 +52,7 @@ bool GUISkin::Load(const std::string &directory, const std::string &fileName) {
 
 	// Go through the skin file adding the sections and properties
 	GUIProperties *CurProp = nullptr;
+	bool CurPropIsRepeated = false;
 
 	while (!skinFile.GetStream()->eof()) {
 		std::string line = skinFile.ReadLine();
@@ -56,9 +63,16 @@ bool GUISkin::Load(const std::string &directory, const std::string &fileName) {
 
 		// Is the line a section?
 		if (line.front() == '[' && line.back() == ']') {
-			GUIProperties *p = new GUIProperties(line.substr(1, line.size() - 2));
-			CurProp = p;
-			m_PropList.push_back(p);
+			std::string SectionName = line.substr(1, line.size() - 2);
+			SkinSection &Section = m_SectionMap[GetSectionKey(SectionName)];
+
+			// A repeated section adds to the first one with that name
+			CurPropIsRepeated = Section.m_Properties != nullptr;
+			if (!CurPropIsRepeated) {
+				Section.m_Properties = new GUIProperties(SectionName);
+				m_PropList.push_back(Section.m_Properties);
+			}
+			CurProp = Section.m_Properties;
 			continue;
 		}
 
@@ -71,13 +85,25 @@ bool GUISkin::Load(const std::string &directory, const std::string &fileName) {
 				std::string Name = skinFile.TrimString(line.substr(0, Position));
 				std::string Value = skinFile.TrimString(line.substr(Position + 1, std::string::npos));
 
-				// Add it to the current property
-				CurProp->AddVariable(Name, Value);
+				// Add it to the current property. Variables already set by an earlier section of the same name take precedence
+				std::string ExistingValue;
+				if (!CurPropIsRepeated || !CurProp->GetValue(Name, &ExistingValue)) { CurProp->AddVariable(Name, Value); }
 			}
 			continue;
 		}
 	}
 
+	// Start decoding every image and font sheet the skin names at once, the CreateBitmap calls below then only have to pick them up
+	std::vector<std::string> ImageFiles;
+	std::string ImageFile;
+	for (GUIProperties *Prop : m_PropList) {
+		if (Prop->GetValue("Filename", &ImageFile)) { ImageFiles.push_back(m_Directory + "/" + ImageFile); }
+		if (Prop->GetValue("Font", &ImageFile)) { ImageFiles.push_back(m_Directory + "/" + ImageFile); }
+	}
+	m_Screen->PreloadBitmaps(ImageFiles);
+
+	CompileSections();
+
 	// Load the mouse pointers
 	m_MousePointers[0] = LoadMousePointer("Mouse_Pointer");
 	m_MousePointers[1] = LoadMousePointer("Mouse_Text");
@@ -88,74 +114,37 @@ bool GUISkin::Load(const std::string &directory, const std::string &fileName) {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool GUISkin::GetValue(const std::string &Section, const std::string &Variable, std::string *Value) {
-	std::vector <GUIProperties *>::iterator it;
-
-	// Find the property
-	for (it = m_PropList.begin(); it != m_PropList.end(); it++) {
-		GUIProperties *p = *it;
+const GUISkin::SkinSection * GUISkin::GetSection(const std::string &Section) const {
+	std::unordered_map<std::string, SkinSection>::const_iterator it = m_SectionMap.find(GetSectionKey(Section));
+	return (it != m_SectionMap.end()) ? &it->second : nullptr;
+}
 
-		if (stricmp(p->GetName().c_str(), Section.c_str()) == 0 && p->GetValue(Variable, Value)) {
-			return true;
-		}
-	}
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	// Not found
-	return false;
+bool GUISkin::GetValue(const std::string &Section, const std::string &Variable, std::string *Value) {
+	const SkinSection *S = GetSection(Section);
+	return S && S->m_Properties->GetValue(Variable, Value);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 int GUISkin::GetValue(const std::string &Section, const std::string &Variable, int *Array, int MaxArraySize) {
-	std::vector <GUIProperties *>::iterator it;
-
-	// Find the property
-	for (it = m_PropList.begin(); it != m_PropList.end(); it++) {
-		GUIProperties *p = *it;
-
-		if (stricmp(p->GetName().c_str(), Section.c_str()) == 0 && p->GetValue(Variable, Array, MaxArraySize)) {
-			return true;
-		}
-	}
-
-	// Not found
-	return false;
+	const SkinSection *S = GetSection(Section);
+	return S ? S->m_Properties->GetValue(Variable, Array, MaxArraySize) : 0;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool GUISkin::GetValue(const std::string &Section, const std::string &Variable, int *Value) {
-	std::vector <GUIProperties *>::iterator it;
-
-	// Find the property
-	for (it = m_PropList.begin(); it != m_PropList.end(); it++) {
-		GUIProperties *p = *it;
-
-		if (stricmp(p->GetName().c_str(), Section.c_str()) == 0 && p->GetValue(Variable, Value)) {
-			return true;
-		}
-	}
-
-	// Not found
-	return false;
+	const SkinSection *S = GetSection(Section);
+	return S && S->m_Properties->GetValue(Variable, Value);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool GUISkin::GetValue(const std::string &Section, const std::string &Variable, unsigned long *Value) {
-	std::vector <GUIProperties *>::iterator it;
-
-	// Find the property
-	for (it = m_PropList.begin(); it != m_PropList.end(); it++) {
-		GUIProperties *p = *it;
-
-		if (stricmp(p->GetName().c_str(), Section.c_str()) == 0 && p->GetValue(Variable, Value)) {
-			return true;
-		}
-	}
-
-	// Not found
-	return false;
+	const SkinSection *S = GetSection(Section);
+	return S && S->m_Properties->GetValue(Variable, Value);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -172,6 +161,10 @@ void GUISkin::Destroy() {
 
 	m_PropList.clear();
 
+	// The cached frames are keyed on the sections so they go first
+	TrimNineSliceCache(0);
+	m_SectionMap.clear();
+
 	// Destroy the fonts in the list
 	std::vector<GUIFont *>::iterator itf;
 
@@ -289,48 +282,61 @@ void GUISkin::DrawMouse(int Image, int X, int Y) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUISkin::BuildStandardRect(GUIBitmap *Dest, const std::string &Section, int X, int Y, int Width, int Height, bool buildBG, bool buildFrame, GUIRect *borderSizes) {
+	BuildStandardRect(Dest, GetSection(Section), X, Y, Width, Height, buildBG, buildFrame, borderSizes);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUISkin::BuildStandardRect(GUIBitmap *Dest, const SkinSection *Section, int X, int Y, int Width, int Height, bool buildBG, bool buildFrame, GUIRect *borderSizes) {
 	// Note: For a control to use a 'Standard Rect' it must use the 8 side names, a filler name and a filename property.
+	if (!Section || !Section->m_IsStandardRect || !Section->m_Bitmap) {
+		if (borderSizes) { SetRect(borderSizes, 0, 0, 0, 0); }
+		return;
+	}
+	if (borderSizes) {
+		const GUIRect *Rects = Section->m_Rects;
+		SetRect(borderSizes, Rects[RectLeft].right - Rects[RectLeft].left, Rects[RectTop].bottom - Rects[RectTop].top, Rects[RectRight].right - Rects[RectRight].left, Rects[RectBottom].bottom - Rects[RectBottom].top);
+	}
+
+	GUIBitmap *Cached = GetCachedStandardRect(Section, Width, Height, buildBG, buildFrame);
+	if (!Cached) {
+		DrawStandardRect(Dest, Section, X, Y, Width, Height, buildBG, buildFrame);
+		return;
+	}
+	// The cached bitmap includes the color key fill, so a plain copy gives the same result as building in place
+	unsigned long ColorKey = Section->m_Bitmap->GetPixel(Section->m_Bitmap->GetWidth() - 1, 0);
+	Cached->Draw(Dest, X, Y, nullptr);
+	Dest->SetColorKey(ColorKey);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	int VTopLeft[4];
-	int VTop[4];
-	int VTopRight[4];
-	int VLeft[4];
-	int VFiller[4];
-	int VRight[4];
-	int VBottomLeft[4];
-	int VBottom[4];
-	int VBottomRight[4];
+void GUISkin::DrawStandardRect(GUIBitmap *Dest, const SkinSection *Section, int X, int Y, int Width, int Height, bool buildBG, bool buildFrame) {
+	GUIBitmap *SrcBitmap = Section->m_Bitmap;
+
+	GUIRect Filler = Section->m_Rects[RectFiller];
+	GUIRect Top = Section->m_Rects[RectTop];
+	GUIRect Right = Section->m_Rects[RectRight];
+	GUIRect Bottom = Section->m_Rects[RectBottom];
+	GUIRect Left = Section->m_Rects[RectLeft];
+	GUIRect TopLeft = Section->m_Rects[RectTopLeft];
+	GUIRect TopRight = Section->m_Rects[RectTopRight];
+	GUIRect BottomRight = Section->m_Rects[RectBottomRight];
+	GUIRect BottomLeft = Section->m_Rects[RectBottomLeft];
 	int i;
 	int j;
-	GUIRect Rect;
-
-	// Load the filename
-	std::string Filename;
-	GetValue(Section, "Filename", &Filename);
-	GUIBitmap *SrcBitmap = CreateBitmap(Filename);
 
 	// Set the color key to be the same color as the Top-Right hand corner pixel
-	SrcBitmap->SetColorKey(SrcBitmap->GetPixel(SrcBitmap->GetWidth() - 1, 0));
-	Dest->DrawRectangle(X, Y, Width, Height, SrcBitmap->GetPixel(SrcBitmap->GetWidth() - 1, 0), true);
-	Dest->SetColorKey(SrcBitmap->GetPixel(SrcBitmap->GetWidth() - 1, 0));
-
-	GetValue(Section, "Filler", VFiller, 4);
-	GetValue(Section, "Top", VTop, 4);
-	GetValue(Section, "Right", VRight, 4);
-	GetValue(Section, "Bottom", VBottom, 4);
-	GetValue(Section, "Left", VLeft, 4);
-	GetValue(Section, "TopLeft", VTopLeft, 4);
-	GetValue(Section, "TopRight", VTopRight, 4);
-	GetValue(Section, "BottomRight", VBottomRight, 4);
-	GetValue(Section, "BottomLeft", VBottomLeft, 4);
+	unsigned long ColorKey = SrcBitmap->GetPixel(SrcBitmap->GetWidth() - 1, 0);
+	SrcBitmap->SetColorKey(ColorKey);
+	Dest->DrawRectangle(X, Y, Width, Height, ColorKey, true);
+	Dest->SetColorKey(ColorKey);
 
 	if (buildBG) {
-		// Use the filler first
-		SetRect(&Rect, VFiller[0], VFiller[1], VFiller[0] + VFiller[2], VFiller[1] + VFiller[3]);
 		// Tile the filler across
-		for (j = Y + VTop[3]; j < Y + Height - VBottom[3]; j += VFiller[3]) {
-			for (i = X + VLeft[2]; i < X + Width - VRight[2]; i += VFiller[2]) {
-				SrcBitmap->DrawTrans(Dest, i, j, &Rect);
+		for (j = Y + (Top.bottom - Top.top); j < Y + Height - (Bottom.bottom - Bottom.top); j += Filler.bottom - Filler.top) {
+			for (i = X + (Left.right - Left.left); i < X + Width - (Right.right - Right.left); i += Filler.right - Filler.left) {
+				SrcBitmap->DrawTrans(Dest, i, j, &Filler);
 			}
 		}
 	}
@@ -339,47 +345,136 @@ void GUISkin::BuildStandardRect(GUIBitmap *Dest, const std::string &Section, int
 		// Tile the four sides first, then place the four corners last
 
 		// Tile the Top side
-		SetRect(&Rect, VTop[0], VTop[1], VTop[0] + VTop[2], VTop[1] + VTop[3]);
-		for (i = X + VTopLeft[2]; i <= X + Width - VTopRight[2]; i += VTop[2]) {
-			SrcBitmap->DrawTrans(Dest, i, Y, &Rect);
+		for (i = X + (TopLeft.right - TopLeft.left); i <= X + Width - (TopRight.right - TopRight.left); i += Top.right - Top.left) {
+			SrcBitmap->DrawTrans(Dest, i, Y, &Top);
 		}
 
 		// Tile the Right side
-		SetRect(&Rect, VRight[0], VRight[1], VRight[0] + VRight[2], VRight[1] + VRight[3]);
-		for (j = Y + VTopRight[3]; j < Y + Height - VBottomRight[3]; j += VRight[3]) {
-			SrcBitmap->DrawTrans(Dest, X + Width - VRight[2], j, &Rect);
+		for (j = Y + (TopRight.bottom - TopRight.top); j < Y + Height - (BottomRight.bottom - BottomRight.top); j += Right.bottom - Right.top) {
+			SrcBitmap->DrawTrans(Dest, X + Width - (Right.right - Right.left), j, &Right);
 		}
 
 		// Tile the Bottom side
-		SetRect(&Rect, VBottom[0], VBottom[1], VBottom[0] + VBottom[2], VBottom[1] + VBottom[3]);
-		for (i = X + VBottomLeft[2]; i < X + Width - VBottomRight[2]; i += VBottom[2]) {
-			SrcBitmap->DrawTrans(Dest, i, Y + Height - VBottom[3], &Rect);
+		for (i = X + (BottomLeft.right - BottomLeft.left); i < X + Width - (BottomRight.right - BottomRight.left); i += Bottom.right - Bottom.left) {
+			SrcBitmap->DrawTrans(Dest, i, Y + Height - (Bottom.bottom - Bottom.top), &Bottom);
 		}
 
 		// Tile the Left side
-		SetRect(&Rect, VLeft[0], VLeft[1], VLeft[0] + VLeft[2], VLeft[1] + VLeft[3]);
-		for (j = Y + VTopLeft[3]; j < Y + Height - VBottomLeft[3]; j += VLeft[3]) {
-			SrcBitmap->DrawTrans(Dest, X, j, &Rect);
+		for (j = Y + (TopLeft.bottom - TopLeft.top); j < Y + Height - (BottomLeft.bottom - BottomLeft.top); j += Left.bottom - Left.top) {
+			SrcBitmap->DrawTrans(Dest, X, j, &Left);
 		}
 
 		// Top-Left Corner
-		SetRect(&Rect, VTopLeft[0], VTopLeft[1], VTopLeft[0] + VTopLeft[2], VTopLeft[1] + VTopLeft[3]);
-		SrcBitmap->DrawTrans(Dest, X, Y, &Rect);
+		SrcBitmap->DrawTrans(Dest, X, Y, &TopLeft);
 
 		// Top-Right Corner
-		SetRect(&Rect, VTopRight[0], VTopRight[1], VTopRight[0] + VTopRight[2], VTopRight[1] + VTopRight[3]);
-		SrcBitmap->DrawTrans(Dest, X + Width - VTopRight[2], Y, &Rect);
+		SrcBitmap->DrawTrans(Dest, X + Width - (TopRight.right - TopRight.left), Y, &TopRight);
 
 		// Bottom-Right Corner
-		SetRect(&Rect, VBottomRight[0], VBottomRight[1], VBottomRight[0] + VBottomRight[2], VBottomRight[1] + VBottomRight[3]);
-		SrcBitmap->DrawTrans(Dest, X + Width - VBottomRight[2], Y + Height - VBottomRight[3], &Rect);
+		SrcBitmap->DrawTrans(Dest, X + Width - (BottomRight.right - BottomRight.left), Y + Height - (BottomRight.bottom - BottomRight.top), &BottomRight);
 
 		// Bottom-Left Corner
-		SetRect(&Rect, VBottomLeft[0], VBottomLeft[1], VBottomLeft[0] + VBottomLeft[2], VBottomLeft[1] + VBottomLeft[3]);
-		SrcBitmap->DrawTrans(Dest, X, Y + Height - VBottomLeft[3], &Rect);
+		SrcBitmap->DrawTrans(Dest, X, Y + Height - (BottomLeft.bottom - BottomLeft.top), &BottomLeft);
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+GUIBitmap * GUISkin::GetCachedStandardRect(const SkinSection *Section, int Width, int Height, bool buildBG, bool buildFrame) {
+	if (Width <= 0 || Height <= 0) {
+		return nullptr;
+	}
+	NineSliceKey Key = { Section, Width, Height, buildBG, buildFrame };
+
+	std::unordered_map<NineSliceKey, std::list<NineSliceEntry>::iterator, NineSliceKeyHash>::iterator it = m_NineSliceMap.find(Key);
+	if (it != m_NineSliceMap.end()) {
+		m_NineSliceHits++;
+		// Move to the front as the most recently used
+		m_NineSliceCache.splice(m_NineSliceCache.begin(), m_NineSliceCache, it->second);
+		return it->second->m_Bitmap;
 	}
+	m_NineSliceMisses++;
+
+	if (m_NineSliceBudget == 0) {
+		return nullptr;
+	}
+	GUIBitmap *Bitmap = m_Screen->CreateBitmap(Width, Height);
+	if (!Bitmap) {
+		return nullptr;
+	}
+	// Frames that could never fit are built in place every time instead
+	size_t Size = static_cast<size_t>(Width) * static_cast<size_t>(Height) * static_cast<size_t>(std::max(Bitmap->GetColorDepth() / 8, 1));
+	if (Size > m_NineSliceBudget) {
+		Bitmap->Destroy();
+		delete Bitmap;
+		return nullptr;
+	}
+	DrawStandardRect(Bitmap, Section, 0, 0, Width, Height, buildBG, buildFrame);
+
+	m_NineSliceCache.push_front({ Key, Bitmap, Size });
+	m_NineSliceMap.try_emplace(Key, m_NineSliceCache.begin());
+	m_NineSliceCacheSize += Size;
+	TrimNineSliceCache(m_NineSliceBudget);
+
+	return Bitmap;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUISkin::TrimNineSliceCache(size_t Budget) {
+	// Evict the least recently used frames first
+	while (m_NineSliceCacheSize > Budget && !m_NineSliceCache.empty()) {
+		NineSliceEntry &Entry = m_NineSliceCache.back();
+		m_NineSliceMap.erase(Entry.m_Key);
+		m_NineSliceCacheSize -= Entry.m_Size;
+		Entry.m_Bitmap->Destroy();
+		delete Entry.m_Bitmap;
+		m_NineSliceCache.pop_back();
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUISkin::SetNineSliceCacheBudget(size_t Budget) {
+	m_NineSliceBudget = Budget;
+	TrimNineSliceCache(m_NineSliceBudget);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUISkin::CompileSections() {
+	// The variable names of each standard rect part, in StandardRectPart order
+	static const std::array<const char *, StandardRectPartCount> PartNames = { "Filler", "Top", "Right", "Bottom", "Left", "TopLeft", "TopRight", "BottomRight", "BottomLeft" };
+
+	std::unordered_map<std::string, SkinSection>::iterator it;
+	for (it = m_SectionMap.begin(); it != m_SectionMap.end(); it++) {
+		SkinSection &Section = it->second;
+
+		std::string Filename;
+		int Values[4];
+		if (!Section.m_Properties->GetValue("Filename", &Filename) || Section.m_Properties->GetValue("Filler", Values, 4) != 4) {
+			continue;
+		}
+		// The parts are tiled by their own size, so a missing or empty one would never advance and the section can't be used as a standard rect
+		bool AllPartsValid = true;
+		for (int Part = 0; Part < StandardRectPartCount && AllPartsValid; Part++) {
+			AllPartsValid = Section.m_Properties->GetValue(PartNames[Part], Values, 4) == 4 && Values[2] > 0 && Values[3] > 0;
+			SetRect(&Section.m_Rects[Part], Values[0], Values[1], Values[0] + Values[2], Values[1] + Values[3]);
+		}
+		if (!AllPartsValid) {
+			continue;
+		}
+		Section.m_Bitmap = CreateBitmap(Filename);
+		Section.m_IsStandardRect = true;
+	}
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	if (borderSizes) { SetRect(borderSizes, VLeft[2], VTop[3], VRight[2], VBottom[3]); }
+std::string GUISkin::GetSectionKey(const std::string &Section) {
+	std::string Key = Section;
+	std::transform(Key.begin(), Key.end(), Key.begin(), [](unsigned char Char) { return static_cast<char>(std::tolower(Char)); });
+	return Key;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -10,6 +10,33 @@ class GUISkin {
 
 public:
 
+	/// <summary>
+	/// Indices of the nine source rectangles of a standard rect section.
+	/// </summary>
+	enum StandardRectPart {
+		RectFiller = 0,
+		RectTop,
+		RectRight,
+		RectBottom,
+		RectLeft,
+		RectTopLeft,
+		RectTopRight,
+		RectBottomRight,
+		RectBottomLeft,
+		StandardRectPartCount
+	};
+
+	/// <summary>
+	/// A skin section resolved when the skin is loaded. Pointers to these stay valid until the skin is destroyed or reloaded,
+	/// so controls can look them up once in ChangeSkin instead of searching by name on every rebuild.
+	/// </summary>
+	struct SkinSection {
+		GUIProperties *m_Properties = nullptr; //!< The variables of this section.
+		bool m_IsStandardRect = false; //!< Whether this section has a filename and all 9 parts with a non-zero size, so it can be used with BuildStandardRect.
+		GUIBitmap *m_Bitmap = nullptr; //!< The source bitmap of a standard rect section, owned by the image cache.
+		GUIRect m_Rects[StandardRectPartCount]; //!< The decoded source rectangles of a standard rect section, indexed by StandardRectPart.
+	};
+
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // Constructor:     GUISkin
@@ -58,6 +85,17 @@ public:
     void Destroy();
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetSection
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets a resolved skin section. Ownership is NOT transferred!
+// Arguments:       Section name, case insensitive.
+// Returns:         The section, or nullptr if the skin doesn't have it. Valid until the
+//                  skin is destroyed or reloaded.
+
+    const SkinSection * GetSection(const std::string &Section) const;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          GetValue
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -141,6 +179,68 @@ public:
     void BuildStandardRect(GUIBitmap *Dest, const std::string &Section, int X, int Y, int Width, int Height, bool buildBG = true, bool buildFrame = true, GUIRect *borderSizes = nullptr);
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          BuildStandardRect
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Builds a bitmap from an already resolved standard skin property section.
+// Arguments:       Destination bitmap, Section from GetSection, Position, Size. Whether to draw the
+//                  background and frame, a GUIRect to be filled in with the border sizes of the four sides of the built standard rect.
+
+    void BuildStandardRect(GUIBitmap *Dest, const SkinSection *Section, int X, int Y, int Width, int Height, bool buildBG = true, bool buildFrame = true, GUIRect *borderSizes = nullptr);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          SetNineSliceCacheBudget
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Sets how much memory the prebuilt standard rect cache may use. Frames
+//                  over the budget are evicted, least recently used first.
+// Arguments:       The budget in bytes. 0 disables the cache.
+
+    void SetNineSliceCacheBudget(size_t Budget);
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetNineSliceCacheBudget
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how much memory the prebuilt standard rect cache may use.
+// Arguments:       None.
+// Returns:         The budget in bytes.
+
+    size_t GetNineSliceCacheBudget() const { return m_NineSliceBudget; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetNineSliceCacheSize
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how much memory the prebuilt standard rect cache currently uses.
+// Arguments:       None.
+// Returns:         The size in bytes.
+
+    size_t GetNineSliceCacheSize() const { return m_NineSliceCacheSize; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetNineSliceCacheHits
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how many standard rects were copied from the cache instead of
+//                  being built.
+// Arguments:       None.
+// Returns:         The number of cache hits since the skin was created.
+
+    unsigned long GetNineSliceCacheHits() const { return m_NineSliceHits; }
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          GetNineSliceCacheMisses
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Gets how many standard rects had to be built because they weren't
+//                  in the cache.
+// Arguments:       None.
+// Returns:         The number of cache misses since the skin was created.
+
+    unsigned long GetNineSliceCacheMisses() const { return m_NineSliceMisses; }
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          ConvertColor
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -156,14 +256,55 @@ public:
 
 private:
 
+	/// <summary>
+	/// Identifies a prebuilt standard rect by everything that affects how it looks.
+	/// </summary>
+	struct NineSliceKey {
+		const SkinSection *m_Section;
+		int m_Width;
+		int m_Height;
+		bool m_BuildBG;
+		bool m_BuildFrame;
+
+		bool operator==(const NineSliceKey &rhs) const { return m_Section == rhs.m_Section && m_Width == rhs.m_Width && m_Height == rhs.m_Height && m_BuildBG == rhs.m_BuildBG && m_BuildFrame == rhs.m_BuildFrame; }
+	};
+
+	/// <summary>
+	/// Hash function for NineSliceKey.
+	/// </summary>
+	struct NineSliceKeyHash {
+		size_t operator()(const NineSliceKey &key) const {
+			size_t hash = std::hash<const SkinSection *>()(key.m_Section);
+			hash ^= (static_cast<size_t>(key.m_Width) << 1) ^ (static_cast<size_t>(key.m_Height) << 17);
+			return hash ^ (static_cast<size_t>(key.m_BuildBG) << 31) ^ (static_cast<size_t>(key.m_BuildFrame) << 30);
+		}
+	};
+
+	/// <summary>
+	/// A prebuilt standard rect in the cache.
+	/// </summary>
+	struct NineSliceEntry {
+		NineSliceKey m_Key;
+		GUIBitmap *m_Bitmap;
+		size_t m_Size; //!< Memory used by the bitmap, in bytes.
+	};
+
     std::string m_Directory;
     GUIScreen *m_Screen;
     GUIBitmap *m_MousePointers[3];
 
     std::vector<GUIProperties *> m_PropList;
+    std::unordered_map<std::string, SkinSection> m_SectionMap; // Lower case section name to resolved section, sections with the same name are merged
     std::vector<GUIBitmap *> m_ImageCache;
     std::vector<GUIFont *> m_FontCache;
 
+    std::list<NineSliceEntry> m_NineSliceCache; // Prebuilt standard rects, most recently used first
+    std::unordered_map<NineSliceKey, std::list<NineSliceEntry>::iterator, NineSliceKeyHash> m_NineSliceMap;
+    size_t m_NineSliceBudget;
+    size_t m_NineSliceCacheSize;
+    unsigned long m_NineSliceHits;
+    unsigned long m_NineSliceMisses;
+
 	//////////////////////////////////////////////////////////////////////////////////////////
 	// Method:          LoadMousePointer
 	//////////////////////////////////////////////////////////////////////////////////////////
@@ -171,6 +312,58 @@ private:
 	// Arguments:       Section name.
 
 	GUIBitmap * LoadMousePointer(const std::string &Section);
+
+
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Method:          CompileSections
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Description:     Decodes the standard rect sections into their source rectangles and
+	//                  bitmaps after the skin file is read.
+	// Arguments:       None.
+
+	void CompileSections();
+
+
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Method:          DrawStandardRect
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Description:     Tiles a standard rect section onto a bitmap.
+	// Arguments:       Destination bitmap, a valid standard rect section, Position, Size.
+	//                  Whether to draw the background and frame.
+
+	void DrawStandardRect(GUIBitmap *Dest, const SkinSection *Section, int X, int Y, int Width, int Height, bool buildBG, bool buildFrame);
+
+
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Method:          GetCachedStandardRect
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Description:     Gets a prebuilt standard rect, building and caching it if needed.
+	// Arguments:       A valid standard rect section, Size. Whether to draw the background
+	//                  and frame.
+	// Returns:         The prebuilt bitmap, or nullptr if it can't be cached. Ownership is
+	//                  NOT transferred!
+
+	GUIBitmap * GetCachedStandardRect(const SkinSection *Section, int Width, int Height, bool buildBG, bool buildFrame);
+
+
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Method:          TrimNineSliceCache
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Description:     Evicts the least recently used prebuilt standard rects until the
+	//                  cache fits the budget.
+	// Arguments:       The budget in bytes.
+
+	void TrimNineSliceCache(size_t Budget);
+
+
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Method:          GetSectionKey
+	//////////////////////////////////////////////////////////////////////////////////////////
+	// Description:     Gets the key a section name is stored under in the section map.
+	// Arguments:       Section name.
+	// Returns:         The lower case section name.
+
+	static std::string GetSectionKey(const std::string &Section);
 };
 };
 #endif
\ No newline at end of file
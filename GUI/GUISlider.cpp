@@ -125,6 +125,8 @@ void GUISlider::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUISlider::BuildBitmap() {
+	Invalidate();
+
 	// Free any old bitmaps
 	if (m_DrawBitmap) {
 		m_DrawBitmap->Destroy();
@@ -400,6 +402,8 @@ GUIPanel * GUISlider::GetPanel() {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUISlider::CalculateKnob() {
+	Invalidate();
+
 	if (!m_KnobImage) {
 		return;
 	}
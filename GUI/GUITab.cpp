@@ -80,6 +80,8 @@ void GUITab::ChangeSkin(GUISkin *Skin) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUITab::BuildBitmap() {
+	Invalidate();
+
 	std::string Filename;
 	unsigned long ColorIndex = 0;
 	int Values[4];
@@ -132,8 +134,10 @@ void GUITab::Draw(GUIScreen *Screen) {
 		return;
 	}
 
-	// Setup the clipping
-	Screen->GetBitmap()->SetClipRect(GetRect());
+	// Setup the clipping, keeping within the area already being clipped to
+	GUIRect PrevClip;
+	Screen->GetBitmap()->GetClipRect(&PrevClip);
+	Screen->GetBitmap()->AddClipRect(GetRect());
 
 	// Calculate the y position of the base
 	// Make it centered vertically
@@ -172,7 +176,7 @@ void GUITab::Draw(GUIScreen *Screen) {
 		// TODO: DONT HARDCODE TEXT OFFSET
 		m_Font->Draw(Screen->GetBitmap(), m_X + 4, m_Y + (m_Height / 2) - (m_Font->GetFontHeight() / 2) - 1, Text, m_FontShadow);
 	}
-	Screen->GetBitmap()->SetClipRect(0);
+	Screen->GetBitmap()->SetClipRect(&PrevClip);
 
 	GUIPanel::Draw(Screen);
 }
@@ -259,6 +263,7 @@ void GUITab::SetCheck(bool Check) {
 		return;
 	}
 	m_Selected = Check;
+	Invalidate();
 
 	AddEvent(GUIEvent::Notification, Changed, Check);
 
@@ -298,6 +303,8 @@ bool GUITab::GetCheck() const {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUITab::SetText(const std::string &Text) {
+	Invalidate();
+
 	m_Text = Text;
 }
 
@@ -10,7 +10,7 @@ GUITextPanel::GUITextPanel(GUIManager *Manager) : GUIPanel(Manager) {
 	m_CursorX = m_CursorY = 0;
 	m_CursorIndex = 0;
 	m_CursorColor = 0;
-	m_CursorBlinkCount = 0;
+	m_CursorShown = false;
 
 	m_FontColor = 0;
 	m_FontSelectColor = 0;
@@ -36,7 +36,7 @@ GUITextPanel::GUITextPanel() : GUIPanel() {
 	m_CursorX = m_CursorY = 0;
 	m_CursorIndex = 0;
 	m_CursorColor = 0;
-	m_CursorBlinkCount = 0;
+	m_CursorShown = false;
 	m_FontColor = 0;
 	m_FontSelectColor = 0;
 	m_StartIndex = 0;
@@ -103,11 +103,12 @@ void GUITextPanel::Draw(GUIScreen *Screen) {
 	int wSpacer = m_WidthMargin;
 	int hSpacer = m_HeightMargin;
 
-	// Clamp the cursor
-	m_CursorX = std::max(m_CursorX, 0);
+	if (!IsDrawingTiles()) { UpdateCursor(); }
 
-	// Setup the clipping
-	Screen->GetBitmap()->SetClipRect(GetRect());
+	// Setup the clipping, keeping within the area already being clipped to
+	GUIRect PrevClip;
+	Screen->GetBitmap()->GetClipRect(&PrevClip);
+	Screen->GetBitmap()->AddClipRect(GetRect());
 
 	std::string Text = m_Text.substr(m_StartIndex);
 
@@ -134,11 +135,33 @@ void GUITextPanel::Draw(GUIScreen *Screen) {
 	}
 
 
-	// If we have focus, draw the cursor with hacky blink
-	if (m_GotFocus && (m_CursorBlinkCount++ % 30 > 15)) { Screen->GetBitmap()->DrawRectangle(m_X + m_CursorX + 2, m_Y + hSpacer + m_CursorY + 2, 1, FontHeight - 3, m_CursorColor, true); }
+	// If we have focus, draw the blinking cursor
+	if (m_GotFocus && m_CursorShown) { Screen->GetBitmap()->DrawRectangle(m_X + m_CursorX + 2, m_Y + hSpacer + m_CursorY + 2, 1, FontHeight - 3, m_CursorColor, true); }
+
+	// Restore the previous clipping
+	Screen->GetBitmap()->SetClipRect(&PrevClip);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUITextPanel::PrepareDraw(GUIScreen *Screen) {
+	UpdateCursor();
 
-	// Restore normal clipping
-	Screen->GetBitmap()->SetClipRect(nullptr);
+	GUIPanel::PrepareDraw(Screen);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GUITextPanel::UpdateCursor() {
+	m_CursorX = std::max(m_CursorX, 0);
+
+	// Come back when the cursor next blinks
+	m_CursorShown = false;
+	if (m_GotFocus) {
+		const double BlinkPeriod = 500.0;
+		m_CursorShown = m_CursorBlinkTimer.AlternateReal(BlinkPeriod);
+		InvalidateAfter((BlinkPeriod / 2.0) - std::fmod(m_CursorBlinkTimer.GetElapsedRealTimeMS(), BlinkPeriod / 2.0));
+	}
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -387,6 +410,8 @@ void GUITextPanel::OnMouseUp(int X, int Y, int Buttons, int Modifier) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUITextPanel::UpdateText(bool Typing, bool DoIncrement) {
+	Invalidate();
+
 	if (!m_Font) {
 		return;
 	}
@@ -575,6 +600,8 @@ void GUITextPanel::SetText(const std::string &Text) {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GUITextPanel::SetRightText(const std::string &rightText) {
+	Invalidate();
+
 	m_RightText = rightText;
 	SendSignal(Changed, 0);
 }
@@ -1,6 +1,10 @@
 #ifndef _GUITEXTPANEL_
 #define _GUITEXTPANEL_
 
+#ifdef GUI_STANDALONE
+#include "Timer.h"
+#endif
+
 namespace RTE {
 
 /// <summary>
@@ -66,6 +70,15 @@ public:
     void Draw(GUIScreen *Screen) override;
 
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          PrepareDraw
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Updates the cursor blinking before drawing in tiles.
+// Arguments:       Screen class
+
+    void PrepareDraw(GUIScreen *Screen) override;
+
+
 //////////////////////////////////////////////////////////////////////////////////////////
 // Method:          OnMouseDown
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -257,7 +270,8 @@ private:
 	int m_CursorY;
 	int m_CursorIndex;
 	unsigned long m_CursorColor;
-	int m_CursorBlinkCount; // Hacky way to make cursor blink without a timer
+	Timer m_CursorBlinkTimer; // Times the cursor blinking
+	bool m_CursorShown; // Whether the cursor is drawn, as of the last UpdateCursor
 
 	int m_StartIndex;
 
@@ -307,6 +321,16 @@ private:
     /// <param name="currentIndex">The index in the string to start looking from.</param>
     /// <returns>The index of the start of the previous contiguous group of letters or special characters in the given string, or the end of the string if there is none.</returns>
     int GetStartOfPreviousCharacterGroup(const std::string_view &stringToCheck, int currentIndex) const;
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// Method:          UpdateCursor
+//////////////////////////////////////////////////////////////////////////////////////////
+// Description:     Clamps the cursor and works out whether it's blinked on, scheduling
+//                  the repaint for when it next blinks.
+// Arguments:       None.
+
+    void UpdateCursor();
 };
 };
 #endif
\ No newline at end of file
@@ -1,4 +1,4 @@
-#include "GUIUtil.h"
+#include "GUI.h"
 
 #ifdef _WIN32
 #include "Windows.h"
@@ -82,4 +82,29 @@ namespace RTE {
 #endif
 		return false;
 	}
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GUIUtil::MergeOverlappingRects(std::vector<GUIRect> &rectList) {
+		// A grown rect may now overlap ones before or after it that were already checked, so start over after every merge until no two overlap
+		bool merged = true;
+		while (merged) {
+			merged = false;
+			for (size_t i = 0; i < rectList.size() && !merged; ++i) {
+				for (size_t j = i + 1; j < rectList.size(); ++j) {
+					if (RectsOverlap(rectList[i], rectList[j])) {
+						GUIRect &mergedRect = rectList[i];
+						mergedRect.left = std::min(mergedRect.left, rectList[j].left);
+						mergedRect.top = std::min(mergedRect.top, rectList[j].top);
+						mergedRect.right = std::max(mergedRect.right, rectList[j].right);
+						mergedRect.bottom = std::max(mergedRect.bottom, rectList[j].bottom);
+
+						rectList[j] = rectList.back();
+						rectList.pop_back();
+						merged = true;
+						break;
+					}
+				}
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -30,6 +30,12 @@ namespace RTE {
 		/// <param name="text">String to put into the clipboard.</param>
 		/// <returns>True if text was added to the clipboard.</returns>
 		static bool SetClipboardText(std::string text);
+
+		/// <summary>
+		/// Merges overlapping rectangles in a list into their bounding rectangles so no area is covered more than once.
+		/// </summary>
+		/// <param name="rectList">The list of rectangles to merge. Merged rectangles are removed from it.</param>
+		static void MergeOverlappingRects(std::vector<GUIRect> &rectList);
 	};
 }
 #endif
\ No newline at end of file
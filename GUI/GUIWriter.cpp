@@ -1,11 +1,14 @@
 #include "GUIWriter.h"
 
+#include <charconv>
+
 namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void GUIWriter::Clear() {
 		m_Stream = nullptr;
+		m_Buffer.clear();
 		m_FilePath.clear();
 		m_FolderPath.clear();
 		m_FileName.clear();
@@ -18,6 +21,12 @@ namespace RTE {
 		Clear();
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GUIWriter::~GUIWriter() {
+		if (m_Stream && m_Stream->is_open()) { FlushBuffer(); }
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	int GUIWriter::Create(const std::string &fileName, bool append) {
@@ -28,7 +37,13 @@ namespace RTE {
 		m_FileName = m_FilePath.substr(slashPos + 1);
 		m_FolderPath = m_FilePath.substr(0, slashPos + 1);
 
-		m_Stream = std::make_unique<std::ofstream>(fileName, append ? (std::ios::out | std::ios::app | std::ios::ate) : (std::ios::out | std::ios::trunc));
+		// The stream is left unbuffered so each flush of m_Buffer is a single write. This has to be set before the file is opened.
+		m_Stream = std::make_unique<std::ofstream>();
+		m_Stream->rdbuf()->pubsetbuf(nullptr, 0);
+		m_Stream->open(fileName, append ? (std::ios::out | std::ios::app | std::ios::ate) : (std::ios::out | std::ios::trunc));
+
+		m_Buffer.clear();
+		m_Buffer.reserve(c_FlushThreshold + 1024);
 
 		if (!m_Stream->good()) {
 			return -1;
@@ -57,7 +72,8 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void GUIWriter::ObjectStart(const std::string &className) {
-		*m_Stream << className; ++m_IndentCount;
+		m_Buffer.append(className); ++m_IndentCount;
+		FlushIfFull();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -69,32 +85,36 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void GUIWriter::NewLine(bool toIndent, int lineCount) const {
+	void GUIWriter::NewLine(bool toIndent, int lineCount) {
 		for (int lines = 0; lines < lineCount; ++lines) {
-			*m_Stream << "\n";
-			if (toIndent) { *m_Stream << std::string(m_IndentCount, '\t'); }
+			m_Buffer.push_back('\n');
+			if (toIndent) { m_Buffer.append(m_IndentCount, '\t'); }
 		}
+		FlushIfFull();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void GUIWriter::NewLineString(const std::string &textString, bool toIndent) const {
+	void GUIWriter::NewLineString(const std::string &textString, bool toIndent) {
 		NewLine(toIndent);
-		*m_Stream << textString;
+		*this << textString;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void GUIWriter::NewDivider(bool toIndent, int dividerLength) const {
+	void GUIWriter::NewDivider(bool toIndent, int dividerLength) {
 		NewLine(toIndent);
-		*m_Stream << std::string(dividerLength, '/');
+		m_Buffer.append(dividerLength, '/');
+		FlushIfFull();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void GUIWriter::NewProperty(const std::string &propName) const {
+	void GUIWriter::NewProperty(const std::string &propName) {
 		NewLine();
-		*m_Stream << propName + " = ";
+		m_Buffer.append(propName);
+		m_Buffer.append(" = ");
+		FlushIfFull();
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -105,114 +125,149 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	void GUIWriter::EndWrite() const {
+	bool GUIWriter::EndWrite() {
+		FlushBuffer();
 		m_Stream->flush();
 		m_Stream->close();
+		return !m_Stream->fail();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void GUIWriter::FlushBuffer() {
+		if (!m_Buffer.empty()) {
+			m_Stream->write(m_Buffer.data(), m_Buffer.size());
+			m_Buffer.clear();
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	template <typename Type> void GUIWriter::AppendInteger(Type value) {
+		char buf[24];
+		std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), value);
+		m_Buffer.append(buf, result.ptr);
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const bool &var) {
-		*m_Stream << var;
+		m_Buffer.push_back(var ? '1' : '0');
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const char &var) {
-		*m_Stream << var;
+		m_Buffer.push_back(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const unsigned char &var) {
-		int temp = var;
-		*m_Stream << temp;
+		AppendInteger(static_cast<int>(var));
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const short &var) {
-		*m_Stream << var;
+		AppendInteger(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const unsigned short &var) {
-		*m_Stream << var;
+		AppendInteger(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const int &var) {
-		*m_Stream << var;
+		AppendInteger(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const unsigned int &var) {
-		*m_Stream << var;
+		AppendInteger(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const long &var) {
-		*m_Stream << var;
+		AppendInteger(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const long long &var) {
-		*m_Stream << var;
+		AppendInteger(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const unsigned long &var) {
-		*m_Stream << var;
+		AppendInteger(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const unsigned long long &var) {
-		*m_Stream << var;
+		AppendInteger(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const float &var) {
-		*m_Stream << var;
+		*this << static_cast<double>(var);
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const double &var) {
-		*m_Stream << var;
+		// Same formatting as streaming it with the default precision
+		char buf[32];
+		int length = std::snprintf(buf, sizeof(buf), "%g", var);
+		m_Buffer.append(buf, std::clamp(length, 0, static_cast<int>(sizeof(buf)) - 1));
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const char *var) {
-		*m_Stream << var;
+		m_Buffer.append(var);
+		FlushIfFull();
 		return *this;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	GUIWriter & GUIWriter::operator<<(const std::string &var) {
-		*m_Stream << var;
+		m_Buffer.append(var);
+		FlushIfFull();
 		return *this;
 	}
-}
\ No newline at end of file
+}
@@ -16,6 +16,11 @@ namespace RTE {
 		/// </summary>
 		GUIWriter();
 
+		/// <summary>
+		/// Destructor method used to clean up a GUIWriter object before deletion from system memory. Writes out anything still buffered.
+		/// </summary>
+		~GUIWriter();
+
 		/// <summary>
 		/// Makes the GUIWriter object ready for use.
 		/// </summary>
@@ -62,27 +67,27 @@ namespace RTE {
 		/// </summary>
 		/// <param name="toIndent">Whether to indent the new line or not.</param>
 		/// <param name="lineCount">How many new lines to create.</param>
-		void NewLine(bool toIndent = true, int lineCount = 1) const;
+		void NewLine(bool toIndent = true, int lineCount = 1);
 
 		/// <summary>
 		/// Creates a new line and writes the specified string to it.
 		/// </summary>
 		/// <param name="textString">The text string to write to the new line.</param>
 		/// <param name="toIndent">Whether to indent the new line or not.</param>
-		void NewLineString(const std::string &textString, bool toIndent = true) const;
+		void NewLineString(const std::string &textString, bool toIndent = true);
 
 		/// <summary>
 		/// Creates a new line and fills it with slashes to create a divider line for INI.
 		/// </summary>
 		/// <param name="toIndent">Whether to indent the new line or not.</param>
 		/// <param name="dividerLength">The length of the divider (number of slashes).</param>
-		void NewDivider(bool toIndent = true, int dividerLength = 72) const;
+		void NewDivider(bool toIndent = true, int dividerLength = 72);
 
 		/// <summary>
 		/// Creates a new line and writes the name of the property in preparation to writing it's value.
 		/// </summary>
 		/// <param name="propName">The name of the property to be written.</param>
-		void NewProperty(const std::string &propName) const;
+		void NewProperty(const std::string &propName);
 #pragma endregion
 
 #pragma region Writer Status
@@ -95,7 +100,8 @@ namespace RTE {
 		/// <summary>
 		/// Flushes and closes the output stream of this GUIWriter. This happens automatically at destruction but needs to be called manually if a written file must be read from in the same scope.
 		/// </summary>
-		void EndWrite() const;
+		/// <returns>Whether everything written since Create made it to the file.</returns>
+		bool EndWrite();
 #pragma endregion
 
 #pragma region Operator Overloads
@@ -123,7 +129,10 @@ namespace RTE {
 
 	protected:
 
-		std::unique_ptr<std::ofstream> m_Stream; //!< Stream used for writing to files.
+		static constexpr size_t c_FlushThreshold = 64 * 1024; //!< Buffered bytes at which the buffer is written out to the stream.
+
+		std::unique_ptr<std::ofstream> m_Stream; //!< Stream used for writing to files. Unbuffered, everything goes through m_Buffer instead.
+		std::string m_Buffer; //!< Output waiting to be written to the stream in one go.
 		std::string m_FilePath; //!< Currently used stream's filepath.
 		std::string m_FolderPath; //!< Only the path to the folder that we are writing a file in, excluding the filename.
 		std::string m_FileName; //!< Only the name of the currently read file, excluding the path.
@@ -136,6 +145,22 @@ namespace RTE {
 		/// </summary>
 		void Clear();
 
+		/// <summary>
+		/// Writes the buffer out to the stream if it has grown past the flush threshold.
+		/// </summary>
+		void FlushIfFull() { if (m_Buffer.size() >= c_FlushThreshold) { FlushBuffer(); } }
+
+		/// <summary>
+		/// Writes everything in the buffer out to the stream and empties the buffer.
+		/// </summary>
+		void FlushBuffer();
+
+		/// <summary>
+		/// Appends an integer to the buffer without going through a stream or a temporary string.
+		/// </summary>
+		/// <param name="value">The integer to append.</param>
+		template <typename Type> void AppendInteger(Type value);
+
 		// Disallow the use of some implicit methods.
 		GUIWriter(const GUIWriter &reference) = delete;
 		GUIWriter & operator=(const GUIWriter &rhs) = delete;
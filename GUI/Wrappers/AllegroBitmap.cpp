@@ -1,7 +1,10 @@
 #include "GUI.h"
 #include "AllegroBitmap.h"
+#include "PixelSpans.h"
 #include "RTEError.h"
 
+#include <cstring>
+
 namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -9,6 +12,7 @@ namespace RTE {
 	void AllegroBitmap::Clear() {
 		m_Bitmap = nullptr;
 		m_BitmapFile.Reset();
+		m_BitmapHandle.reset();
 		m_SelfCreated = false;
 	}
 
@@ -16,7 +20,8 @@ namespace RTE {
 
 	void AllegroBitmap::Create(const std::string &fileName) {
 		m_BitmapFile.Create(fileName.c_str());
-		m_Bitmap = m_BitmapFile.GetAsBitmap();
+		m_BitmapHandle = m_BitmapFile.GetAsBitmap();
+		m_Bitmap = m_BitmapHandle.get();
 
 		RTEAssert(m_Bitmap, "Could not load bitmap from \"" + fileName + "\" into AllegroBitmap!");
 
@@ -27,6 +32,7 @@ namespace RTE {
 
 	void AllegroBitmap::Create(int width, int height, int colorDepth) {
 		m_BitmapFile.Reset();
+		m_BitmapHandle.reset();
 		m_Bitmap = create_bitmap_ex(colorDepth, width, height);
 
 		RTEAssert(m_Bitmap, "Could not create new bitmap in AllegroBitmap!");
@@ -35,6 +41,17 @@ namespace RTE {
 		m_SelfCreated = true;
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void AllegroBitmap::CreateView(BITMAP *parentBitmap) {
+		Destroy();
+		m_Bitmap = create_sub_bitmap(parentBitmap, 0, 0, parentBitmap->w, parentBitmap->h);
+
+		RTEAssert(m_Bitmap, "Could not create sub-bitmap in AllegroBitmap!");
+
+		m_SelfCreated = true;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void AllegroBitmap::Destroy() {
@@ -73,6 +90,12 @@ namespace RTE {
 		putpixel(m_Bitmap, posX, posY, pixelColor);
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	unsigned long AllegroBitmap::GetColorKey() const {
+		return m_Bitmap ? bitmap_mask_color(m_Bitmap) : 0;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void AllegroBitmap::GetClipRect(GUIRect *clippingRect) const {
@@ -140,13 +163,59 @@ namespace RTE {
 		if (!m_Bitmap) {
 			return;
 		}
-		RTEAssert(destBitmap && dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), "Null destination bitmap passed when trying to draw AllegroBitmap");
+		// Skin pieces are often only a few pixels, so two dynamic_casts here would cost more than copying them
+		BITMAP *destAllegroBitmap = destBitmap ? destBitmap->GetBitmap() : nullptr;
+		RTEAssert(destAllegroBitmap, "Null destination bitmap passed when trying to draw AllegroBitmap");
 
-		if (srcPosAndSizeRect) {
-			masked_blit(m_Bitmap, dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top);
-		} else {
-			masked_blit(m_Bitmap, dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), 0, 0, destX, destY, destBitmap->GetWidth(), destBitmap->GetHeight());
+		int srcX = srcPosAndSizeRect ? srcPosAndSizeRect->left : 0;
+		int srcY = srcPosAndSizeRect ? srcPosAndSizeRect->top : 0;
+		int width = srcPosAndSizeRect ? srcPosAndSizeRect->right - srcPosAndSizeRect->left : destBitmap->GetWidth();
+		int height = srcPosAndSizeRect ? srcPosAndSizeRect->bottom - srcPosAndSizeRect->top : destBitmap->GetHeight();
+
+		if (!MaskedBlit32(m_Bitmap, destAllegroBitmap, srcX, srcY, destX, destY, width, height)) { masked_blit(m_Bitmap, destAllegroBitmap, srcX, srcY, destX, destY, width, height); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool AllegroBitmap::MaskedBlit32(BITMAP *srcBitmap, BITMAP *destBitmap, int srcX, int srcY, int destX, int destY, int width, int height) {
+		// Video and system bitmaps need Allegro to get at their lines, and blits within one bitmap can overlap
+		if (srcBitmap == destBitmap || bitmap_color_depth(srcBitmap) != 32 || bitmap_color_depth(destBitmap) != 32 || !is_memory_bitmap(srcBitmap) || !is_memory_bitmap(destBitmap)) {
+			return false;
+		}
+
+		// Same clipping as masked_blit, first to the source bitmap then to the destination's clipping rectangle
+		if (srcX >= srcBitmap->w || srcY >= srcBitmap->h || destX >= destBitmap->cr || destY >= destBitmap->cb) {
+			return true;
+		}
+		if (srcX < 0) {
+			width += srcX;
+			destX -= srcX;
+			srcX = 0;
+		}
+		if (srcY < 0) {
+			height += srcY;
+			destY -= srcY;
+			srcY = 0;
 		}
+		width = std::min(width, srcBitmap->w - srcX);
+		height = std::min(height, srcBitmap->h - srcY);
+		if (destX < destBitmap->cl) {
+			width -= destBitmap->cl - destX;
+			srcX += destBitmap->cl - destX;
+			destX = destBitmap->cl;
+		}
+		if (destY < destBitmap->ct) {
+			height -= destBitmap->ct - destY;
+			srcY += destBitmap->ct - destY;
+			destY = destBitmap->ct;
+		}
+		width = std::min(width, destBitmap->cr - destX);
+		height = std::min(height, destBitmap->cb - destY);
+
+		for (int row = 0; row < height; ++row) {
+			PixelSpans::CopySpanMasked(reinterpret_cast<uint32_t *>(destBitmap->line[destY + row]) + destX, reinterpret_cast<const uint32_t *>(srcBitmap->line[srcY + row]) + srcX, width);
+		}
+		return true;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -160,6 +229,81 @@ namespace RTE {
 		stretch_sprite(dynamic_cast<AllegroBitmap *>(destBitmap)->GetBitmap(), m_Bitmap, destX, destY, width, height);
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool AllegroBitmap::DrawSpans(GUIBitmap *destBitmap, int destX, int destY, const GUIRect &srcPosAndSizeRect, const GUIPixelSpan *spans, int spanCount) {
+		BITMAP *destBmp = destBitmap ? destBitmap->GetBitmap() : nullptr;
+		if (!m_Bitmap || !destBmp || !is_memory_bitmap(m_Bitmap) || !is_memory_bitmap(destBmp) || bitmap_color_depth(m_Bitmap) != bitmap_color_depth(destBmp)) {
+			return false;
+		}
+		int clipLeft = destBmp->clip ? destBmp->cl : 0;
+		int clipTop = destBmp->clip ? destBmp->ct : 0;
+		int clipRight = destBmp->clip ? destBmp->cr : destBmp->w;
+		int clipBottom = destBmp->clip ? destBmp->cb : destBmp->h;
+
+		// Sections entirely outside the clipping rectangle are skipped, and only ones crossing its edges need their runs clipped
+		int right = destX + srcPosAndSizeRect.right - srcPosAndSizeRect.left;
+		int bottom = destY + srcPosAndSizeRect.bottom - srcPosAndSizeRect.top;
+		if (right <= clipLeft || destX >= clipRight || bottom <= clipTop || destY >= clipBottom) {
+			return true;
+		}
+		bool clipped = destX < clipLeft || destY < clipTop || right > clipRight || bottom > clipBottom;
+		int bytesPerPixel = (bitmap_color_depth(destBmp) + 7) / 8;
+
+		for (int i = 0; i < spanCount; ++i) {
+			int spanDestX = destX + spans[i].m_Start;
+			int spanDestY = destY + spans[i].m_Row;
+			int spanSrcX = srcPosAndSizeRect.left + spans[i].m_Start;
+			int length = spans[i].m_Length;
+
+			if (clipped) {
+				if (spanDestY < clipTop || spanDestY >= clipBottom) {
+					continue;
+				}
+				if (spanDestX < clipLeft) {
+					spanSrcX += clipLeft - spanDestX;
+					length -= clipLeft - spanDestX;
+					spanDestX = clipLeft;
+				}
+				length = std::min(length, clipRight - spanDestX);
+				if (length <= 0) {
+					continue;
+				}
+			}
+			std::memcpy(destBmp->line[spanDestY] + spanDestX * bytesPerPixel, m_Bitmap->line[srcPosAndSizeRect.top + spans[i].m_Row] + spanSrcX * bytesPerPixel, length * bytesPerPixel);
+		}
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void AllegroBitmap::ReplaceColor(unsigned long oldColor, unsigned long newColor) {
+		int depth = m_Bitmap ? bitmap_color_depth(m_Bitmap) : 0;
+		if (!m_Bitmap || !is_memory_bitmap(m_Bitmap) || (depth != 8 && depth != 15 && depth != 16 && depth != 32)) {
+			GUIBitmap::ReplaceColor(oldColor, newColor);
+			return;
+		}
+		// Simple compare and select loops over whole scanlines, which the compiler can vectorize
+		for (int y = 0; y < m_Bitmap->h; y++) {
+			if (depth == 8) {
+				uint8_t *row = m_Bitmap->line[y];
+				for (int x = 0; x < m_Bitmap->w; x++) {
+					row[x] = (row[x] == static_cast<uint8_t>(oldColor)) ? static_cast<uint8_t>(newColor) : row[x];
+				}
+			} else if (depth == 32) {
+				uint32_t *row = reinterpret_cast<uint32_t *>(m_Bitmap->line[y]);
+				for (int x = 0; x < m_Bitmap->w; x++) {
+					row[x] = (row[x] == static_cast<uint32_t>(oldColor)) ? static_cast<uint32_t>(newColor) : row[x];
+				}
+			} else {
+				uint16_t *row = reinterpret_cast<uint16_t *>(m_Bitmap->line[y]);
+				for (int x = 0; x < m_Bitmap->w; x++) {
+					row[x] = (row[x] == static_cast<uint16_t>(oldColor)) ? static_cast<uint16_t>(newColor) : row[x];
+				}
+			}
+		}
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void AllegroBitmap::DrawLine(int x1, int y1, int x2, int y2, unsigned long color) {
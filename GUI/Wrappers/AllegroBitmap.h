@@ -38,6 +38,12 @@ namespace RTE {
 		/// <param name="height">Bitmap height.</param>
 		/// <param name="colorDepth">Bitmap color depth (8 or 32).</param>
 		void Create(int width, int height, int colorDepth = 8);
+
+		/// <summary>
+		/// Creates a sub-bitmap covering all of another BITMAP that is owned by this AllegroBitmap. It draws onto the other BITMAP's pixels but has its own clipping rectangle.
+		/// </summary>
+		/// <param name="parentBitmap">The BITMAP to draw onto. Ownership is NOT transferred, and it has to outlive this AllegroBitmap!</param>
+		void CreateView(BITMAP *parentBitmap);
 #pragma endregion
 
 #pragma region Destruction
@@ -104,6 +110,12 @@ namespace RTE {
 		/// <param name="posY">Y position on bitmap.</param>
 		/// <param name="pixelColor">The color to set the pixel to.</param>
 		void SetPixel(int posX, int posY, unsigned long pixelColor) override;
+
+		/// <summary>
+		/// Gets the color key (mask color) of the bitmap, the color that DrawTrans skips.
+		/// </summary>
+		/// <returns>The mask color of the underlaying BITMAP's color depth.</returns>
+		unsigned long GetColorKey() const override;
 #pragma endregion
 
 #pragma region Clipping
@@ -154,9 +166,28 @@ namespace RTE {
 		/// <param name="width">Target width of the bitmap.</param>
 		/// <param name="height">Target height of the bitmap.</param>
 		void DrawTransScaled(GUIBitmap *destBitmap, int destX, int destY, int width, int height) override;
+
+		/// <summary>
+		/// Copies runs of pixels from a section of this bitmap onto another bitmap as they are, clipped to the destination's clipping rectangle.
+		/// </summary>
+		/// <param name="destBitmap">Bitmap to draw onto.</param>
+		/// <param name="destX">Destination X position.</param>
+		/// <param name="destY">Destination Y position.</param>
+		/// <param name="srcPosAndSizeRect">Source bitmap position and size rectangle. Has to be within the bitmap, and the runs within it.</param>
+		/// <param name="spans">The runs of pixels to copy, relative to the source rectangle's top-left corner.</param>
+		/// <param name="spanCount">Number of runs to copy.</param>
+		/// <returns>Whether the runs were copied. False unless both bitmaps are memory bitmaps of the same color depth.</returns>
+		bool DrawSpans(GUIBitmap *destBitmap, int destX, int destY, const GUIRect &srcPosAndSizeRect, const GUIPixelSpan *spans, int spanCount) override;
 #pragma endregion
 
 #pragma region Primitive Drawing
+		/// <summary>
+		/// Replaces every pixel of one color on this bitmap with another color. 8, 15, 16 and 32-bit memory bitmaps are done directly on their scanlines.
+		/// </summary>
+		/// <param name="oldColor">The color to replace.</param>
+		/// <param name="newColor">The color to replace it with.</param>
+		void ReplaceColor(unsigned long oldColor, unsigned long newColor) override;
+
 		/// <summary>
 		/// Draws a line on this bitmap.
 		/// </summary>
@@ -183,8 +214,23 @@ namespace RTE {
 
 		BITMAP *m_Bitmap; //!< The underlaying BITMAP.
 		ContentFile m_BitmapFile; //!< The ContentFile the underlaying BITMAP was created from, if created from a file.
+		std::shared_ptr<BITMAP> m_BitmapHandle; //!< Keeps the underlaying BITMAP loaded while this uses it, if created from a file.
 		bool m_SelfCreated; //!< Whether the underlaying BITMAP was created by this and is owned.
 
+		/// <summary>
+		/// Does a masked_blit between two 32-bit memory bitmaps with PixelSpans instead of Allegro's per-pixel loop. Clips the same way masked_blit does.
+		/// </summary>
+		/// <param name="srcBitmap">Bitmap to draw from.</param>
+		/// <param name="destBitmap">Bitmap to draw onto.</param>
+		/// <param name="srcX">Source X position.</param>
+		/// <param name="srcY">Source Y position.</param>
+		/// <param name="destX">Destination X position.</param>
+		/// <param name="destY">Destination Y position.</param>
+		/// <param name="width">Width of the area to draw.</param>
+		/// <param name="height">Height of the area to draw.</param>
+		/// <returns>Whether the blit was done. False if the bitmaps aren't both 32-bit memory bitmaps, in which case it has to go through masked_blit.</returns>
+		static bool MaskedBlit32(BITMAP *srcBitmap, BITMAP *destBitmap, int srcX, int srcY, int destX, int destY, int width, int height);
+
 		/// <summary>
 		/// Clears all the member variables of this AllegroBitmap, effectively resetting the members of this abstraction level only.
 		/// </summary>
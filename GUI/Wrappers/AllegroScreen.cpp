@@ -25,6 +25,24 @@ namespace RTE {
 		return newAllegroBitmap.release();
 	}
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GUIScreen * AllegroScreen::CreateOffscreen(int width, int height) {
+		return new AllegroScreen(width, height, bitmap_color_depth(m_BackBufferBitmap->GetBitmap()));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GUIScreen * AllegroScreen::CreateView() {
+		// Video and system bitmaps have to be locked to draw on, which several threads can't do at once
+		if (!m_BackBufferBitmap->GetBitmap() || !is_memory_bitmap(m_BackBufferBitmap->GetBitmap())) {
+			return nullptr;
+		}
+		AllegroScreen *view = new AllegroScreen(nullptr);
+		view->m_BackBufferBitmap->CreateView(m_BackBufferBitmap->GetBitmap());
+		return view;
+	}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void AllegroScreen::DrawBitmap(GUIBitmap *guiBitmap, int destX, int destY, GUIRect *srcPosAndSizeRect) {
@@ -19,6 +19,14 @@ namespace RTE {
 		/// <param name="backBuffer">A bitmap that represents the back buffer. Ownership is NOT transferred!</param>
 		explicit AllegroScreen(BITMAP *backBuffer) { m_BackBufferBitmap = std::make_unique<AllegroBitmap>(backBuffer); }
 
+		/// <summary>
+		/// Constructor method used to instantiate an AllegroScreen object with a back buffer of its own in system memory and make it ready for use.
+		/// </summary>
+		/// <param name="width">Width of the back buffer.</param>
+		/// <param name="height">Height of the back buffer.</param>
+		/// <param name="colorDepth">Color depth of the back buffer.</param>
+		AllegroScreen(int width, int height, int colorDepth) { m_BackBufferBitmap = std::make_unique<AllegroBitmap>(); m_BackBufferBitmap->Create(width, height, colorDepth); }
+
 		/// <summary>
 		/// Creates a bitmap from a file.
 		/// </summary>
@@ -33,6 +41,26 @@ namespace RTE {
 		/// <param name="height">Bitmap height.</param>
 		/// <returns>Pointer to the created bitmap. Ownership IS transferred!</returns>
 		GUIBitmap * CreateBitmap(int width, int height) override;
+
+		/// <summary>
+		/// Starts decoding a set of image files on worker threads, ahead of the CreateBitmap calls for them.
+		/// </summary>
+		/// <param name="fileNames">File names of the images that are about to be created.</param>
+		void PreloadBitmaps(const std::vector<std::string> &fileNames) override { ContentFile::PreloadBitmaps(fileNames); }
+
+		/// <summary>
+		/// Creates an AllegroScreen that draws onto a new memory bitmap of its own, with the same color depth as this one's back buffer.
+		/// </summary>
+		/// <param name="width">Width of the offscreen bitmap.</param>
+		/// <param name="height">Height of the offscreen bitmap.</param>
+		/// <returns>Pointer to the created screen. Ownership IS transferred!</returns>
+		GUIScreen * CreateOffscreen(int width, int height) override;
+
+		/// <summary>
+		/// Creates an AllegroScreen that draws onto a sub-bitmap covering all of this one's back buffer. This AllegroScreen has to outlive it.
+		/// </summary>
+		/// <returns>Pointer to the created screen, or nullptr if this AllegroScreen has no back buffer or it isn't a memory bitmap. Ownership IS transferred!</returns>
+		GUIScreen * CreateView() override;
 #pragma endregion
 
 #pragma region Destruction
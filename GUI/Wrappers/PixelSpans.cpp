@@ -0,0 +1,111 @@
+#include "GUI.h"
+#include "PixelSpans.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIXELSPANS_SSE2
+#include <emmintrin.h>
+#endif
+// The project is built for SSE2, so the AVX2 versions live in PixelSpansAVX2.cpp, the only file built with AVX2 enabled, and are picked at runtime
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define PIXELSPANS_AVX2
+#include <intrin.h>
+#endif
+
+namespace RTE {
+
+#ifdef PIXELSPANS_AVX2
+	namespace {
+		/// <summary>
+		/// Checks whether the CPU supports AVX2 and the OS saves the 256-bit registers it uses.
+		/// </summary>
+		/// <returns>Whether the AVX2 span functions can be used.</returns>
+		bool CPUSupportsAVX2() {
+			int cpuInfo[4];
+			__cpuid(cpuInfo, 0);
+			if (cpuInfo[0] < 7) {
+				return false;
+			}
+			// OSXSAVE and AVX, then whether the OS has enabled the SSE and AVX register state
+			__cpuid(cpuInfo, 1);
+			if ((cpuInfo[2] & (1 << 27)) == 0 || (cpuInfo[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6) {
+				return false;
+			}
+			__cpuidex(cpuInfo, 7, 0);
+			return (cpuInfo[1] & (1 << 5)) != 0;
+		}
+
+		// Zero until it's initialized, so anything drawn during static initialization of other files just takes the SSE2 path
+		const bool c_UseAVX2 = CPUSupportsAVX2();
+	}
+#endif
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelSpans::FillSpan(uint32_t *dest, int count, uint32_t color) {
+#ifdef PIXELSPANS_AVX2
+		if (c_UseAVX2) {
+			FillSpanAVX2(dest, count, color);
+			return;
+		}
+#endif
+		int x = 0;
+#ifdef PIXELSPANS_SSE2
+		const __m128i color4 = _mm_set1_epi32(static_cast<int>(color));
+		for (; x + 4 <= count; x += 4) {
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), color4);
+		}
+#endif
+		for (; x < count; ++x) {
+			dest[x] = color;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelSpans::CopySpanMasked(uint32_t *dest, const uint32_t *src, int count) {
+#ifdef PIXELSPANS_AVX2
+		if (c_UseAVX2) {
+			CopySpanMaskedAVX2(dest, src, count);
+			return;
+		}
+#endif
+		int x = 0;
+#ifdef PIXELSPANS_SSE2
+		const __m128i mask4 = _mm_set1_epi32(static_cast<int>(c_MaskColor));
+		for (; x + 4 <= count; x += 4) {
+			__m128i srcPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+			__m128i destPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + x));
+			__m128i isMasked = _mm_cmpeq_epi32(srcPixels, mask4);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), _mm_or_si128(_mm_and_si128(isMasked, destPixels), _mm_andnot_si128(isMasked, srcPixels)));
+		}
+#endif
+		for (; x < count; ++x) {
+			if (src[x] != c_MaskColor) { dest[x] = src[x]; }
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelSpans::StretchSpanMasked(uint32_t *dest, const uint32_t *srcRow, const int *srcColumns, int count) {
+#ifdef PIXELSPANS_AVX2
+		if (c_UseAVX2) {
+			StretchSpanMaskedAVX2(dest, srcRow, srcColumns, count);
+			return;
+		}
+#endif
+		int x = 0;
+#ifdef PIXELSPANS_SSE2
+		const __m128i mask4 = _mm_set1_epi32(static_cast<int>(c_MaskColor));
+		for (; x + 4 <= count; x += 4) {
+			__m128i srcPixels = _mm_setr_epi32(static_cast<int>(srcRow[srcColumns[x]]), static_cast<int>(srcRow[srcColumns[x + 1]]), static_cast<int>(srcRow[srcColumns[x + 2]]), static_cast<int>(srcRow[srcColumns[x + 3]]));
+			__m128i destPixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dest + x));
+			__m128i isMasked = _mm_cmpeq_epi32(srcPixels, mask4);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), _mm_or_si128(_mm_and_si128(isMasked, destPixels), _mm_andnot_si128(isMasked, srcPixels)));
+		}
+#endif
+		for (; x < count; ++x) {
+			uint32_t srcPixel = srcRow[srcColumns[x]];
+			if (srcPixel != c_MaskColor) { dest[x] = srcPixel; }
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#ifndef _PIXELSPANS_
+#define _PIXELSPANS_
+
+namespace RTE {
+
+	/// <summary>
+	/// Static functions that fill and copy rows of 32-bit pixels, vectorized with SSE2, or AVX2 when the CPU supports it.
+	/// Shared by the bitmap wrappers so their inner loops don't go through Allegro's per-pixel ones.
+	/// </summary>
+	class PixelSpans {
+
+	public:
+
+		static constexpr uint32_t c_MaskColor = 0xFF00FF; //!< Pixels of this color are skipped by the masked copies, same as Allegro's 32-bit mask color.
+
+		/// <summary>
+		/// Fills a row of pixels with a color.
+		/// </summary>
+		/// <param name="dest">First pixel to fill.</param>
+		/// <param name="count">Number of pixels to fill.</param>
+		/// <param name="color">The color to fill with.</param>
+		static void FillSpan(uint32_t *dest, int count, uint32_t color);
+
+		/// <summary>
+		/// Copies a row of pixels, skipping the ones of the mask color. The rows must not overlap.
+		/// </summary>
+		/// <param name="dest">First pixel to copy to.</param>
+		/// <param name="src">First pixel to copy from.</param>
+		/// <param name="count">Number of pixels to copy.</param>
+		static void CopySpanMasked(uint32_t *dest, const uint32_t *src, int count);
+
+		/// <summary>
+		/// Copies pixels picked from a source row by a column table, skipping the ones of the mask color.
+		/// </summary>
+		/// <param name="dest">First pixel to copy to.</param>
+		/// <param name="srcRow">The source row to pick pixels from.</param>
+		/// <param name="srcColumns">For each destination pixel, the column of the source row to copy.</param>
+		/// <param name="count">Number of pixels to copy.</param>
+		static void StretchSpanMasked(uint32_t *dest, const uint32_t *srcRow, const int *srcColumns, int count);
+
+	private:
+
+		/// <summary>
+		/// AVX2 versions of the functions above, in PixelSpansAVX2.cpp. Only called once the CPU is known to support AVX2.
+		/// </summary>
+		static void FillSpanAVX2(uint32_t *dest, int count, uint32_t color);
+		static void CopySpanMaskedAVX2(uint32_t *dest, const uint32_t *src, int count);
+		static void StretchSpanMaskedAVX2(uint32_t *dest, const uint32_t *srcRow, const int *srcColumns, int count);
+	};
+}
+#endif
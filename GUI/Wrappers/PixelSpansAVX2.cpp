@@ -0,0 +1,63 @@
+// The project builds only this file with AVX2 enabled, and without the precompiled standard headers. Any inline function or static initializer from those
+// would be compiled for AVX2 too and could run on CPUs without it, so this file holds nothing but the functions PixelSpans calls once it has checked the CPU.
+#include <cstdint>
+#include "PixelSpans.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelSpans::FillSpanAVX2(uint32_t *dest, int count, uint32_t color) {
+		int x = 0;
+		const __m256i color8 = _mm256_set1_epi32(static_cast<int>(color));
+		for (; x + 8 <= count; x += 8) {
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + x), color8);
+		}
+		for (; x < count; ++x) {
+			dest[x] = color;
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelSpans::CopySpanMaskedAVX2(uint32_t *dest, const uint32_t *src, int count) {
+		int x = 0;
+		// Compare 8 pixels against the mask color at once and only store the ones that aren't it, so the destination is never read
+		const __m256i mask8 = _mm256_set1_epi32(static_cast<int>(c_MaskColor));
+		const __m256i allSet = _mm256_set1_epi32(-1);
+		for (; x + 8 <= count; x += 8) {
+			__m256i srcPixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + x));
+			__m256i isOpaque = _mm256_xor_si256(_mm256_cmpeq_epi32(srcPixels, mask8), allSet);
+			_mm256_maskstore_epi32(reinterpret_cast<int *>(dest + x), isOpaque, srcPixels);
+		}
+		// The last few pixels the same way, with the ones past the end masked off too, because tiles are often narrower than 8 pixels and a branch per pixel mispredicts on every edge of a see-through area
+		if (x < count) {
+			const __m256i inSpan = _mm256_cmpgt_epi32(_mm256_set1_epi32(count - x), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+			__m256i srcPixels = _mm256_maskload_epi32(reinterpret_cast<const int *>(src + x), inSpan);
+			__m256i isOpaque = _mm256_andnot_si256(_mm256_cmpeq_epi32(srcPixels, mask8), inSpan);
+			_mm256_maskstore_epi32(reinterpret_cast<int *>(dest + x), isOpaque, srcPixels);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void PixelSpans::StretchSpanMaskedAVX2(uint32_t *dest, const uint32_t *srcRow, const int *srcColumns, int count) {
+		int x = 0;
+		const __m256i mask8 = _mm256_set1_epi32(static_cast<int>(c_MaskColor));
+		for (; x + 8 <= count; x += 8) {
+			__m256i columns = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(srcColumns + x));
+			__m256i srcPixels = _mm256_i32gather_epi32(reinterpret_cast<const int *>(srcRow), columns, 4);
+			__m256i destPixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dest + x));
+			__m256i isMasked = _mm256_cmpeq_epi32(srcPixels, mask8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + x), _mm256_blendv_epi8(srcPixels, destPixels, isMasked));
+		}
+		for (; x < count; ++x) {
+			uint32_t srcPixel = srcRow[srcColumns[x]];
+			if (srcPixel != c_MaskColor) { dest[x] = srcPixel; }
+		}
+	}
+}
+#endif
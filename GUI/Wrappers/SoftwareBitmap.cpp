@@ -0,0 +1,457 @@
+#include "GUI.h"
+#include "SoftwareBitmap.h"
+
+#include "PixelSpans.h"
+#include "png.h"
+
+#include <cstring>
+
+namespace RTE {
+
+	namespace {
+
+		const double c_PngScreenGamma = 2.2; //!< The screen gamma loadpng assumes when SCREEN_GAMMA isn't set.
+
+		/// <summary>
+		/// Expands a 6-bit palette component to 8 bits, same as Allegro's _rgb_scale_6 table.
+		/// </summary>
+		/// <param name="component">The component, 0 to 63.</param>
+		/// <returns>The component scaled to 0 to 255, rounded to nearest.</returns>
+		inline uint32_t Scale6To8(uint32_t component) { return (component * 510 + 63) / 126; }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::Clear() {
+		m_PixelBuffer.reset();
+		m_Pixels = nullptr;
+		m_Width = 0;
+		m_Height = 0;
+		m_DataPath.clear();
+		m_ClipLeft = 0;
+		m_ClipTop = 0;
+		m_ClipRight = 0;
+		m_ClipBottom = 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SoftwareBitmap::Create(const std::string &fileName) {
+		Clear();
+
+		std::unique_ptr<std::FILE, decltype(&std::fclose)> pngFile(std::fopen(fileName.c_str(), "rb"), &std::fclose);
+		if (!pngFile) {
+			return false;
+		}
+		png_structp pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		png_infop infoPtr = pngPtr ? png_create_info_struct(pngPtr) : nullptr;
+		if (!infoPtr) {
+			png_destroy_read_struct(&pngPtr, nullptr, nullptr);
+			return false;
+		}
+		// libpng reports errors by jumping back here, so nothing that needs destructing may be created past this point. The row buffer is only sized once the header is read
+		std::vector<png_byte> rows;
+		if (setjmp(png_jmpbuf(pngPtr))) {
+			png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
+			Clear();
+			return false;
+		}
+		png_init_io(pngPtr, pngFile.get());
+		png_read_info(pngPtr, infoPtr);
+
+		png_uint_32 width;
+		png_uint_32 height;
+		int bitDepth;
+		int colorType;
+		png_get_IHDR(pngPtr, infoPtr, &width, &height, &bitDepth, &colorType, nullptr, nullptr, nullptr);
+
+		// Same transformations as loadpng, in the same order
+		png_set_packing(pngPtr);
+		if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8) { png_set_expand(pngPtr); }
+		if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS) && !(colorType & PNG_COLOR_MASK_PALETTE)) { png_set_tRNS_to_alpha(pngPtr); }
+		if (bitDepth == 16) { png_set_strip_16(pngPtr); }
+		if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA) { png_set_gray_to_rgb(pngPtr); }
+		int renderingIntent;
+		double imageGamma;
+		if (!png_get_sRGB(pngPtr, infoPtr, &renderingIntent) && png_get_gAMA(pngPtr, infoPtr, &imageGamma)) {
+			png_set_gamma(pngPtr, c_PngScreenGamma, imageGamma);
+		} else {
+			png_set_gamma(pngPtr, c_PngScreenGamma, 0.45455);
+		}
+		int passCount = png_set_interlace_handling(pngPtr);
+		png_read_update_info(pngPtr, infoPtr);
+
+		// Paletted images go through Allegro's 6-bit palette on their way to 32-bit, so they lose the same precision here
+		std::array<uint32_t, 256> palette = {};
+		png_colorp pngPalette;
+		int pngPaletteSize;
+		if ((colorType & PNG_COLOR_MASK_PALETTE) && png_get_PLTE(pngPtr, infoPtr, &pngPalette, &pngPaletteSize)) {
+			for (int colorIndex = 0; colorIndex < std::min(pngPaletteSize, 256); ++colorIndex) {
+				palette[colorIndex] = (Scale6To8(pngPalette[colorIndex].red >> 2) << 16) | (Scale6To8(pngPalette[colorIndex].green >> 2) << 8) | Scale6To8(pngPalette[colorIndex].blue >> 2);
+			}
+		}
+
+		int channels = png_get_channels(pngPtr, infoPtr);
+		png_size_t rowBytes = png_get_rowbytes(pngPtr, infoPtr);
+		rows.resize(rowBytes * height);
+		for (int pass = 0; pass < passCount; ++pass) {
+			for (png_uint_32 row = 0; row < height; ++row) {
+				png_read_row(pngPtr, rows.data() + row * rowBytes, nullptr);
+			}
+		}
+		png_read_end(pngPtr, infoPtr);
+		png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
+
+		Create(static_cast<int>(width), static_cast<int>(height));
+		for (int y = 0; y < m_Height; ++y) {
+			const png_byte *srcRow = rows.data() + y * rowBytes;
+			uint32_t *destRow = m_Pixels + y * m_Width;
+			for (int x = 0; x < m_Width; ++x) {
+				const png_byte *srcPixel = srcRow + x * channels;
+				if (channels == 1) {
+					destRow[x] = palette[srcPixel[0]];
+				} else {
+					destRow[x] = (static_cast<uint32_t>(srcPixel[0]) << 16) | (static_cast<uint32_t>(srcPixel[1]) << 8) | srcPixel[2];
+					if (channels == 4) { destRow[x] |= static_cast<uint32_t>(srcPixel[3]) << 24; }
+				}
+			}
+		}
+		m_DataPath = fileName;
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::Create(int width, int height) {
+		Clear();
+		m_Width = std::max(width, 0);
+		m_Height = std::max(height, 0);
+		m_PixelBuffer = std::make_shared<std::vector<uint32_t>>(static_cast<size_t>(m_Width) * static_cast<size_t>(m_Height), 0);
+		m_Pixels = m_PixelBuffer->empty() ? nullptr : m_PixelBuffer->data();
+		SetClipRect(nullptr);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::CreateView(const SoftwareBitmap &sourceBitmap) {
+		Clear();
+		m_PixelBuffer = sourceBitmap.m_PixelBuffer;
+		m_Pixels = sourceBitmap.m_Pixels;
+		m_Width = sourceBitmap.m_Width;
+		m_Height = sourceBitmap.m_Height;
+		SetClipRect(nullptr);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	unsigned long SoftwareBitmap::GetPixel(int posX, int posY) const {
+		if (posX < 0 || posX >= m_Width || posY < 0 || posY >= m_Height) {
+			return static_cast<unsigned long>(-1);
+		}
+		return m_Pixels[posY * m_Width + posX];
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::SetPixel(int posX, int posY, unsigned long pixelColor) {
+		if (posX >= m_ClipLeft && posX < m_ClipRight && posY >= m_ClipTop && posY < m_ClipBottom) { m_Pixels[posY * m_Width + posX] = static_cast<uint32_t>(pixelColor); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::GetClipRect(GUIRect *clippingRect) const {
+		if (clippingRect) { SetRect(clippingRect, m_ClipLeft, m_ClipTop, m_ClipRight - 1, m_ClipBottom - 1); }
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::SetClipRect(GUIRect *clippingRect) {
+		int left = clippingRect ? static_cast<int>(clippingRect->left) : 0;
+		int top = clippingRect ? static_cast<int>(clippingRect->top) : 0;
+		int right = clippingRect ? static_cast<int>(clippingRect->right) : m_Width - 1;
+		int bottom = clippingRect ? static_cast<int>(clippingRect->bottom) : m_Height - 1;
+
+		// Same clamping as set_clip_rect, the far edges become exclusive
+		m_ClipLeft = std::max(0, std::min(left, m_Width - 1));
+		m_ClipTop = std::max(0, std::min(top, m_Height - 1));
+		m_ClipRight = std::max(0, std::min(right + 1, m_Width));
+		m_ClipBottom = std::max(0, std::min(bottom + 1, m_Height));
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::AddClipRect(GUIRect *clippingRect) {
+		if (!clippingRect) {
+			SetClipRect(nullptr);
+			return;
+		}
+		GUIRect newClippingRect;
+		SetRect(&newClippingRect, std::max(static_cast<int>(clippingRect->left), m_ClipLeft), std::max(static_cast<int>(clippingRect->top), m_ClipTop), std::min(static_cast<int>(clippingRect->right), m_ClipRight - 1), std::min(static_cast<int>(clippingRect->bottom), m_ClipBottom - 1));
+		SetClipRect(&newClippingRect);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::Draw(GUIBitmap *destBitmap, int destX, int destY, GUIRect *srcPosAndSizeRect) {
+		if (!m_Pixels || !destBitmap) {
+			return;
+		}
+		// Same sizes as AllegroBitmap uses, including the destination's size when there's no source rectangle
+		if (srcPosAndSizeRect) {
+			Blit(static_cast<SoftwareBitmap *>(destBitmap), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top, false);
+		} else {
+			Blit(static_cast<SoftwareBitmap *>(destBitmap), 0, 0, destX, destY, destBitmap->GetWidth(), destBitmap->GetHeight(), false);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::DrawTrans(GUIBitmap *destBitmap, int destX, int destY, GUIRect *srcPosAndSizeRect) {
+		if (!m_Pixels || !destBitmap) {
+			return;
+		}
+		if (srcPosAndSizeRect) {
+			Blit(static_cast<SoftwareBitmap *>(destBitmap), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top, true);
+		} else {
+			Blit(static_cast<SoftwareBitmap *>(destBitmap), 0, 0, destX, destY, destBitmap->GetWidth(), destBitmap->GetHeight(), true);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::DrawTransScaled(GUIBitmap *destBitmap, int destX, int destY, int width, int height) {
+		if (!m_Pixels || !destBitmap || width <= 0 || height <= 0) {
+			return;
+		}
+		SoftwareBitmap *dest = static_cast<SoftwareBitmap *>(destBitmap);
+
+		int destLeft = std::max(destX, dest->m_ClipLeft);
+		int destRight = std::min(destX + width, dest->m_ClipRight);
+		int destTop = std::max(destY, dest->m_ClipTop);
+		int destBottom = std::min(destY + height, dest->m_ClipBottom);
+		if (destLeft >= destRight || destTop >= destBottom) {
+			return;
+		}
+
+		// Step through the source like stretch_sprite does, with an error counter per axis, so the same source pixels get picked.
+		// The columns are the same for every row, so they're worked out once.
+		int srcStepX = m_Width / width;
+		int errorDecX = m_Width - srcStepX * width;
+		int errorIncX = width - errorDecX;
+		int errorX = errorIncX;
+		int srcX = 0;
+		std::vector<int> srcColumns(destRight - destLeft);
+		for (int x = destX; x < destRight; ++x) {
+			if (x >= destLeft) { srcColumns[x - destLeft] = srcX; }
+			srcX += srcStepX;
+			if (errorX <= 0) {
+				srcX++;
+				errorX += errorIncX;
+			} else {
+				errorX -= errorDecX;
+			}
+		}
+
+		int srcStepY = m_Height / height;
+		int errorDecY = m_Height - srcStepY * height;
+		int errorIncY = height - errorDecY;
+		int errorY = errorIncY;
+		int srcY = 0;
+		for (int y = destY; y < destBottom; ++y) {
+			if (y >= destTop) { PixelSpans::StretchSpanMasked(dest->m_Pixels + y * dest->m_Width + destLeft, m_Pixels + srcY * m_Width, srcColumns.data(), destRight - destLeft); }
+			srcY += srcStepY;
+			if (errorY <= 0) {
+				srcY++;
+				errorY += errorIncY;
+			} else {
+				errorY -= errorDecY;
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::Blit(SoftwareBitmap *destBitmap, int srcX, int srcY, int destX, int destY, int width, int height, bool masked) const {
+		if (!destBitmap || !m_Pixels || !destBitmap->m_Pixels) {
+			return;
+		}
+		// Clipped in the same order as Allegro's blit, first to the source bitmap then to the destination's clipping rectangle
+		if (srcX >= m_Width || srcY >= m_Height || destX >= destBitmap->m_ClipRight || destY >= destBitmap->m_ClipBottom) {
+			return;
+		}
+		if (srcX < 0) {
+			width += srcX;
+			destX -= srcX;
+			srcX = 0;
+		}
+		if (srcY < 0) {
+			height += srcY;
+			destY -= srcY;
+			srcY = 0;
+		}
+		width = std::min(width, m_Width - srcX);
+		height = std::min(height, m_Height - srcY);
+		if (destX < destBitmap->m_ClipLeft) {
+			width -= destBitmap->m_ClipLeft - destX;
+			srcX += destBitmap->m_ClipLeft - destX;
+			destX = destBitmap->m_ClipLeft;
+		}
+		if (destY < destBitmap->m_ClipTop) {
+			height -= destBitmap->m_ClipTop - destY;
+			srcY += destBitmap->m_ClipTop - destY;
+			destY = destBitmap->m_ClipTop;
+		}
+		width = std::min(width, destBitmap->m_ClipRight - destX);
+		height = std::min(height, destBitmap->m_ClipBottom - destY);
+		if (width <= 0 || height <= 0) {
+			return;
+		}
+
+		// Copying down within the same pixels has to go bottom up so rows aren't overwritten before they're read
+		bool bottomUp = destBitmap->m_Pixels == m_Pixels && destY > srcY;
+		for (int row = 0; row < height; ++row) {
+			int rowOffset = bottomUp ? height - 1 - row : row;
+			const uint32_t *srcRow = m_Pixels + (srcY + rowOffset) * m_Width + srcX;
+			uint32_t *destRow = destBitmap->m_Pixels + (destY + rowOffset) * destBitmap->m_Width + destX;
+			if (masked) {
+				PixelSpans::CopySpanMasked(destRow, srcRow, width);
+			} else {
+				std::memmove(destRow, srcRow, width * sizeof(uint32_t));
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool SoftwareBitmap::DrawSpans(GUIBitmap *destBitmap, int destX, int destY, const GUIRect &srcPosAndSizeRect, const GUIPixelSpan *spans, int spanCount) {
+		SoftwareBitmap *dest = static_cast<SoftwareBitmap *>(destBitmap);
+		if (!m_Pixels || !dest || !dest->m_Pixels) {
+			return false;
+		}
+		// Sections entirely outside the clipping rectangle are skipped, and only ones crossing its edges need their runs clipped
+		int right = destX + srcPosAndSizeRect.right - srcPosAndSizeRect.left;
+		int bottom = destY + srcPosAndSizeRect.bottom - srcPosAndSizeRect.top;
+		if (right <= dest->m_ClipLeft || destX >= dest->m_ClipRight || bottom <= dest->m_ClipTop || destY >= dest->m_ClipBottom) {
+			return true;
+		}
+		bool clipped = destX < dest->m_ClipLeft || destY < dest->m_ClipTop || right > dest->m_ClipRight || bottom > dest->m_ClipBottom;
+
+		for (int i = 0; i < spanCount; ++i) {
+			int spanDestX = destX + spans[i].m_Start;
+			int spanDestY = destY + spans[i].m_Row;
+			int spanSrcX = srcPosAndSizeRect.left + spans[i].m_Start;
+			int length = spans[i].m_Length;
+
+			if (clipped) {
+				if (spanDestY < dest->m_ClipTop || spanDestY >= dest->m_ClipBottom) {
+					continue;
+				}
+				if (spanDestX < dest->m_ClipLeft) {
+					spanSrcX += dest->m_ClipLeft - spanDestX;
+					length -= dest->m_ClipLeft - spanDestX;
+					spanDestX = dest->m_ClipLeft;
+				}
+				length = std::min(length, dest->m_ClipRight - spanDestX);
+				if (length <= 0) {
+					continue;
+				}
+			}
+			std::memcpy(dest->m_Pixels + spanDestY * dest->m_Width + spanDestX, m_Pixels + (srcPosAndSizeRect.top + spans[i].m_Row) * m_Width + spanSrcX, length * sizeof(uint32_t));
+		}
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::FillRect(int x1, int y1, int x2, int y2, uint32_t color) {
+		if (x2 < x1) { std::swap(x1, x2); }
+		if (y2 < y1) { std::swap(y1, y2); }
+		x1 = std::max(x1, m_ClipLeft);
+		y1 = std::max(y1, m_ClipTop);
+		x2 = std::min(x2, m_ClipRight - 1);
+		y2 = std::min(y2, m_ClipBottom - 1);
+		if (x2 < x1 || y2 < y1) {
+			return;
+		}
+		for (int y = y1; y <= y2; ++y) {
+			PixelSpans::FillSpan(m_Pixels + y * m_Width + x1, x2 - x1 + 1, color);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::ReplaceColor(unsigned long oldColor, unsigned long newColor) {
+		// A simple compare and select loop over all the pixels, which the compiler can vectorize
+		uint32_t oldPixel = static_cast<uint32_t>(oldColor);
+		uint32_t newPixel = static_cast<uint32_t>(newColor);
+		for (int i = 0; i < m_Width * m_Height; ++i) {
+			m_Pixels[i] = (m_Pixels[i] == oldPixel) ? newPixel : m_Pixels[i];
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::DrawLine(int x1, int y1, int x2, int y2, unsigned long color) {
+		if (!m_Pixels) {
+			return;
+		}
+		if (x1 == x2 || y1 == y2) {
+			FillRect(x1, y1, x2, y2, static_cast<uint32_t>(color));
+			return;
+		}
+		// Same Bresenham stepping as Allegro's do_line, including which axis it steps along when both are the same length
+		int deltaX = x2 - x1;
+		int deltaY = y2 - y1;
+		bool stepAlongX = (deltaX < 0 && deltaY < 0) ? deltaX < deltaY : std::abs(deltaX) >= std::abs(deltaY);
+
+		int primaryPos = stepAlongX ? x1 : y1;
+		int primaryEnd = stepAlongX ? x2 : y2;
+		int primaryStep = (stepAlongX ? deltaX : deltaY) < 0 ? -1 : 1;
+		int primaryLength = std::abs(stepAlongX ? deltaX : deltaY);
+		int secondaryPos = stepAlongX ? y1 : x1;
+		int secondaryDelta = stepAlongX ? deltaY : deltaX;
+		int secondaryStep = secondaryDelta < 0 ? -1 : 1;
+
+		int straightIncrement = 2 * secondaryDelta;
+		int error = straightIncrement - secondaryStep * primaryLength;
+		int diagonalIncrement = error - secondaryStep * primaryLength;
+		for (; primaryStep > 0 ? primaryPos <= primaryEnd : primaryPos >= primaryEnd; primaryPos += primaryStep) {
+			if (stepAlongX) {
+				SetPixel(primaryPos, secondaryPos, color);
+			} else {
+				SetPixel(secondaryPos, primaryPos, color);
+			}
+			if (secondaryStep > 0 ? error >= 0 : error <= 0) {
+				secondaryPos += secondaryStep;
+				error += diagonalIncrement;
+			} else {
+				error += straightIncrement;
+			}
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareBitmap::DrawRectangle(int posX, int posY, int width, int height, unsigned long color, bool filled) {
+		if (!m_Pixels) {
+			return;
+		}
+		int x1 = posX;
+		int y1 = posY;
+		int x2 = posX + width - 1;
+		int y2 = posY + height - 1;
+		if (filled) {
+			FillRect(x1, y1, x2, y2, static_cast<uint32_t>(color));
+			return;
+		}
+		// Outline drawn from the same lines Allegro's rect uses
+		if (x2 < x1) { std::swap(x1, x2); }
+		if (y2 < y1) { std::swap(y1, y2); }
+		FillRect(x1, y1, x2, y1, static_cast<uint32_t>(color));
+		if (y2 > y1) { FillRect(x1, y2, x2, y2, static_cast<uint32_t>(color)); }
+		if (y2 - 1 >= y1 + 1) {
+			FillRect(x1, y1 + 1, x1, y2 - 1, static_cast<uint32_t>(color));
+			if (x2 > x1) { FillRect(x2, y1 + 1, x2, y2 - 1, static_cast<uint32_t>(color)); }
+		}
+	}
+}
@@ -0,0 +1,268 @@
+#ifndef _SOFTWAREBITMAP_
+#define _SOFTWAREBITMAP_
+
+#include "GUIInterface.h"
+#include "PixelSpans.h"
+
+namespace RTE {
+
+	/// <summary>
+	/// GUI library bitmap backed by a plain buffer of 32-bit pixels, for drawing without Allegro, e.g. headless or offscreen.
+	/// Drawing follows Allegro's memory bitmap rules for clipping, masking and stretching, so the output matches AllegroBitmap's pixel for pixel.
+	/// </summary>
+	class SoftwareBitmap : public GUIBitmap {
+
+	public:
+
+		static constexpr uint32_t c_MaskColor = PixelSpans::c_MaskColor; //!< Pixels of this color are skipped by masked drawing, same as Allegro's 32-bit mask color.
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a SoftwareBitmap object in system memory.
+		/// </summary>
+		SoftwareBitmap() { Clear(); }
+
+		/// <summary>
+		/// Creates a SoftwareBitmap from a PNG file. The image is converted to 32-bit the same way loadpng and Allegro's color conversion would.
+		/// </summary>
+		/// <param name="fileName">File name of the PNG to load.</param>
+		/// <returns>Whether the file was loaded. The bitmap is left empty if it wasn't.</returns>
+		bool Create(const std::string &fileName);
+
+		/// <summary>
+		/// Creates an empty SoftwareBitmap, cleared to 0.
+		/// </summary>
+		/// <param name="width">Bitmap width.</param>
+		/// <param name="height">Bitmap height.</param>
+		void Create(int width, int height);
+
+		/// <summary>
+		/// Makes this SoftwareBitmap draw onto the same pixels as another one, with a clipping rectangle of its own, so different threads can draw onto different areas of the pixels at once.
+		/// The pixels stay around for as long as either bitmap uses them.
+		/// </summary>
+		/// <param name="sourceBitmap">The SoftwareBitmap to share the pixels of.</param>
+		void CreateView(const SoftwareBitmap &sourceBitmap);
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a SoftwareBitmap object before deletion from system memory.
+		/// </summary>
+		~SoftwareBitmap() override { Destroy(); }
+
+		/// <summary>
+		/// Destroys and resets (through Clear()) the SoftwareBitmap object.
+		/// </summary>
+		void Destroy() override { Clear(); }
+#pragma endregion
+
+#pragma region Getters and Setters
+		/// <summary>
+		/// Gets the path to the data file this SoftwareBitmap was loaded from.
+		/// </summary>
+		/// <returns>Path to the data file this SoftwareBitmap was loaded from, or an empty string if it wasn't.</returns>
+		std::string GetDataPath() const override { return m_DataPath; }
+
+		/// <summary>
+		/// Software bitmaps have no underlying BITMAP.
+		/// </summary>
+		/// <returns>Always nullptr.</returns>
+		BITMAP * GetBitmap() const override { return nullptr; }
+
+		/// <summary>
+		/// Software bitmaps can't take over a BITMAP, so this only destroys the SoftwareBitmap.
+		/// </summary>
+		/// <param name="newBitmap">Ignored.</param>
+		void SetBitmap(BITMAP * /*newBitmap*/) override { Destroy(); }
+
+		/// <summary>
+		/// Gets the width of the bitmap.
+		/// </summary>
+		/// <returns>The width of the bitmap.</returns>
+		int GetWidth() const override { return m_Width; }
+
+		/// <summary>
+		/// Gets the height of the bitmap.
+		/// </summary>
+		/// <returns>The height of the bitmap.</returns>
+		int GetHeight() const override { return m_Height; }
+
+		/// <summary>
+		/// Gets the number of bits per pixel color depth of the bitmap.
+		/// </summary>
+		/// <returns>Always 32.</returns>
+		int GetColorDepth() const override { return 32; }
+
+		/// <summary>
+		/// Gets the color of a pixel at a specific point on the bitmap.
+		/// </summary>
+		/// <param name="posX">X position on bitmap.</param>
+		/// <param name="posY">Y position on bitmap.</param>
+		/// <returns>The color of the pixel at the specified point, or -1 if it's outside the bitmap.</returns>
+		unsigned long GetPixel(int posX, int posY) const override;
+
+		/// <summary>
+		/// Sets the color of a pixel at a specific point on the bitmap. Pixels outside the clipping rectangle are left alone.
+		/// </summary>
+		/// <param name="posX">X position on bitmap.</param>
+		/// <param name="posY">Y position on bitmap.</param>
+		/// <param name="pixelColor">The color to set the pixel to.</param>
+		void SetPixel(int posX, int posY, unsigned long pixelColor) override;
+
+		/// <summary>
+		/// Gets the color key (mask color) of the bitmap, the color that DrawTrans skips.
+		/// </summary>
+		/// <returns>Always c_MaskColor.</returns>
+		unsigned long GetColorKey() const override { return c_MaskColor; }
+
+		/// <summary>
+		/// Gets the pixels of the bitmap, row by row with no padding.
+		/// </summary>
+		/// <returns>Pointer to the first pixel, or nullptr if the bitmap is empty.</returns>
+		uint32_t * GetPixels() { return m_Pixels; }
+
+		/// <summary>
+		/// Gets the pixels of the bitmap, row by row with no padding.
+		/// </summary>
+		/// <returns>Pointer to the first pixel, or nullptr if the bitmap is empty.</returns>
+		const uint32_t * GetPixels() const { return m_Pixels; }
+#pragma endregion
+
+#pragma region Clipping
+		/// <summary>
+		/// Gets the clipping rectangle of the bitmap.
+		/// </summary>
+		/// <param name="clippingRect">Pointer to a GUIRect to fill out.</param>
+		void GetClipRect(GUIRect *clippingRect) const override;
+
+		/// <summary>
+		/// Sets the clipping rectangle of the bitmap.
+		/// </summary>
+		/// <param name="clippingRect">Pointer to a GUIRect to use as the clipping rectangle, or nullptr for no clipping.</param>
+		void SetClipRect(GUIRect *clippingRect) override;
+
+		/// <summary>
+		/// Sets the clipping rectangle of the bitmap as the intersection of its current clipping rectangle and the passed-in rectangle.
+		/// </summary>
+		/// <param name="clippingRect">Pointer to a GUIRect to add to the existing clipping rectangle, or nullptr for no clipping.</param>
+		void AddClipRect(GUIRect *clippingRect) override;
+#pragma endregion
+
+#pragma region Drawing
+		/// <summary>
+		/// Draw a section of this bitmap onto another bitmap.
+		/// </summary>
+		/// <param name="destBitmap">Bitmap to draw onto. Has to be a SoftwareBitmap.</param>
+		/// <param name="destX">Destination X position.</param>
+		/// <param name="destY">Destination Y position.</param>
+		/// <param name="srcPosAndSizeRect">Source bitmap position and size rectangle, or nullptr to draw as much of the bitmap as the destination's size.</param>
+		void Draw(GUIBitmap *destBitmap, int destX, int destY, GUIRect *srcPosAndSizeRect) override;
+
+		/// <summary>
+		/// Draw a section of this bitmap onto another bitmap ignoring color-keyed pixels.
+		/// </summary>
+		/// <param name="destBitmap">Bitmap to draw onto. Has to be a SoftwareBitmap.</param>
+		/// <param name="destX">Destination X position.</param>
+		/// <param name="destY">Destination Y position.</param>
+		/// <param name="srcPosAndSizeRect">Source bitmap position and size rectangle, or nullptr to draw as much of the bitmap as the destination's size.</param>
+		void DrawTrans(GUIBitmap *destBitmap, int destX, int destY, GUIRect *srcPosAndSizeRect) override;
+
+		/// <summary>
+		/// Draw this bitmap scaled onto another bitmap ignoring color-keyed pixels.
+		/// </summary>
+		/// <param name="destBitmap">Bitmap to draw onto. Has to be a SoftwareBitmap.</param>
+		/// <param name="destX">Destination X position.</param>
+		/// <param name="destY">Destination Y position.</param>
+		/// <param name="width">Target width of the bitmap.</param>
+		/// <param name="height">Target height of the bitmap.</param>
+		void DrawTransScaled(GUIBitmap *destBitmap, int destX, int destY, int width, int height) override;
+
+		/// <summary>
+		/// Copies an area of this bitmap onto another SoftwareBitmap, clipped to this bitmap's bounds and the destination's clipping rectangle.
+		/// </summary>
+		/// <param name="destBitmap">Bitmap to draw onto. Can be this bitmap.</param>
+		/// <param name="srcX">Source X position.</param>
+		/// <param name="srcY">Source Y position.</param>
+		/// <param name="destX">Destination X position.</param>
+		/// <param name="destY">Destination Y position.</param>
+		/// <param name="width">Width of the area.</param>
+		/// <param name="height">Height of the area.</param>
+		/// <param name="masked">Whether to skip pixels of the mask color.</param>
+		void Blit(SoftwareBitmap *destBitmap, int srcX, int srcY, int destX, int destY, int width, int height, bool masked) const;
+
+		/// <summary>
+		/// Copies runs of pixels from a section of this bitmap onto another bitmap as they are, clipped to the destination's clipping rectangle.
+		/// </summary>
+		/// <param name="destBitmap">Bitmap to draw onto. Has to be a SoftwareBitmap.</param>
+		/// <param name="destX">Destination X position.</param>
+		/// <param name="destY">Destination Y position.</param>
+		/// <param name="srcPosAndSizeRect">Source bitmap position and size rectangle. Has to be within the bitmap, and the runs within it.</param>
+		/// <param name="spans">The runs of pixels to copy, relative to the source rectangle's top-left corner.</param>
+		/// <param name="spanCount">Number of runs to copy.</param>
+		/// <returns>Whether the runs were copied. False if either bitmap is empty.</returns>
+		bool DrawSpans(GUIBitmap *destBitmap, int destX, int destY, const GUIRect &srcPosAndSizeRect, const GUIPixelSpan *spans, int spanCount) override;
+#pragma endregion
+
+#pragma region Primitive Drawing
+		/// <summary>
+		/// Replaces every pixel of one color on this bitmap with another color.
+		/// </summary>
+		/// <param name="oldColor">The color to replace.</param>
+		/// <param name="newColor">The color to replace it with.</param>
+		void ReplaceColor(unsigned long oldColor, unsigned long newColor) override;
+
+		/// <summary>
+		/// Draws a line on this bitmap.
+		/// </summary>
+		/// <param name="x1">Start position on X axis.</param>
+		/// <param name="y1">Start position on Y axis.</param>
+		/// <param name="x2">End position on X axis.</param>
+		/// <param name="y2">End position on Y axis.</param>
+		/// <param name="color">Color to draw this line with.</param>
+		void DrawLine(int x1, int y1, int x2, int y2, unsigned long color) override;
+
+		/// <summary>
+		/// Draws a rectangle on this bitmap.
+		/// </summary>
+		/// <param name="posX">Position on X axis.</param>
+		/// <param name="posY">Position on Y axis.</param>
+		/// <param name="width">Width of rectangle.</param>
+		/// <param name="height">Height of rectangle.</param>
+		/// <param name="color">Color to draw this rectangle with.</param>
+		/// <param name="filled">Whether to fill the rectangle with the set color or not.</param>
+		void DrawRectangle(int posX, int posY, int width, int height, unsigned long color, bool filled) override;
+#pragma endregion
+
+	private:
+
+		std::shared_ptr<std::vector<uint32_t>> m_PixelBuffer; //!< The pixels of the bitmap, row by row. Shared with any views of the bitmap.
+		uint32_t *m_Pixels; //!< The first pixel in m_PixelBuffer, or nullptr if the bitmap is empty.
+		int m_Width; //!< Width of the bitmap.
+		int m_Height; //!< Height of the bitmap.
+		std::string m_DataPath; //!< The file the bitmap was loaded from, if it was.
+
+		int m_ClipLeft; //!< Left edge of the clipping rectangle, inclusive.
+		int m_ClipTop; //!< Top edge of the clipping rectangle, inclusive.
+		int m_ClipRight; //!< Right edge of the clipping rectangle, exclusive.
+		int m_ClipBottom; //!< Bottom edge of the clipping rectangle, exclusive.
+
+		/// <summary>
+		/// Fills a rectangle on this bitmap, clipped to the clipping rectangle. Corners can be given in any order.
+		/// </summary>
+		/// <param name="x1">X position of one corner, inclusive.</param>
+		/// <param name="y1">Y position of one corner, inclusive.</param>
+		/// <param name="x2">X position of the opposite corner, inclusive.</param>
+		/// <param name="y2">Y position of the opposite corner, inclusive.</param>
+		/// <param name="color">Color to fill the rectangle with.</param>
+		void FillRect(int x1, int y1, int x2, int y2, uint32_t color);
+
+		/// <summary>
+		/// Clears all the member variables of this SoftwareBitmap, effectively resetting the members of this abstraction level only.
+		/// </summary>
+		void Clear();
+
+		// Disallow the use of some implicit methods.
+		SoftwareBitmap & operator=(const SoftwareBitmap &rhs) = delete;
+	};
+};
+#endif
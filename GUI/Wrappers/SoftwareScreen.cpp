@@ -0,0 +1,81 @@
+#include "GUI.h"
+#include "SoftwareScreen.h"
+
+namespace RTE {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	SoftwareScreen::SoftwareScreen(int width, int height) {
+		m_BackBufferBitmap = std::make_unique<SoftwareBitmap>();
+		m_BackBufferBitmap->Create(width, height);
+		m_Palette.fill(0);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GUIBitmap * SoftwareScreen::CreateBitmap(const std::string &fileName) {
+		std::unique_ptr<SoftwareBitmap> newSoftwareBitmap = std::make_unique<SoftwareBitmap>();
+		return newSoftwareBitmap->Create(fileName) ? newSoftwareBitmap.release() : nullptr;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GUIBitmap * SoftwareScreen::CreateBitmap(int width, int height) {
+		std::unique_ptr<SoftwareBitmap> newSoftwareBitmap = std::make_unique<SoftwareBitmap>();
+		newSoftwareBitmap->Create(width, height);
+		return newSoftwareBitmap.release();
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GUIScreen * SoftwareScreen::CreateOffscreen(int width, int height) {
+		SoftwareScreen *offscreen = new SoftwareScreen(width, height);
+		offscreen->SetPalette(m_Palette);
+		return offscreen;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	GUIScreen * SoftwareScreen::CreateView() {
+		SoftwareScreen *view = new SoftwareScreen(0, 0);
+		view->m_BackBufferBitmap->CreateView(*m_BackBufferBitmap);
+		view->SetPalette(m_Palette);
+		return view;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareScreen::DrawBitmap(GUIBitmap *guiBitmap, int destX, int destY, GUIRect *srcPosAndSizeRect) {
+		if (!guiBitmap || !m_BackBufferBitmap) {
+			return;
+		}
+		const SoftwareBitmap *sourceBitmap = static_cast<SoftwareBitmap *>(guiBitmap);
+		if (srcPosAndSizeRect) {
+			sourceBitmap->Blit(m_BackBufferBitmap.get(), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top, false);
+		} else {
+			sourceBitmap->Blit(m_BackBufferBitmap.get(), 0, 0, destX, destY, sourceBitmap->GetWidth(), sourceBitmap->GetHeight(), false);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void SoftwareScreen::DrawBitmapTrans(GUIBitmap *guiBitmap, int destX, int destY, GUIRect *srcPosAndSizeRect) {
+		if (!guiBitmap || !m_BackBufferBitmap) {
+			return;
+		}
+		const SoftwareBitmap *sourceBitmap = static_cast<SoftwareBitmap *>(guiBitmap);
+		if (srcPosAndSizeRect) {
+			sourceBitmap->Blit(m_BackBufferBitmap.get(), srcPosAndSizeRect->left, srcPosAndSizeRect->top, destX, destY, srcPosAndSizeRect->right - srcPosAndSizeRect->left, srcPosAndSizeRect->bottom - srcPosAndSizeRect->top, true);
+		} else {
+			sourceBitmap->Blit(m_BackBufferBitmap.get(), 0, 0, destX, destY, sourceBitmap->GetWidth(), sourceBitmap->GetHeight(), true);
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	unsigned long SoftwareScreen::ConvertColor(unsigned long color, int targetColorDepth) {
+		// Everything is 32-bit here, so only palette indices need converting
+		if (targetColorDepth != 8 && color <= 255) { color = m_Palette[color]; }
+		return color;
+	}
+}
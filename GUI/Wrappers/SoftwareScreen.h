@@ -0,0 +1,118 @@
+#ifndef _SOFTWARESCREEN_
+#define _SOFTWARESCREEN_
+
+#include "SoftwareBitmap.h"
+
+namespace RTE {
+
+	/// <summary>
+	/// GUI library screen that draws into a SoftwareBitmap back buffer it owns, so the GUI can be drawn with no Allegro screen or display, e.g. headless.
+	/// </summary>
+	class SoftwareScreen : public GUIScreen {
+
+	public:
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a SoftwareScreen object in system memory and make it ready for use.
+		/// </summary>
+		/// <param name="width">Width of the back buffer.</param>
+		/// <param name="height">Height of the back buffer.</param>
+		SoftwareScreen(int width, int height);
+
+		/// <summary>
+		/// Creates a bitmap from a PNG file.
+		/// </summary>
+		/// <param name="fileName">File name to create bitmap from.</param>
+		/// <returns>Pointer to the created bitmap, or nullptr if the file couldn't be loaded. Ownership IS transferred!</returns>
+		GUIBitmap * CreateBitmap(const std::string &fileName) override;
+
+		/// <summary>
+		/// Creates an empty bitmap.
+		/// </summary>
+		/// <param name="width">Bitmap width.</param>
+		/// <param name="height">Bitmap height.</param>
+		/// <returns>Pointer to the created bitmap. Ownership IS transferred!</returns>
+		GUIBitmap * CreateBitmap(int width, int height) override;
+
+		/// <summary>
+		/// Creates a SoftwareScreen with a back buffer of the specified size and the same palette as this one.
+		/// </summary>
+		/// <param name="width">Width of the offscreen bitmap.</param>
+		/// <param name="height">Height of the offscreen bitmap.</param>
+		/// <returns>Pointer to the created screen. Ownership IS transferred!</returns>
+		GUIScreen * CreateOffscreen(int width, int height) override;
+
+		/// <summary>
+		/// Creates a SoftwareScreen whose back buffer is a view of this one's, with the same palette.
+		/// </summary>
+		/// <returns>Pointer to the created screen. Ownership IS transferred!</returns>
+		GUIScreen * CreateView() override;
+#pragma endregion
+
+#pragma region Destruction
+		/// <summary>
+		/// Destructor method used to clean up a SoftwareScreen object before deletion from system memory.
+		/// </summary>
+		~SoftwareScreen() override { Destroy(); }
+
+		/// <summary>
+		/// Destroys the SoftwareScreen object.
+		/// </summary>
+		void Destroy() override { m_BackBufferBitmap.reset(); }
+#pragma endregion
+
+#pragma region Getters and Setters
+		/// <summary>
+		/// Gets the bitmap representing the screen.
+		/// </summary>
+		/// <returns>Pointer to the bitmap representing the screen. Ownership is NOT transferred!</returns>
+		GUIBitmap * GetBitmap() const override { return m_BackBufferBitmap.get(); }
+
+		/// <summary>
+		/// Sets the palette 8bit palette indices are converted with. Defaults to all black.
+		/// </summary>
+		/// <param name="newPalette">The 32-bit color of each palette index, as 0xRRGGBB.</param>
+		void SetPalette(const std::array<unsigned long, 256> &newPalette) { m_Palette = newPalette; }
+#pragma endregion
+
+#pragma region Drawing
+		/// <summary>
+		/// Draws a bitmap onto the back buffer.
+		/// </summary>
+		/// <param name="guiBitmap">The bitmap to draw to this SoftwareScreen. Has to be a SoftwareBitmap.</param>
+		/// <param name="destX">Destination X position</param>
+		/// <param name="destY">Destination Y position</param>
+		/// <param name="srcPosAndSizeRect">Source bitmap position and size rectangle.</param>
+		void DrawBitmap(GUIBitmap *guiBitmap, int destX, int destY, GUIRect *srcPosAndSizeRect) override;
+
+		/// <summary>
+		/// Draws a bitmap onto the back buffer ignoring color-keyed pixels.
+		/// </summary>
+		/// <param name="guiBitmap">The bitmap to draw to this SoftwareScreen. Has to be a SoftwareBitmap.</param>
+		/// <param name="destX">Destination X position</param>
+		/// <param name="destY">Destination Y position</param>
+		/// <param name="srcPosAndSizeRect">Source bitmap position and size rectangle.</param>
+		void DrawBitmapTrans(GUIBitmap *guiBitmap, int destX, int destY, GUIRect *srcPosAndSizeRect) override;
+#pragma endregion
+
+#pragma region Virtual Override Methods
+		/// <summary>
+		/// Converts an 8bit palette index to a valid pixel format color.
+		/// </summary>
+		/// <param name="color">Color value in any bit depth. Will be converted to the format specified.</param>
+		/// <param name="targetColorDepth">An optional target color depth that will determine what format the color should be converted to. If this is 0, then 32-bit is used as target.</param>
+		/// <returns>The converted color.</returns>
+		unsigned long ConvertColor(unsigned long color, int targetColorDepth = 0) override;
+#pragma endregion
+
+	private:
+
+		std::unique_ptr<SoftwareBitmap> m_BackBufferBitmap; //!< The SoftwareBitmap that makes this SoftwareScreen.
+		std::array<unsigned long, 256> m_Palette; //!< The colors 8bit palette indices are converted to.
+
+		// Disallow the use of some implicit methods.
+		SoftwareScreen & operator=(const SoftwareScreen &rhs) = delete;
+	};
+};
+#endif
@@ -1,4 +1,5 @@
 #include "EditorApp.h"
+#include "EditorChecks.h"
 #include "EditorUtil.h"
 #include "ContentFile.h"
 #include "winalleg.h"
@@ -12,19 +13,39 @@ using namespace RTEGUI;
 /// Entry point for the GUI editor app.
 /// </summary>
 int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
+	// Convert a layout between the INI and compiled formats without starting the editor
+	if (__argc == 4 && std::strcmp(__argv[1], "-convert") == 0) {
+		return GUIControlManager::ConvertLayout(__argv[2], __argv[3]) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// Keep the image cache next to the executable rather than in whatever directory the editor was started from
+	std::filesystem::path executableDirectory;
+	char executablePath[MAX_PATH];
+	if (DWORD executablePathLength = GetModuleFileNameA(nullptr, executablePath, MAX_PATH); executablePathLength > 0 && executablePathLength < MAX_PATH) { executableDirectory = std::filesystem::path(executablePath).parent_path(); }
+	ContentFile::SetImageCacheDirectory((executableDirectory / ContentFile::GetImageCacheDirectory()).generic_string());
+
+	// Run checks and benchmarks without starting the editor. There's no console, so the results go to a log file next to the executable and the exit code
+	if (__argc >= 2 && std::strcmp(__argv[1], "-check") == 0) {
+		// No window is opened, but some checks load images or compare against Allegro's own drawing on memory bitmaps
+		install_allegro(SYSTEM_NONE, &errno, std::atexit);
+		loadpng_init();
+		set_color_depth(32);
+		set_color_conversion(COLORCONV_MOST);
+		bool checksPassed = EditorChecks::Run(std::vector<std::string>(__argv + 2, __argv + __argc), (executableDirectory / "GUIEditorChecks.log").generic_string());
+		ContentFile::FreeAllLoaded();
+		return checksPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	allegro_init();
 	loadpng_init();
 	g_GUIEditor.Initialize();
 
-	std::chrono::steady_clock::time_point frameTimeStart;
 	while (true) {
 		if (!g_GUIEditor.UpdateEditor()) {
 			break;
 		}
-		frameTimeStart = std::chrono::high_resolution_clock::now();
-		vsync();
-		g_GUIEditor.DrawEditor();
-		EditorApp::s_FrameTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - frameTimeStart).count();
+		// Nothing on screen changed, so sleep until the next input check or scheduled repaint instead of spinning on vsync
+		if (!g_GUIEditor.DrawEditor()) { rest(g_GUIEditor.GetIdleTime()); }
 	}
 	g_GUIEditor.DestroyBackBuffers();
 	ContentFile::FreeAllLoaded();
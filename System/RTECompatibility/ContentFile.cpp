@@ -1,11 +1,47 @@
 #include "ContentFile.h"
 #include "RTEError.h"
 
+#include "loadpng.h"
+#include "png.h"
+#include "allegro/internal/aintern.h"
+
+#include <cstring>
+
 namespace RTE {
 
+	/// <summary>
+	/// A PNG decoded into memory by PreloadBitmaps, laid out the way loadpng lays out the BITMAP it creates before converting it.
+	/// </summary>
+	struct ContentFile::DecodedImage {
+		double ScreenGamma = 0; //!< The screen gamma loadpng would correct for, 0 for none. Set before decoding, since it comes from Allegro and the environment.
+		bool SwapToBGR24 = false; //!< Whether 24 bit pixels need their red and blue swapped to match the 24 bit pixel format. Set before decoding.
+		bool SwapToBGR32 = false; //!< Whether 32 bit pixels need their red and blue swapped to match the 32 bit pixel format. Set before decoding.
+
+		int Width = 0; //!< Width of the image.
+		int Height = 0; //!< Height of the image.
+		int BitDepth = 0; //!< Bits per pixel, 8, 24 or 32.
+		bool IsPaletted = false; //!< Whether the PNG is a palette image.
+		bool HasPalette = false; //!< Whether Palette was read from the file. If not, a paletted image keeps the current palette and any other image uses a 332 palette, same as loadpng.
+		PALETTE Palette; //!< The palette from the file, in Allegro's 6 bit per component format.
+		std::vector<unsigned char> Pixels; //!< The pixel rows, one after the other with no padding.
+	};
+
 	const std::string ContentFile::c_ClassName = "ContentFile";
 
-	std::array<std::unordered_map<std::string, BITMAP *>, ContentFile::BitDepths::BitDepthCount> ContentFile::s_LoadedBitmaps;
+	std::array<std::unordered_map<std::string, ContentFile::LoadedBitmap>, ContentFile::BitDepths::BitDepthCount> ContentFile::s_LoadedBitmaps;
+	size_t ContentFile::s_LoadedBitmapBudget = 64 * 1024 * 1024;
+	size_t ContentFile::s_LoadedBitmapUseCount = 0;
+	ContentFile::LoadedBitmapStats ContentFile::s_LoadedBitmapStats;
+	std::unordered_map<std::string, std::future<std::unique_ptr<ContentFile::DecodedImage>>> ContentFile::s_PendingBitmaps;
+	std::vector<std::future<void>> ContentFile::s_DecodeWorkers;
+	std::string ContentFile::s_ImageCacheDirectory = "ImageCache"; // Relative to the working directory until the editor points it next to the executable on startup.
+
+	namespace {
+		// An image cache entry is the magic, the version, the key length and key, then the width, height and bit depth of the image followed by its pixel rows without padding.
+		// Increasing the version invalidates all existing entries.
+		const char c_ImageCacheMagic[4] = { '\x89', 'I', 'M', 'C' };
+		const uint32_t c_ImageCacheVersion = 1;
+	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -39,10 +75,43 @@ namespace RTE {
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	void ContentFile::FreeAllLoaded() {
+		// Let any decoding still going on finish before throwing the results away
+		for (std::future<void> &decodeWorker : s_DecodeWorkers) {
+			decodeWorker.wait();
+		}
+		s_DecodeWorkers.clear();
+		s_PendingBitmaps.clear();
+
+		// Handles that are still around keep their BITMAPs until they're let go
+		for (int depth = BitDepths::Eight; depth < BitDepths::BitDepthCount; ++depth) {
+			s_LoadedBitmaps.at(depth).clear();
+		}
+		s_LoadedBitmapStats.ResidentBytes = 0;
+		s_LoadedBitmapStats.ResidentBitmaps = 0;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::TrimLoadedBitmaps() {
+		if (s_LoadedBitmapStats.ResidentBytes <= s_LoadedBitmapBudget) {
+			return;
+		}
+		std::vector<std::pair<int, std::unordered_map<std::string, LoadedBitmap>::iterator>> evictableBitmaps;
 		for (int depth = BitDepths::Eight; depth < BitDepths::BitDepthCount; ++depth) {
-			for (const std::pair<std::string, BITMAP *> &bitmap : s_LoadedBitmaps.at(depth)) {
-				destroy_bitmap(bitmap.second);
+			for (std::unordered_map<std::string, LoadedBitmap>::iterator loadedBitmap = s_LoadedBitmaps.at(depth).begin(); loadedBitmap != s_LoadedBitmaps.at(depth).end(); ++loadedBitmap) {
+				if (loadedBitmap->second.Bitmap.use_count() == 1) { evictableBitmaps.emplace_back(depth, loadedBitmap); }
+			}
+		}
+		std::sort(evictableBitmaps.begin(), evictableBitmaps.end(), [](const auto &bitmapA, const auto &bitmapB) { return bitmapA.second->second.LastUsed < bitmapB.second->second.LastUsed; });
+
+		for (const std::pair<int, std::unordered_map<std::string, LoadedBitmap>::iterator> &evictableBitmap : evictableBitmaps) {
+			if (s_LoadedBitmapStats.ResidentBytes <= s_LoadedBitmapBudget) {
+				break;
 			}
+			s_LoadedBitmapStats.ResidentBytes -= evictableBitmap.second->second.Bytes;
+			s_LoadedBitmapStats.ResidentBitmaps--;
+			s_LoadedBitmapStats.Evictions++;
+			s_LoadedBitmaps.at(evictableBitmap.first).erase(evictableBitmap.second);
 		}
 	}
 
@@ -87,20 +156,39 @@ namespace RTE {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	BITMAP * ContentFile::GetAsBitmap(int conversionMode, bool storeBitmap, const std::string &dataPathToSpecificFrame) {
+	std::shared_ptr<BITMAP> ContentFile::GetAsBitmap(int conversionMode, bool storeBitmap, const std::string &dataPathToSpecificFrame) {
+		BITMAP *returnBitmap = nullptr;
+		LoadedBitmap *loadedBitmap = FindOrLoadBitmap(conversionMode, storeBitmap, dataPathToSpecificFrame, returnBitmap);
+		if (!loadedBitmap) {
+			// A BITMAP that wasn't stored belongs to the handle alone
+			return returnBitmap ? std::shared_ptr<BITMAP>(returnBitmap, destroy_bitmap) : nullptr;
+		}
+		// Take the handle before trimming, so the bitmap that was just asked for is never the one freed
+		std::shared_ptr<BITMAP> bitmapHandle = loadedBitmap->Bitmap;
+		TrimLoadedBitmaps();
+		return bitmapHandle;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	ContentFile::LoadedBitmap * ContentFile::FindOrLoadBitmap(int conversionMode, bool storeBitmap, const std::string &dataPathToSpecificFrame, BITMAP *&returnBitmap) {
+		returnBitmap = nullptr;
 		if (m_DataPath.empty()) {
 			return nullptr;
 		}
-		BITMAP *returnBitmap = nullptr;
 		const int bitDepth = (conversionMode == COLORCONV_8_TO_32) ? BitDepths::ThirtyTwo : BitDepths::Eight;
 		std::string dataPathToLoad = dataPathToSpecificFrame.empty() ? m_DataPath : dataPathToSpecificFrame;
 		SetFormattedReaderPosition(GetFormattedReaderPosition());
 
 		// Check if the file has already been read and loaded from the disk and, if so, use that data.
-		std::unordered_map<std::string, BITMAP *>::iterator foundBitmap = s_LoadedBitmaps.at(bitDepth).find(dataPathToLoad);
+		std::unordered_map<std::string, LoadedBitmap>::iterator foundBitmap = s_LoadedBitmaps.at(bitDepth).find(dataPathToLoad);
 		if (foundBitmap != s_LoadedBitmaps.at(bitDepth).end()) {
-			returnBitmap = (*foundBitmap).second;
+			s_LoadedBitmapStats.Hits++;
+			foundBitmap->second.LastUsed = ++s_LoadedBitmapUseCount;
+			returnBitmap = foundBitmap->second.Bitmap.get();
+			return &foundBitmap->second;
 		} else {
+			s_LoadedBitmapStats.Misses++;
 			if (!std::filesystem::exists(dataPathToLoad)) {
 				const std::string dataPathWithoutExtension = dataPathToLoad.substr(0, dataPathToLoad.length() - m_DataPathExtension.length());
 				const std::string altFileExtension = (m_DataPathExtension == ".png") ? ".bmp" : ".png";
@@ -115,19 +203,27 @@ namespace RTE {
 			returnBitmap = LoadAndReleaseBitmap(conversionMode, dataPathToLoad); // NOTE: This takes ownership of the bitmap file
 
 			// Insert the bitmap into the map, PASSING OVER OWNERSHIP OF THE LOADED DATAFILE
-			if (storeBitmap) { s_LoadedBitmaps.at(bitDepth).insert({ dataPathToLoad, returnBitmap }); }
+			if (storeBitmap && returnBitmap) {
+				LoadedBitmap &loadedBitmap = s_LoadedBitmaps.at(bitDepth)[dataPathToLoad];
+				loadedBitmap.Bitmap = std::shared_ptr<BITMAP>(returnBitmap, destroy_bitmap);
+				loadedBitmap.Bytes = static_cast<size_t>(returnBitmap->w) * returnBitmap->h * ((bitmap_color_depth(returnBitmap) + 7) / 8);
+				loadedBitmap.LastUsed = ++s_LoadedBitmapUseCount;
+				s_LoadedBitmapStats.ResidentBytes += loadedBitmap.Bytes;
+				s_LoadedBitmapStats.ResidentBitmaps++;
+				return &loadedBitmap;
+			}
 		}
-		return returnBitmap;
+		return nullptr;
 	}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	BITMAP ** ContentFile::GetAsAnimation(int frameCount, int conversionMode) {
-		if (m_DataPath.empty()) {
-			return nullptr;
+	std::vector<std::shared_ptr<BITMAP>> ContentFile::GetAsAnimation(int frameCount, int conversionMode) {
+		std::vector<std::shared_ptr<BITMAP>> returnBitmaps;
+		if (m_DataPath.empty() || frameCount < 1) {
+			return returnBitmaps;
 		}
-		// Create the array of as many BITMAP pointers as requested frames
-		BITMAP **returnBitmaps = new BITMAP *[frameCount];
+		returnBitmaps.reserve(frameCount);
 		SetFormattedReaderPosition(GetFormattedReaderPosition());
 
 		// Don't try to append numbers if there's only one frame
@@ -142,13 +238,21 @@ namespace RTE {
 					SetDataPath(m_DataPathWithoutExtension + "000" + altFileExtension);
 				}
 			}
-			returnBitmaps[0] = GetAsBitmap(conversionMode);
+			returnBitmaps.emplace_back(GetAsBitmap(conversionMode));
 			return returnBitmaps;
 		}
 		char framePath[1024];
+		std::vector<std::string> framePaths;
+		framePaths.reserve(frameCount);
 		for (int frameNum = 0; frameNum < frameCount; frameNum++) {
 			std::snprintf(framePath, sizeof(framePath), "%s%03i%s", m_DataPathWithoutExtension.c_str(), frameNum, m_DataPathExtension.c_str());
-			returnBitmaps[frameNum] = GetAsBitmap(conversionMode, true, framePath);
+			framePaths.emplace_back(framePath);
+		}
+		// Decode all the frames at once instead of one after the other
+		PreloadBitmaps(framePaths, conversionMode);
+
+		for (int frameNum = 0; frameNum < frameCount; frameNum++) {
+			returnBitmaps.emplace_back(GetAsBitmap(conversionMode, true, framePaths.at(frameNum)));
 		}
 		return returnBitmaps;
 	}
@@ -168,9 +272,347 @@ namespace RTE {
 		get_palette(currentPalette);
 
 		set_color_conversion((conversionMode == 0) ? COLORCONV_MOST : conversionMode);
-		returnBitmap = load_bitmap(dataPathToLoad.c_str(), currentPalette);
+
+		// Take this file out of the pending decodes before anything else, so its decoded image is dropped rather than left in the list if the cache has it
+		std::future<std::unique_ptr<DecodedImage>> pendingDecode;
+		if (std::unordered_map<std::string, std::future<std::unique_ptr<DecodedImage>>>::iterator pendingBitmap = s_PendingBitmaps.find(dataPathToLoad); pendingBitmap != s_PendingBitmaps.end()) {
+			pendingDecode = std::move(pendingBitmap->second);
+			s_PendingBitmaps.erase(pendingBitmap);
+		}
+
+		returnBitmap = LoadCachedBitmap(dataPathToLoad, conversionMode);
+		if (returnBitmap) {
+			return returnBitmap;
+		}
+
+		// Use the decoded image if PreloadBitmaps got to this one, waiting for it if it's still being decoded
+		if (pendingDecode.valid()) {
+			std::unique_ptr<DecodedImage> decodedImage = pendingDecode.get();
+			if (decodedImage) { returnBitmap = CreateBitmapFromDecodedImage(*decodedImage); }
+		}
+		if (!returnBitmap) { returnBitmap = load_bitmap(dataPathToLoad.c_str(), currentPalette); }
 		RTEAssert(returnBitmap, "Failed to load image file with following path and name:\n\n" + m_DataPathAndReaderPosition + "\nThe file may be corrupt, incorrectly converted or saved with unsupported parameters.");
 
+		SaveCachedBitmap(dataPathToLoad, conversionMode, returnBitmap);
+
 		return returnBitmap;
 	}
-}
\ No newline at end of file
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::PreloadBitmaps(const std::vector<std::string> &dataPaths, int conversionMode) {
+		// Drop the workers that are done so the list doesn't keep growing
+		s_DecodeWorkers.erase(std::remove_if(s_DecodeWorkers.begin(), s_DecodeWorkers.end(), [](const std::future<void> &decodeWorker) { return decodeWorker.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }), s_DecodeWorkers.end());
+
+		const int bitDepth = (conversionMode == COLORCONV_8_TO_32) ? BitDepths::ThirtyTwo : BitDepths::Eight;
+
+		// These come from Allegro's state and the environment, so read them here rather than on the workers. Same values loadpng uses.
+		double screenGamma = _png_screen_gamma;
+		if (screenGamma == -1.0) {
+			const char *screenGammaString = std::getenv("SCREEN_GAMMA");
+			screenGamma = screenGammaString ? std::atof(screenGammaString) : 2.2;
+		}
+		int blueColor24 = makecol_depth(24, 0, 0, 255);
+		int blueColor32 = makecol_depth(32, 0, 0, 255);
+		bool swapToBGR24 = reinterpret_cast<unsigned char *>(&blueColor24)[0] == 255;
+		bool swapToBGR32 = reinterpret_cast<unsigned char *>(&blueColor32)[0] == 255;
+
+		std::vector<std::pair<std::unique_ptr<DecodedImage>, std::promise<std::unique_ptr<DecodedImage>>>> decodeJobs;
+		std::vector<std::string> decodeJobPaths;
+		for (const std::string &dataPath : dataPaths) {
+			// Resolve the path the same way GetAsBitmap will, so the decoded image is found under the name it's looked up with
+			std::string dataPathToLoad = std::filesystem::path(dataPath).generic_string();
+			std::string dataPathExtension = std::filesystem::path(dataPathToLoad).extension().string();
+			if (!std::filesystem::exists(dataPathToLoad)) {
+				std::string altDataPath = dataPathToLoad.substr(0, dataPathToLoad.length() - dataPathExtension.length()) + ((dataPathExtension == ".png") ? ".bmp" : ".png");
+				if (!std::filesystem::exists(altDataPath)) {
+					continue;
+				}
+				dataPathToLoad = altDataPath;
+				dataPathExtension = std::filesystem::path(dataPathToLoad).extension().string();
+			}
+			if (stricmp(dataPathExtension.c_str(), ".png") != 0 || s_LoadedBitmaps.at(bitDepth).find(dataPathToLoad) != s_LoadedBitmaps.at(bitDepth).end() || s_PendingBitmaps.find(dataPathToLoad) != s_PendingBitmaps.end()) {
+				continue;
+			}
+			// Nothing to decode if the converted image is already in the cache
+			std::ifstream cacheFile;
+			int cachedWidth;
+			int cachedHeight;
+			int cachedBitDepth;
+			if (OpenCachedBitmap(dataPathToLoad, conversionMode, cacheFile, cachedWidth, cachedHeight, cachedBitDepth)) {
+				continue;
+			}
+			std::unique_ptr<DecodedImage> decodedImage = std::make_unique<DecodedImage>();
+			decodedImage->ScreenGamma = screenGamma;
+			decodedImage->SwapToBGR24 = swapToBGR24;
+			decodedImage->SwapToBGR32 = swapToBGR32;
+
+			std::promise<std::unique_ptr<DecodedImage>> decodePromise;
+			s_PendingBitmaps.try_emplace(dataPathToLoad, decodePromise.get_future());
+			decodeJobs.emplace_back(std::move(decodedImage), std::move(decodePromise));
+			decodeJobPaths.emplace_back(dataPathToLoad);
+		}
+		if (decodeJobs.empty()) {
+			return;
+		}
+
+		// A few workers take the images in turn, each one handed over as soon as it's decoded
+		std::shared_ptr<std::vector<std::pair<std::unique_ptr<DecodedImage>, std::promise<std::unique_ptr<DecodedImage>>>>> sharedDecodeJobs = std::make_shared<decltype(decodeJobs)>(std::move(decodeJobs));
+		std::shared_ptr<std::vector<std::string>> sharedDecodeJobPaths = std::make_shared<std::vector<std::string>>(std::move(decodeJobPaths));
+		std::shared_ptr<std::atomic<size_t>> nextDecodeJob = std::make_shared<std::atomic<size_t>>(0);
+
+		size_t workerCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), sharedDecodeJobs->size());
+		for (size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex) {
+			s_DecodeWorkers.emplace_back(std::async(std::launch::async, [sharedDecodeJobs, sharedDecodeJobPaths, nextDecodeJob]() {
+				for (size_t jobIndex = (*nextDecodeJob)++; jobIndex < sharedDecodeJobs->size(); jobIndex = (*nextDecodeJob)++) {
+					std::pair<std::unique_ptr<DecodedImage>, std::promise<std::unique_ptr<DecodedImage>>> &decodeJob = sharedDecodeJobs->at(jobIndex);
+					if (!DecodePng(sharedDecodeJobPaths->at(jobIndex), *decodeJob.first)) { decodeJob.first.reset(); }
+					decodeJob.second.set_value(std::move(decodeJob.first));
+				}
+			}));
+		}
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ContentFile::DecodePng(const std::string &dataPath, DecodedImage &decodedImage) {
+		std::unique_ptr<std::FILE, decltype(&std::fclose)> pngFile(std::fopen(dataPath.c_str(), "rb"), &std::fclose);
+		if (!pngFile) {
+			return false;
+		}
+		png_structp pngPtr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		png_infop infoPtr = pngPtr ? png_create_info_struct(pngPtr) : nullptr;
+		if (!infoPtr) {
+			png_destroy_read_struct(&pngPtr, nullptr, nullptr);
+			return false;
+		}
+		// libpng reports errors by jumping back here, so everything from here on only works with plain values and the already existing DecodedImage
+		if (setjmp(png_jmpbuf(pngPtr))) {
+			png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
+			return false;
+		}
+		png_init_io(pngPtr, pngFile.get());
+		png_read_info(pngPtr, infoPtr);
+
+		png_uint_32 width;
+		png_uint_32 height;
+		int bitDepth;
+		int colorType;
+		int interlaceType;
+		png_get_IHDR(pngPtr, infoPtr, &width, &height, &bitDepth, &colorType, &interlaceType, nullptr, nullptr);
+
+		// Same transformations as loadpng, in the same order
+		png_set_packing(pngPtr);
+		if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8) { png_set_expand(pngPtr); }
+		if (png_get_valid(pngPtr, infoPtr, PNG_INFO_tRNS) && !(colorType & PNG_COLOR_MASK_PALETTE)) { png_set_tRNS_to_alpha(pngPtr); }
+		if (bitDepth == 16) { png_set_strip_16(pngPtr); }
+		if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA) { png_set_gray_to_rgb(pngPtr); }
+		if (decodedImage.ScreenGamma != 0) {
+			int renderingIntent;
+			double imageGamma;
+			if (png_get_sRGB(pngPtr, infoPtr, &renderingIntent)) {
+				png_set_gamma(pngPtr, decodedImage.ScreenGamma, 0.45455);
+			} else if (png_get_gAMA(pngPtr, infoPtr, &imageGamma)) {
+				png_set_gamma(pngPtr, decodedImage.ScreenGamma, imageGamma);
+			} else {
+				png_set_gamma(pngPtr, decodedImage.ScreenGamma, 0.45455);
+			}
+		}
+		int passCount = png_set_interlace_handling(pngPtr);
+		png_read_update_info(pngPtr, infoPtr);
+
+		decodedImage.IsPaletted = colorType & PNG_COLOR_MASK_PALETTE;
+		png_colorp pngPalette;
+		int pngPaletteSize;
+		if (decodedImage.IsPaletted && png_get_PLTE(pngPtr, infoPtr, &pngPalette, &pngPaletteSize)) {
+			for (int colorIndex = 0; colorIndex < PAL_SIZE; ++colorIndex) {
+				bool inPalette = colorIndex < pngPaletteSize;
+				decodedImage.Palette[colorIndex].r = inPalette ? pngPalette[colorIndex].red >> 2 : 0;
+				decodedImage.Palette[colorIndex].g = inPalette ? pngPalette[colorIndex].green >> 2 : 0;
+				decodedImage.Palette[colorIndex].b = inPalette ? pngPalette[colorIndex].blue >> 2 : 0;
+			}
+			decodedImage.HasPalette = true;
+		}
+
+		png_size_t rowBytes = png_get_rowbytes(pngPtr, infoPtr);
+		decodedImage.Width = static_cast<int>(width);
+		decodedImage.Height = static_cast<int>(height);
+		decodedImage.BitDepth = std::max(static_cast<int>(rowBytes * 8 / width), 8);
+		if ((decodedImage.BitDepth == 24 && decodedImage.SwapToBGR24) || (decodedImage.BitDepth == 32 && decodedImage.SwapToBGR32)) { png_set_bgr(pngPtr); }
+
+		decodedImage.Pixels.resize(rowBytes * height);
+		for (int pass = 0; pass < passCount; ++pass) {
+			for (png_uint_32 row = 0; row < height; ++row) {
+				png_read_row(pngPtr, decodedImage.Pixels.data() + row * rowBytes, nullptr);
+			}
+		}
+		png_read_end(pngPtr, infoPtr);
+		png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
+		return true;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	BITMAP * ContentFile::CreateBitmapFromDecodedImage(const DecodedImage &decodedImage) {
+		BITMAP *returnBitmap = create_bitmap_ex(decodedImage.BitDepth, decodedImage.Width, decodedImage.Height);
+		if (!returnBitmap) {
+			return nullptr;
+		}
+		size_t rowBytes = decodedImage.Pixels.size() / decodedImage.Height;
+		for (int row = 0; row < decodedImage.Height; ++row) {
+			std::memcpy(returnBitmap->line[row], decodedImage.Pixels.data() + row * rowBytes, rowBytes);
+		}
+
+		PALETTE conversionPalette;
+		if (decodedImage.HasPalette) {
+			std::memcpy(conversionPalette, decodedImage.Palette, sizeof(PALETTE));
+		} else if (decodedImage.IsPaletted) {
+			get_palette(conversionPalette);
+		} else {
+			generate_332_palette(conversionPalette);
+		}
+		// Let Allegro convert the image into the desired color depth, like loadpng does
+		int targetBitDepth = _color_load_depth(decodedImage.BitDepth, decodedImage.BitDepth == 32);
+		if (targetBitDepth != decodedImage.BitDepth) { returnBitmap = _fixup_loaded_bitmap(returnBitmap, conversionPalette, targetBitDepth); }
+
+		return returnBitmap;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::string ContentFile::GetImageCacheKey(const std::string &dataPath, int conversionMode) {
+		std::error_code fileError;
+		uintmax_t fileSize = std::filesystem::file_size(dataPath, fileError);
+		std::filesystem::file_time_type fileWriteTime = std::filesystem::last_write_time(dataPath, fileError);
+		if (s_ImageCacheDirectory.empty() || fileError) {
+			return "";
+		}
+		// The converted pixels depend on the conversion, the screen's color depth and pixel formats, and the gamma PNGs are corrected for
+		std::string cacheKey = dataPath + "\n" + std::to_string(fileSize) + "\n" + std::to_string(fileWriteTime.time_since_epoch().count());
+		cacheKey += "\n" + std::to_string((conversionMode == 0) ? COLORCONV_MOST : conversionMode) + "\n" + std::to_string(get_color_depth());
+		for (int colorDepth : { 15, 16, 24, 32 }) {
+			cacheKey += "\n" + std::to_string(makecol_depth(colorDepth, 255, 0, 0)) + "," + std::to_string(makecol_depth(colorDepth, 0, 255, 0)) + "," + std::to_string(makecol_depth(colorDepth, 0, 0, 255));
+		}
+		cacheKey += "\n" + std::to_string(_png_screen_gamma);
+		if (const char *screenGammaString = std::getenv("SCREEN_GAMMA")) { cacheKey += screenGammaString; }
+
+		// 8 bit images without a palette of their own, and anything converted to 8 bit, go through the current palette, so a different palette needs a different entry
+		PALETTE currentPalette;
+		get_palette(currentPalette);
+		uint64_t paletteHash = 14695981039346656037ULL;
+		for (const RGB &paletteColor : currentPalette) {
+			for (unsigned char colorComponent : { paletteColor.r, paletteColor.g, paletteColor.b }) { paletteHash = (paletteHash ^ colorComponent) * 1099511628211ULL; }
+		}
+		cacheKey += "\n" + std::to_string(paletteHash);
+		return cacheKey;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	std::string ContentFile::GetImageCacheFilePath(const std::string &dataPath, int conversionMode) {
+		// FNV-1a, just to turn the path into a file name
+		uint64_t pathHash = 14695981039346656037ULL;
+		for (char pathChar : dataPath + "|" + std::to_string(conversionMode)) {
+			pathHash = (pathHash ^ static_cast<unsigned char>(pathChar)) * 1099511628211ULL;
+		}
+		char cacheFileName[32];
+		std::snprintf(cacheFileName, sizeof(cacheFileName), "%016llx.imc", static_cast<unsigned long long>(pathHash));
+		return s_ImageCacheDirectory + "/" + cacheFileName;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	bool ContentFile::OpenCachedBitmap(const std::string &dataPath, int conversionMode, std::ifstream &cacheFile, int &width, int &height, int &bitDepth) {
+		std::string expectedKey = GetImageCacheKey(dataPath, conversionMode);
+		if (expectedKey.empty()) {
+			return false;
+		}
+		cacheFile.open(GetImageCacheFilePath(dataPath, conversionMode), std::ios::binary);
+		if (!cacheFile.is_open()) {
+			return false;
+		}
+		char magic[sizeof(c_ImageCacheMagic)];
+		uint32_t version;
+		uint32_t keyLength;
+		cacheFile.read(magic, sizeof(magic));
+		cacheFile.read(reinterpret_cast<char *>(&version), sizeof(version));
+		cacheFile.read(reinterpret_cast<char *>(&keyLength), sizeof(keyLength));
+		if (!cacheFile || std::memcmp(magic, c_ImageCacheMagic, sizeof(magic)) != 0 || version != c_ImageCacheVersion || keyLength != expectedKey.size()) {
+			return false;
+		}
+		std::string cachedKey(keyLength, '\0');
+		cacheFile.read(cachedKey.data(), keyLength);
+		cacheFile.read(reinterpret_cast<char *>(&width), sizeof(width));
+		cacheFile.read(reinterpret_cast<char *>(&height), sizeof(height));
+		cacheFile.read(reinterpret_cast<char *>(&bitDepth), sizeof(bitDepth));
+		return cacheFile && cachedKey == expectedKey && width > 0 && height > 0 && (bitDepth == 8 || bitDepth == 15 || bitDepth == 16 || bitDepth == 24 || bitDepth == 32);
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	BITMAP * ContentFile::LoadCachedBitmap(const std::string &dataPath, int conversionMode) {
+		std::ifstream cacheFile;
+		int width;
+		int height;
+		int bitDepth;
+		if (!OpenCachedBitmap(dataPath, conversionMode, cacheFile, width, height, bitDepth)) {
+			return nullptr;
+		}
+		BITMAP *cachedBitmap = create_bitmap_ex(bitDepth, width, height);
+		if (!cachedBitmap) {
+			return nullptr;
+		}
+		size_t rowBytes = static_cast<size_t>(width) * ((bitDepth + 7) / 8);
+		for (int row = 0; row < height; ++row) {
+			cacheFile.read(reinterpret_cast<char *>(cachedBitmap->line[row]), rowBytes);
+		}
+		// A short entry means it was cut off somehow, so don't trust any of it
+		if (!cacheFile) {
+			destroy_bitmap(cachedBitmap);
+			return nullptr;
+		}
+		return cachedBitmap;
+	}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	void ContentFile::SaveCachedBitmap(const std::string &dataPath, int conversionMode, const BITMAP *bitmap) {
+		std::string cacheKey = GetImageCacheKey(dataPath, conversionMode);
+		if (cacheKey.empty() || !bitmap) {
+			return;
+		}
+		std::error_code directoryError;
+		std::filesystem::create_directories(s_ImageCacheDirectory, directoryError);
+
+		// Written to a temporary file that replaces the entry once complete, so an interrupted write never leaves a valid looking entry behind
+		std::string cacheFilePath = GetImageCacheFilePath(dataPath, conversionMode);
+		std::string tempCacheFilePath = cacheFilePath + ".tmp";
+		{
+			std::ofstream cacheFile(tempCacheFilePath, std::ios::binary | std::ios::trunc);
+			if (!cacheFile.is_open()) {
+				return;
+			}
+			uint32_t keyLength = static_cast<uint32_t>(cacheKey.size());
+			int bitDepth = bitmap_color_depth(const_cast<BITMAP *>(bitmap));
+			cacheFile.write(c_ImageCacheMagic, sizeof(c_ImageCacheMagic));
+			cacheFile.write(reinterpret_cast<const char *>(&c_ImageCacheVersion), sizeof(c_ImageCacheVersion));
+			cacheFile.write(reinterpret_cast<const char *>(&keyLength), sizeof(keyLength));
+			cacheFile.write(cacheKey.data(), cacheKey.size());
+			cacheFile.write(reinterpret_cast<const char *>(&bitmap->w), sizeof(bitmap->w));
+			cacheFile.write(reinterpret_cast<const char *>(&bitmap->h), sizeof(bitmap->h));
+			cacheFile.write(reinterpret_cast<const char *>(&bitDepth), sizeof(bitDepth));
+
+			size_t rowBytes = static_cast<size_t>(bitmap->w) * ((bitDepth + 7) / 8);
+			for (int row = 0; row < bitmap->h; ++row) {
+				cacheFile.write(reinterpret_cast<const char *>(bitmap->line[row]), rowBytes);
+			}
+			if (!cacheFile.flush()) {
+				cacheFile.close();
+				std::filesystem::remove(tempCacheFilePath, directoryError);
+				return;
+			}
+		}
+		std::filesystem::rename(tempCacheFilePath, cacheFilePath, directoryError);
+		if (directoryError) { std::filesystem::remove(tempCacheFilePath, directoryError); }
+	}
+}
@@ -61,6 +61,68 @@ namespace RTE {
 		static void FreeAllLoaded();
 #pragma endregion
 
+#pragma region Loaded Bitmap Budget
+		/// <summary>
+		/// Statistics about the BITMAPs kept in the static maps.
+		/// </summary>
+		struct LoadedBitmapStats {
+			size_t ResidentBytes = 0; //!< Pixel memory used by all the loaded BITMAPs.
+			size_t ResidentBitmaps = 0; //!< Number of loaded BITMAPs.
+			size_t Hits = 0; //!< Number of requests for a BITMAP that was already loaded.
+			size_t Misses = 0; //!< Number of requests that had to load the BITMAP.
+			size_t Evictions = 0; //!< Number of BITMAPs freed to stay within the budget.
+		};
+
+		/// <summary>
+		/// Gets the statistics about the BITMAPs kept in the static maps.
+		/// </summary>
+		/// <returns>The loaded BITMAP statistics.</returns>
+		static const LoadedBitmapStats & GetLoadedBitmapStats() { return s_LoadedBitmapStats; }
+
+		/// <summary>
+		/// Gets how much pixel memory the loaded BITMAPs may use before unused ones start being freed.
+		/// </summary>
+		/// <returns>The budget in bytes.</returns>
+		static size_t GetLoadedBitmapBudget() { return s_LoadedBitmapBudget; }
+
+		/// <summary>
+		/// Sets how much pixel memory the loaded BITMAPs may use before unused ones start being freed, and frees any over the new budget.
+		/// Only BITMAPs without any handles from GetAsBitmap are freed, least recently requested first. The budget can be exceeded if everything is in use.
+		/// </summary>
+		/// <param name="newBudget">The new budget in bytes.</param>
+		static void SetLoadedBitmapBudget(size_t newBudget) { s_LoadedBitmapBudget = newBudget; TrimLoadedBitmaps(); }
+
+		/// <summary>
+		/// Frees the least recently requested unused BITMAPs until the loaded ones fit in the budget again.
+		/// </summary>
+		static void TrimLoadedBitmaps();
+#pragma endregion
+
+#pragma region Batch Loading
+		/// <summary>
+		/// Starts decoding a set of PNG images on worker threads, so the GetAsBitmap calls that load them later only have to convert them into BITMAPs.
+		/// Images that are already loaded or already being decoded are skipped, as are non-PNG files, which GetAsBitmap loads the regular way.
+		/// </summary>
+		/// <param name="dataPaths">The paths of the images to decode.</param>
+		/// <param name="conversionMode">The Allegro color conversion mode the images will be loaded with, used to skip the ones already loaded at that depth.</param>
+		static void PreloadBitmaps(const std::vector<std::string> &dataPaths, int conversionMode = 0);
+#pragma endregion
+
+#pragma region Image Cache
+		/// <summary>
+		/// Gets the directory loaded images are cached in, already converted to the format they are used in.
+		/// </summary>
+		/// <returns>The image cache directory. Empty if caching is disabled.</returns>
+		static const std::string & GetImageCacheDirectory() { return s_ImageCacheDirectory; }
+
+		/// <summary>
+		/// Sets the directory loaded images are cached in, already converted to the format they are used in.
+		/// An image is loaded from the cache instead of its file as long as the file's size and modification time, the screen format and the palette are the same as when it was cached.
+		/// </summary>
+		/// <param name="newDirectory">The new image cache directory. Empty disables caching.</param>
+		static void SetImageCacheDirectory(const std::string &newDirectory) { s_ImageCacheDirectory = newDirectory; }
+#pragma endregion
+
 #pragma region Getters and Setters
 		/// <summary>
 		/// Gets the file path of the content file represented by this ContentFile object.
@@ -84,22 +146,23 @@ namespace RTE {
 
 #pragma region Data Handling
 		/// <summary>
-		/// Gets the data represented by this ContentFile object as an Allegro BITMAP, loading it into the static maps if it's not already loaded. Note that ownership of the BITMAP is NOT transferred!
+		/// Gets the data represented by this ContentFile object as a handle to an Allegro BITMAP, loading it into the static maps if it's not already loaded.
+		/// The BITMAP stays loaded while any handle to it exists. After that it may be freed when the loaded BITMAPs go over the budget.
 		/// </summary>
 		/// <param name="conversionMode">The Allegro color conversion mode to use when loading this bitmap.</param>
-		/// <param name="storeBitmap">Whether to store the BITMAP in the relevant static map after loading it or not.</param>
+		/// <param name="storeBitmap">Whether to store the BITMAP in the relevant static map after loading it or not. If not, the returned handle is its only owner.</param>
 		/// <param name="dataPathToSpecificFrame">Path to a specific frame when loading an animation to avoid overwriting the original preset DataPath when loading each frame.</param>
-		/// <returns>Pointer to the BITMAP loaded from disk.</returns>
-		BITMAP * GetAsBitmap(int conversionMode = 0, bool storeBitmap = true, const std::string &dataPathToSpecificFrame = "");
+		/// <returns>Handle to the BITMAP loaded from disk.</returns>
+		std::shared_ptr<BITMAP> GetAsBitmap(int conversionMode = 0, bool storeBitmap = true, const std::string &dataPathToSpecificFrame = "");
 
 		/// <summary>
-		/// Gets the data represented by this ContentFile object as an array of Allegro BITMAPs, each representing a frame in the animation.
-		/// It loads the BITMAPs into the static maps if they're not already loaded. Ownership of the BITMAPs is NOT transferred, but the array itself IS!
+		/// Gets the data represented by this ContentFile object as handles to Allegro BITMAPs, each representing a frame in the animation.
+		/// It loads the BITMAPs into the static maps if they're not already loaded. Each frame stays loaded while any handle to it exists, same as with GetAsBitmap.
 		/// </summary>
 		/// <param name="frameCount">The number of frames to attempt to load, more than 1 frame will mean 00# is appended to datapath to handle naming conventions.</param>
 		/// <param name="conversionMode">The Allegro color conversion mode to use when loading this bitmap.</param>
-		/// <returns>Pointer to the beginning of the array of BITMAP pointers loaded from the disk, the length of which is specified with the FrameCount argument.</returns>
-		BITMAP ** GetAsAnimation(int frameCount = 1, int conversionMode = 0);
+		/// <returns>Handles to the BITMAPs loaded from the disk, one per frame. Empty if there is no data path.</returns>
+		std::vector<std::shared_ptr<BITMAP>> GetAsAnimation(int frameCount = 1, int conversionMode = 0);
 #pragma endregion
 
 	protected:
@@ -109,7 +172,25 @@ namespace RTE {
 		/// </summary>
 		enum BitDepths { Eight = 0, ThirtyTwo, BitDepthCount };
 
-		static std::array<std::unordered_map<std::string, BITMAP *>, BitDepthCount> s_LoadedBitmaps; //!< Static map containing all the already loaded BITMAPs and their paths for each bit depth.
+		/// <summary>
+		/// A BITMAP kept in the static maps.
+		/// </summary>
+		struct LoadedBitmap {
+			std::shared_ptr<BITMAP> Bitmap; //!< The BITMAP. Any other owner of this pointer is a handle from GetAsBitmap.
+			size_t Bytes = 0; //!< Pixel memory used by the BITMAP.
+			size_t LastUsed = 0; //!< When the BITMAP was last requested, compared against s_LoadedBitmapUseCount.
+		};
+
+		static std::array<std::unordered_map<std::string, LoadedBitmap>, BitDepthCount> s_LoadedBitmaps; //!< Static map containing all the already loaded BITMAPs and their paths for each bit depth.
+		static size_t s_LoadedBitmapBudget; //!< How much pixel memory the loaded BITMAPs may use before unused ones start being freed.
+		static size_t s_LoadedBitmapUseCount; //!< Counts up with every request for a loaded BITMAP, to tell which was requested least recently.
+		static LoadedBitmapStats s_LoadedBitmapStats; //!< Statistics about the loaded BITMAPs.
+
+		struct DecodedImage;
+		static std::unordered_map<std::string, std::future<std::unique_ptr<DecodedImage>>> s_PendingBitmaps; //!< Static map of the images started by PreloadBitmaps that haven't been loaded yet, by path. A null result means decoding failed.
+		static std::vector<std::future<void>> s_DecodeWorkers; //!< The worker threads started by PreloadBitmaps.
+
+		static std::string s_ImageCacheDirectory; //!< The directory converted images are cached in. Empty if caching is disabled.
 
 		std::string m_DataPath; //!< The path to this ContentFile's data file. In the case of an animation, this filename/name will be appended with 000, 001, 002 etc.
 		std::string m_DataPathExtension; //!< The extension of the data file of this ContentFile's path.
@@ -123,6 +204,16 @@ namespace RTE {
 		static const std::string c_ClassName; //!< A string with the friendly-formatted type name of this object.
 
 #pragma region Data Handling
+		/// <summary>
+		/// Finds the data represented by this ContentFile object in the static maps, loading it into them if it's not already loaded.
+		/// </summary>
+		/// <param name="conversionMode">The Allegro color conversion mode to use when loading this bitmap.</param>
+		/// <param name="storeBitmap">Whether to store the BITMAP in the relevant static map after loading it or not.</param>
+		/// <param name="dataPathToSpecificFrame">Path to a specific frame when loading an animation to avoid overwriting the original preset DataPath when loading each frame.</param>
+		/// <param name="returnBitmap">Filled with the BITMAP that was found or loaded. If it wasn't stored, ownership of it IS transferred!</param>
+		/// <returns>The static map entry of the BITMAP, or nullptr if it was loaded without storing it.</returns>
+		LoadedBitmap * FindOrLoadBitmap(int conversionMode, bool storeBitmap, const std::string &dataPathToSpecificFrame, BITMAP *&returnBitmap);
+
 		/// <summary>
 		/// Loads and transfers the data represented by this ContentFile object as an Allegro BITMAP. Ownership of the BITMAP IS transferred!
 		/// Note that this is relatively slow since it reads the data from disk each time.
@@ -131,6 +222,67 @@ namespace RTE {
 		/// <param name="dataPathToSpecificFrame">Path to a specific frame when loading an animation to avoid overwriting the original preset DataPath when loading each frame.</param>
 		/// <returns>Pointer to the BITMAP loaded from disk.</returns>
 		BITMAP * LoadAndReleaseBitmap(int conversionMode = 0, const std::string &dataPathToSpecificFrame = "");
+
+		/// <summary>
+		/// Decodes a PNG file into memory the same way loadpng does, but without touching any Allegro state so it can run on any thread.
+		/// </summary>
+		/// <param name="dataPath">The path of the PNG file.</param>
+		/// <param name="decodedImage">The DecodedImage to fill in.</param>
+		/// <returns>Whether the file could be decoded.</returns>
+		static bool DecodePng(const std::string &dataPath, DecodedImage &decodedImage);
+
+		/// <summary>
+		/// Creates a BITMAP from a decoded image, converting it to the depth set by the current color conversion mode same as load_bitmap would. Ownership of the BITMAP IS transferred!
+		/// </summary>
+		/// <param name="decodedImage">The decoded image.</param>
+		/// <returns>Pointer to the created BITMAP.</returns>
+		static BITMAP * CreateBitmapFromDecodedImage(const DecodedImage &decodedImage);
+#pragma endregion
+
+#pragma region Image Cache
+		/// <summary>
+		/// Gets the string an image cache entry must have been written with to be valid: the image's path, size and modification time, and everything about the current state that the converted pixels depend on.
+		/// </summary>
+		/// <param name="dataPath">The path of the image file.</param>
+		/// <param name="conversionMode">The Allegro color conversion mode the image is loaded with.</param>
+		/// <returns>The cache key. Empty if caching is disabled or the image file can't be found.</returns>
+		static std::string GetImageCacheKey(const std::string &dataPath, int conversionMode);
+
+		/// <summary>
+		/// Gets the path of the image cache entry for an image. Each image has one entry per conversion mode, which is overwritten when the image changes.
+		/// </summary>
+		/// <param name="dataPath">The path of the image file.</param>
+		/// <param name="conversionMode">The Allegro color conversion mode the image is loaded with.</param>
+		/// <returns>The path of the cache entry.</returns>
+		static std::string GetImageCacheFilePath(const std::string &dataPath, int conversionMode);
+
+		/// <summary>
+		/// Opens an image cache entry and reads its header, if the entry exists and is up to date.
+		/// </summary>
+		/// <param name="dataPath">The path of the image file.</param>
+		/// <param name="conversionMode">The Allegro color conversion mode the image is loaded with.</param>
+		/// <param name="cacheFile">The stream to open the entry with. Left positioned at the start of the pixel data.</param>
+		/// <param name="width">Filled with the width of the cached image.</param>
+		/// <param name="height">Filled with the height of the cached image.</param>
+		/// <param name="bitDepth">Filled with the bit depth of the cached image.</param>
+		/// <returns>Whether there is an up to date entry.</returns>
+		static bool OpenCachedBitmap(const std::string &dataPath, int conversionMode, std::ifstream &cacheFile, int &width, int &height, int &bitDepth);
+
+		/// <summary>
+		/// Loads an image from the image cache. Ownership of the BITMAP IS transferred!
+		/// </summary>
+		/// <param name="dataPath">The path of the image file.</param>
+		/// <param name="conversionMode">The Allegro color conversion mode the image is loaded with.</param>
+		/// <returns>Pointer to the loaded BITMAP, or nullptr if there is no up to date entry.</returns>
+		static BITMAP * LoadCachedBitmap(const std::string &dataPath, int conversionMode);
+
+		/// <summary>
+		/// Writes a loaded image to the image cache, replacing any previous entry for it.
+		/// </summary>
+		/// <param name="dataPath">The path of the image file.</param>
+		/// <param name="conversionMode">The Allegro color conversion mode the image was loaded with.</param>
+		/// <param name="bitmap">The loaded image.</param>
+		static void SaveCachedBitmap(const std::string &dataPath, int conversionMode, const BITMAP *bitmap);
 #pragma endregion
 
 		/// <summary>
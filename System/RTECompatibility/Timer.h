@@ -4,19 +4,114 @@
 #include "RTEError.h"
 
 namespace RTE {
+
 	/// <summary>
-	/// This is here just so everything compiles because GUI relies on RTE Timer but it's irrelevant in the editor.
+	/// A timer that measures real time on the steady clock, with the same real time interface as the RTE Timer the GUI relies on.
+	/// The editor has no simulation, so there is no sim time.
 	/// </summary>
 	class Timer {
+
 	public:
-		Timer() = default;
-		void Reset() { return; }
-		double GetElapsedRealTimeMS() const { return 0; }
-		double GetElapsedRealTimeS() const { return 0; }
-		double GetRealTimeLimitMS() const { return 0; }
-		void SetRealTimeLimitMS(double newTimeLimit) {}
-		bool IsPastRealTimeLimit() const { return false; }
-		double RealTimeLimitProgress() const { return 0; }
+
+#pragma region Creation
+		/// <summary>
+		/// Constructor method used to instantiate a Timer object in system memory. The timer starts running straight away with no time limit.
+		/// </summary>
+		Timer() { Reset(); }
+
+		/// <summary>
+		/// Constructor method used to instantiate a Timer object with a real time limit in system memory.
+		/// </summary>
+		/// <param name="realTimeLimitMS">The real time limit in milliseconds. Negative values mean there is no limit.</param>
+		explicit Timer(double realTimeLimitMS) { Reset(); SetRealTimeLimitMS(realTimeLimitMS); }
+#pragma endregion
+
+#pragma region Real Time
+		/// <summary>
+		/// Restarts the timer. The time limit is kept.
+		/// </summary>
+		void Reset() { m_StartRealTime = std::chrono::steady_clock::now(); }
+
+		/// <summary>
+		/// Gets the real time elapsed since the timer was last reset.
+		/// </summary>
+		/// <returns>The elapsed real time in milliseconds.</returns>
+		double GetElapsedRealTimeMS() const { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_StartRealTime).count(); }
+
+		/// <summary>
+		/// Sets the real time elapsed, as if the timer had been reset that long ago.
+		/// </summary>
+		/// <param name="newElapsedRealTime">The elapsed real time in milliseconds.</param>
+		void SetElapsedRealTimeMS(double newElapsedRealTime) { m_StartRealTime = std::chrono::steady_clock::now() - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(newElapsedRealTime)); }
+
+		/// <summary>
+		/// Gets the real time elapsed since the timer was last reset.
+		/// </summary>
+		/// <returns>The elapsed real time in seconds.</returns>
+		double GetElapsedRealTimeS() const { return GetElapsedRealTimeMS() / 1000.0; }
+
+		/// <summary>
+		/// Sets the real time elapsed, as if the timer had been reset that long ago.
+		/// </summary>
+		/// <param name="newElapsedRealTime">The elapsed real time in seconds.</param>
+		void SetElapsedRealTimeS(double newElapsedRealTime) { SetElapsedRealTimeMS(newElapsedRealTime * 1000.0); }
+#pragma endregion
+
+#pragma region Real Time Limit
+		/// <summary>
+		/// Gets the real time limit, counted from the last reset.
+		/// </summary>
+		/// <returns>The real time limit in milliseconds, or a negative value if there is no limit.</returns>
+		double GetRealTimeLimitMS() const { return m_RealTimeLimitMS; }
+
+		/// <summary>
+		/// Sets the real time limit, counted from the last reset.
+		/// </summary>
+		/// <param name="newTimeLimit">The real time limit in milliseconds. Negative values mean there is no limit.</param>
+		void SetRealTimeLimitMS(double newTimeLimit) { m_RealTimeLimitMS = newTimeLimit; }
+
+		/// <summary>
+		/// Gets the real time limit, counted from the last reset.
+		/// </summary>
+		/// <returns>The real time limit in seconds, or a negative value if there is no limit.</returns>
+		double GetRealTimeLimitS() const { return m_RealTimeLimitMS / 1000.0; }
+
+		/// <summary>
+		/// Sets the real time limit, counted from the last reset.
+		/// </summary>
+		/// <param name="newTimeLimit">The real time limit in seconds. Negative values mean there is no limit.</param>
+		void SetRealTimeLimitS(double newTimeLimit) { m_RealTimeLimitMS = newTimeLimit * 1000.0; }
+
+		/// <summary>
+		/// Gets whether the elapsed real time has passed the time limit. A timer with no limit is always past it.
+		/// </summary>
+		/// <returns>Whether the elapsed real time has passed the time limit.</returns>
+		bool IsPastRealTimeLimit() const { return m_RealTimeLimitMS < 0 || GetElapsedRealTimeMS() > m_RealTimeLimitMS; }
+
+		/// <summary>
+		/// Gets how far the elapsed real time is towards the time limit.
+		/// </summary>
+		/// <returns>A value from 0 to 1, where 1 means the limit has been reached. Always 1 if there is no limit.</returns>
+		double RealTimeLimitProgress() const { return m_RealTimeLimitMS <= 0 ? 1.0 : std::min(1.0, GetElapsedRealTimeMS() / m_RealTimeLimitMS); }
+
+		/// <summary>
+		/// Gets how much real time is left until the time limit is reached.
+		/// </summary>
+		/// <returns>The real time left in milliseconds. Negative if the limit has been passed. Zero if there is no limit.</returns>
+		double LeftTillRealTimeLimitMS() const { return m_RealTimeLimitMS < 0 ? 0 : m_RealTimeLimitMS - GetElapsedRealTimeMS(); }
+
+		/// <summary>
+		/// Gets whether a periodic interval of real time is in its first or second half, e.g. for blinking.
+		/// </summary>
+		/// <param name="periodMS">The length of the whole interval in milliseconds.</param>
+		/// <returns>Whether the elapsed real time is in the second half of the current interval.</returns>
+		bool AlternateReal(double periodMS) const { return periodMS > 0 && std::fmod(GetElapsedRealTimeMS(), periodMS) >= periodMS / 2.0; }
+#pragma endregion
+
+	private:
+
+		std::chrono::steady_clock::time_point m_StartRealTime; //!< When the timer was last reset.
+		double m_RealTimeLimitMS = -1; //!< The real time limit in milliseconds, counted from m_StartRealTime. Negative if there is no limit.
 	};
 }
-#endif
\ No newline at end of file
+#endif
@@ -59,5 +59,11 @@
 #include <limits>
 #include <array>
 #include <filesystem>
+#include <future>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 #endif
\ No newline at end of file